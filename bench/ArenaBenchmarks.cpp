@@ -0,0 +1,58 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/FrameArena.h"
+
+#include <string>
+#include <vector>
+
+#include <SDL_render.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static const int QUADS_PER_LABEL = 12;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/// A frame's worth of transient UI work on the heap: a formatted label and a vertex list per widget.
+static void frame_scratch_heap(Bench::State& state) {
+    while (state.keep_running()) {
+        for (int widget = 0; widget < state.argument(); widget++) {
+            std::string             label = "Score: " + std::to_string(widget * 10);
+            std::vector<SDL_Vertex> vertices;
+            for (int i = 0; i < QUADS_PER_LABEL * 4; i++) { vertices.push_back({}); }
+            Bench::do_not_optimize(label.data());
+            Bench::do_not_optimize(vertices.data());
+        }
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(frame_scratch_heap, 64, 1024);
+
+/// The same work from a frame arena, reset once per frame as Window does.
+static void frame_scratch_arena(Bench::State& state) {
+    Core::FrameArena arena;
+
+    while (state.keep_running()) {
+        arena.reset();
+        for (int widget = 0; widget < state.argument(); widget++) {
+            const char*                   label = arena.format("Score: %d", widget * 10);
+            Core::ArenaVector<SDL_Vertex> vertices{Core::ArenaAllocator<SDL_Vertex>(arena)};
+            for (int i = 0; i < QUADS_PER_LABEL * 4; i++) { vertices.push_back({}); }
+            Bench::do_not_optimize(label);
+            Bench::do_not_optimize(vertices.data());
+        }
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(frame_scratch_arena, 64, 1024);
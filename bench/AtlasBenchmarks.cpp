@@ -0,0 +1,103 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/SkylinePacker.h"
+#include "../core/SpriteAtlas.h"
+#include "../rendering/BatchRenderer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL_render.h>
+#include <SDL_surface.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static const int SPRITE_SIZE   = 16;
+static const int SPRITE_IMAGES = 64;   ///< Distinct images, like the frames and props of a small game.
+static const int SPRITE_DRAWS  = 2000; ///< Sprites drawn per frame, cycling through the images.
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+/// Makes a solid square image with a color unique to its index.
+static SDL_Surface* MAKE_SPRITE_IMAGE(int index) {
+    SDL_Surface* image = SDL_CreateRGBSurfaceWithFormat(0, SPRITE_SIZE, SPRITE_SIZE, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_FillRect(image, nullptr, 0xFF000000u | static_cast<Uint32>(index * 0x030507));
+    return image;
+}
+
+static SDL_Rect SPRITE_DEST(int draw) {
+    return {(draw * 7) % (1024 - SPRITE_SIZE), (draw * 13) % (768 - SPRITE_SIZE), SPRITE_SIZE, SPRITE_SIZE};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/// One texture per image: every change of image in the draw order is another draw call.
+static void sprites_separate_textures(Bench::State& state) {
+    std::vector<Rendering::BatchRenderer::TexturePtr> textures;
+    for (int i = 0; i < SPRITE_IMAGES; i++) {
+        SDL_Surface* image = MAKE_SPRITE_IMAGE(i);
+        textures.emplace_back(SDL_CreateTextureFromSurface(Bench::renderer(), image), SDL_DestroyTexture);
+        SDL_FreeSurface(image);
+    }
+    Rendering::BatchRenderer batch(Bench::renderer());
+    const SDL_Rect           source{0, 0, SPRITE_SIZE, SPRITE_SIZE};
+
+    while (state.keep_running()) {
+        for (int i = 0; i < SPRITE_DRAWS; i++) { batch.copy(textures[i % SPRITE_IMAGES], source, SPRITE_DEST(i)); }
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+    }
+    state.set_items_processed(state.iterations() * SPRITE_DRAWS);
+}
+BENCHMARK_FUNCTION(sprites_separate_textures);
+
+/// The same images packed into one atlas page, so the whole frame is a single draw call.
+static void sprites_atlas(Bench::State& state) {
+    Core::SpriteAtlas                      atlas(Bench::renderer(), 256);
+    std::vector<Core::SpriteAtlas::Sprite> sprites;
+    for (int i = 0; i < SPRITE_IMAGES; i++) {
+        SDL_Surface* image = MAKE_SPRITE_IMAGE(i);
+        sprites.push_back(atlas.add("sprite" + std::to_string(i), image));
+        SDL_FreeSurface(image);
+    }
+    Rendering::BatchRenderer batch(Bench::renderer());
+
+    while (state.keep_running()) {
+        for (int i = 0; i < SPRITE_DRAWS; i++) {
+            const Core::SpriteAtlas::Sprite& sprite = sprites[i % SPRITE_IMAGES];
+            batch.copy(sprite.texture, sprite.source, SPRITE_DEST(i));
+        }
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+    }
+    state.set_items_processed(state.iterations() * SPRITE_DRAWS);
+}
+BENCHMARK_FUNCTION(sprites_atlas);
+
+/// Packing cost for rectangles of mixed sizes, as a runtime atlas would see them.
+static void skyline_pack(Bench::State& state) {
+    while (state.keep_running()) {
+        Core::SkylinePacker packer(2048, 2048);
+        SDL_Point           position;
+        for (int i = 0; i < state.argument(); i++) {
+            packer.insert(8 + (i * 37) % 56, 8 + (i * 53) % 56, position);
+        }
+        Bench::do_not_optimize(position);
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(skyline_pack, 256, 1024);
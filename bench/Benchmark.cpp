@@ -0,0 +1,233 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/System.h"
+#include "../rendering/Windowing.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace Bench {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        const int          BENCH_WINDOW_WIDTH   = 1024;
+        const int          BENCH_WINDOW_HEIGHT  = 768;
+        const double       DEFAULT_MIN_TIME_S   = 0.5;
+        const int          MAX_ITERATION_GROWTH = 10;
+        const std::int64_t MAX_ITERATIONS       = 1'000'000'000;
+
+        struct RegisteredBenchmark {
+            std::string               name;
+            BenchmarkFunction         function;
+            std::vector<std::int64_t> arguments;
+        };
+
+        struct Result {
+            std::string  name;
+            std::int64_t iterations;
+            double       ns_per_iteration;
+            double       items_per_second;
+        };
+
+        std::unique_ptr<Rendering::Window> BENCH_WINDOW;
+
+        std::vector<RegisteredBenchmark>& REGISTERED_BENCHMARKS() {
+            // Function-local so registration from other translation units can't run before it exists.
+            static std::vector<RegisteredBenchmark> benchmarks;
+            return benchmarks;
+        }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    static Result RUN_ONE(const std::string& name, BenchmarkFunction function, std::int64_t argument,
+                          double min_time_s) {
+        std::int64_t iterations = 1;
+        while (true) {
+            State state(iterations, argument);
+            function(state);
+
+            const double elapsed_s = state.elapsed_ns() / 1.0e9;
+            if (elapsed_s >= min_time_s || iterations >= MAX_ITERATIONS) {
+                return {name, iterations, state.elapsed_ns() / static_cast<double>(iterations),
+                        elapsed_s > 0.0 ? static_cast<double>(state.items_processed()) / elapsed_s : 0.0};
+            }
+
+            // Aim a little past the minimum time, without trusting tiny samples too much.
+            double scale = elapsed_s > 0.0 ? (min_time_s * 1.4) / elapsed_s : MAX_ITERATION_GROWTH;
+            scale      = std::clamp(scale, 2.0, static_cast<double>(MAX_ITERATION_GROWTH));
+            iterations = std::min(MAX_ITERATIONS, static_cast<std::int64_t>(static_cast<double>(iterations) * scale));
+        }
+    }
+
+    static std::string JSON_ESCAPED(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') { escaped += '\\'; }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    static void WRITE_JSON(std::ostream& out, const std::vector<Result>& results, const char* executable) {
+        char        date[64];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        out << "{\n  \"context\": {\n"
+            << "    \"date\": \"" << date << "\",\n"
+            << "    \"executable\": \"" << JSON_ESCAPED(executable) << "\",\n"
+            << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+            << "    \"library_build_type\": \"release\"\n"
+#else
+            << "    \"library_build_type\": \"debug\"\n"
+#endif
+            << "  },\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const Result& result = results[i];
+            out << (i ? ",\n" : "\n")
+                << "    {\"name\": \"" << JSON_ESCAPED(result.name) << "\", \"run_name\": \""
+                << JSON_ESCAPED(result.name) << "\", \"run_type\": \"iteration\", \"iterations\": "
+                << result.iterations << ", \"real_time\": " << result.ns_per_iteration
+                << ", \"cpu_time\": " << result.ns_per_iteration << ", \"time_unit\": \"ns\"";
+            if (result.items_per_second > 0.0) { out << ", \"items_per_second\": " << result.items_per_second; }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    static void WRITE_CONSOLE_ROW(const Result& result) {
+        std::printf("%-48s %14.1f ns %12lld", result.name.c_str(), result.ns_per_iteration,
+                    static_cast<long long>(result.iterations));
+        if (result.items_per_second > 0.0) { std::printf("  %12.4g items/s", result.items_per_second); }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// State
+////////////////////////////////////////////////////////////////////////////////
+
+    State::State(std::int64_t iterations, std::int64_t argument)
+            : m_iterations(iterations),
+              m_remaining(iterations),
+              m_argument(argument),
+              m_items_processed(0),
+              m_started(false),
+              m_elapsed(Clock::duration::zero()) {}
+
+    bool State::keep_running() {
+        if (!m_started) {
+            m_started = true;
+            m_start   = Clock::now();
+        }
+        if (m_remaining-- > 0) { return true; }
+
+        m_elapsed += Clock::now() - m_start;
+        return false;
+    }
+
+    void State::pause_timing() { m_elapsed += Clock::now() - m_start; }
+    void State::resume_timing() { m_start = Clock::now(); }
+
+    std::int64_t State::argument() const { return m_argument; }
+    std::int64_t State::iterations() const { return m_iterations; }
+    void State::set_items_processed(std::int64_t items) { m_items_processed = items; }
+    std::int64_t State::items_processed() const { return m_items_processed; }
+
+    double State::elapsed_ns() const {
+        return std::chrono::duration<double, std::nano>(m_elapsed).count();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool register_benchmark(const char* name, BenchmarkFunction function, std::vector<std::int64_t> arguments) {
+        REGISTERED_BENCHMARKS().push_back({name, function, std::move(arguments)});
+        return true;
+    }
+
+    int run_all(int num_args, char** args) {
+        std::string filter;
+        std::string out_path;
+        bool        json_to_console = false;
+        double      min_time_s      = DEFAULT_MIN_TIME_S;
+        for (int i = 1; i < num_args; i++) {
+            std::string option = args[i];
+            auto        value  = [&option]() { return option.substr(option.find('=') + 1); };
+            if (option.rfind("--benchmark_filter=", 0) == 0) { filter = value(); }
+            else if (option.rfind("--benchmark_out=", 0) == 0) { out_path = value(); }
+            else if (option.rfind("--benchmark_min_time=", 0) == 0) { min_time_s = std::stod(value()); }
+            else if (option == "--benchmark_format=json") { json_to_console = true; }
+            else if (option != "--benchmark_format=console") {
+                std::cerr << "Unknown option: " << option << std::endl;
+                return 1;
+            }
+        }
+
+        Core::System::use_headless_drivers();
+        Core::System::start_up();
+        BENCH_WINDOW = std::make_unique<Rendering::Window>(BENCH_WINDOW_WIDTH, BENCH_WINDOW_HEIGHT,
+                                                           "Benchmarks", Rendering::Window::Backend::Headless);
+
+        std::vector<Result> results;
+        for (const RegisteredBenchmark& benchmark : REGISTERED_BENCHMARKS()) {
+            std::vector<std::int64_t> arguments = benchmark.arguments;
+            if (arguments.empty()) { arguments.push_back(0); }
+
+            for (std::int64_t argument : arguments) {
+                std::string name = benchmark.name;
+                if (!benchmark.arguments.empty()) { name += "/" + std::to_string(argument); }
+                if (!filter.empty() && name.find(filter) == std::string::npos) { continue; }
+
+                results.push_back(RUN_ONE(name, benchmark.function, argument, min_time_s));
+                if (!json_to_console) { WRITE_CONSOLE_ROW(results.back()); }
+            }
+        }
+
+        if (json_to_console) { WRITE_JSON(std::cout, results, args[0]); }
+        if (!out_path.empty()) {
+            std::ofstream out(out_path);
+            if (!out) {
+                std::cerr << "Unable to write benchmark results to " << out_path << std::endl;
+                return 1;
+            }
+            WRITE_JSON(out, results, args[0]);
+        }
+
+        BENCH_WINDOW.reset();
+        Core::System::shut_down();
+        return 0;
+    }
+
+    Rendering::Window& window() { return *BENCH_WINDOW; }
+
+    SDL_Renderer* renderer() { return BENCH_WINDOW->renderer(); }
+
+} // Bench
+
+int main(int num_args, char** args) {
+    return Bench::run_all(num_args, args);
+}
@@ -0,0 +1,100 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_BENCHMARK_H
+#define GOLD_CARTRIDGE_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SDL_Renderer;
+
+namespace Rendering { class Window; }
+
+/**
+ * @brief A small benchmark harness, modelled on Google Benchmark's interface and JSON output.
+ *
+ * Benchmarks are plain functions that loop on State::keep_running() and are
+ * registered at static initialization time with BENCHMARK_FUNCTION. Each one
+ * runs with more and more iterations until it has taken at least the minimum
+ * run time, and its time per iteration is reported.
+ */
+namespace Bench {
+
+    class State {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    public:
+        State(std::int64_t iterations, std::int64_t argument);
+
+        /// Returns true until the requested number of iterations has run. Timing starts on the first call.
+        bool keep_running();
+
+        /// Excludes the time until resume_timing() from the measurement.
+        void pause_timing();
+        void resume_timing();
+
+        std::int64_t argument() const;
+        std::int64_t iterations() const;
+        void set_items_processed(std::int64_t items);
+        std::int64_t items_processed() const;
+        double elapsed_ns() const;
+
+    private:
+        std::int64_t      m_iterations;
+        std::int64_t      m_remaining;
+        std::int64_t      m_argument;
+        std::int64_t      m_items_processed;
+        bool              m_started;
+        Clock::time_point m_start;
+        Clock::duration   m_elapsed;
+    };
+
+    using BenchmarkFunction = void (*)(State& state);
+
+    /**
+     * Adds a benchmark to the suite.
+     * @param name The benchmark's name. Arguments are appended as "name/argument".
+     * @param function The benchmark to run.
+     * @param arguments Values to run the benchmark with, one run each. Empty runs it once with zero.
+     * @return Always true, so it can initialize a static variable.
+     */
+    bool register_benchmark(const char* name, BenchmarkFunction function, std::vector<std::int64_t> arguments);
+
+    /**
+     * Runs every registered benchmark that matches the command line filter.
+     * Understands --benchmark_filter=<substring>, --benchmark_min_time=<seconds>,
+     * --benchmark_format=<console|json>, and --benchmark_out=<json file>.
+     * @return The process exit code.
+     */
+    int run_all(int num_args, char** args);
+
+    /// The headless window shared by all benchmarks. Only valid while run_all() is running.
+    Rendering::Window& window();
+    SDL_Renderer* renderer();
+
+    /// Keeps the compiler from optimizing away a value the benchmark computes.
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+} // Bench
+
+#define BENCHMARK_FUNCTION(function, ...) \
+    [[maybe_unused]] static const bool function##_registered = Bench::register_benchmark(#function, function, {__VA_ARGS__})
+
+#endif //GOLD_CARTRIDGE_BENCHMARK_H
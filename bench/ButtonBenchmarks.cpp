@@ -0,0 +1,165 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../rendering/BatchRenderer.h"
+#include "../rendering/SoftwareRasterizer.h"
+#include "../ui/Button.h"
+#include "../ui/Container.h"
+
+#include <SDL_events.h>
+#include <SDL_render.h>
+
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    const int BUTTON_COLUMNS = 32;
+    const int BUTTON_WIDTH   = 32;
+    const int BUTTON_HEIGHT  = 24;
+}
+
+/// Lays out buttons in a 32 column grid that fills a 1024x768 window at 1024 buttons.
+static std::vector<UI::Button> MAKE_BUTTONS(std::int64_t count) {
+    std::vector<UI::Button> buttons;
+    buttons.reserve(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; i++) {
+        buttons.emplace_back((i % BUTTON_COLUMNS) * BUTTON_WIDTH, (i / BUTTON_COLUMNS) * BUTTON_HEIGHT,
+                             BUTTON_WIDTH, BUTTON_HEIGHT, "B" + std::to_string(i), [](UI::Button&) {});
+    }
+    return buttons;
+}
+
+/// The same grid as MAKE_BUTTONS, owned by a container.
+static std::vector<UI::Button*> FILL_CONTAINER(UI::Container& container, std::int64_t count) {
+    std::vector<UI::Button*> buttons;
+    for (int i = 0; i < count; i++) {
+        buttons.push_back(&container.add<UI::Button>((i % BUTTON_COLUMNS) * BUTTON_WIDTH, (i / BUTTON_COLUMNS) * BUTTON_HEIGHT,
+                                  BUTTON_WIDTH, BUTTON_HEIGHT, "B" + std::to_string(i), [](UI::Button&) {}));
+    }
+    return buttons;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+static void button_render(Bench::State& state) {
+    std::vector<UI::Button>  buttons = MAKE_BUTTONS(state.argument());
+    Rendering::BatchRenderer batch(Bench::renderer());
+
+    while (state.keep_running()) {
+        for (UI::Button& button : buttons) { button.render(batch); }
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(button_render, 16, 256, 1024);
+
+/// The same buttons drawn as Window::Backend::Software draws them: the batch is flushed into the tiled rasterizer.
+static void button_render_rasterizer(Bench::State& state) {
+    std::vector<UI::Button>       buttons = MAKE_BUTTONS(state.argument());
+    Rendering::BatchRenderer      batch(Bench::renderer());
+    Rendering::SoftwareRasterizer raster(Bench::renderer(), BUTTON_COLUMNS * BUTTON_WIDTH, 768);
+    raster.overlay(true);
+
+    while (state.keep_running()) {
+        raster.clear({0, 0, 0, 0});
+        for (UI::Button& button : buttons) { button.render(batch); }
+        batch.flush(raster);
+        raster.present();
+        SDL_RenderFlush(Bench::renderer());
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(button_render_rasterizer, 16, 256, 1024);
+
+/// Sweeps the mouse across the window, handing every motion event to every button.
+static void button_handle_event(Bench::State& state) {
+    std::vector<UI::Button> buttons = MAKE_BUTTONS(state.argument());
+
+    SDL_Event motion{};
+    motion.type = SDL_MOUSEMOTION;
+    while (state.keep_running()) {
+        motion.motion.x = (motion.motion.x + 7) % 1024;
+        motion.motion.y = (motion.motion.y + 5) % 768;
+        for (UI::Button& button : buttons) { button.handle_event(motion); }
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(button_handle_event, 16, 256, 1024);
+
+/// The same sweep as button_handle_event, with the container picking out the buttons under the cursor.
+static void container_handle_event(Bench::State& state) {
+    UI::Container container;
+    FILL_CONTAINER(container, state.argument());
+
+    SDL_Event motion{};
+    motion.type = SDL_MOUSEMOTION;
+    while (state.keep_running()) {
+        motion.motion.x = (motion.motion.x + 7) % 1024;
+        motion.motion.y = (motion.motion.y + 5) % 768;
+        container.handle_event(motion);
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(container_handle_event, 16, 256, 1024);
+
+/// Slides every button back and forth by up to a cell, keeping the container's grid up to date.
+static void container_move_widgets(Bench::State& state) {
+    UI::Container            container;
+    std::vector<UI::Button*> buttons = FILL_CONTAINER(container, state.argument());
+
+    int step = 0;
+    while (state.keep_running()) {
+        int shift = (step++ % 2 == 0) ? container.cell_size() / 2 : -container.cell_size() / 2;
+        for (UI::Button* button : buttons) {
+            SDL_Rect moved = button->area();
+            moved.x += shift;
+            button->set_area(moved);
+        }
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(container_move_widgets, 16, 256, 1024);
+
+/// Moves the cursor across a grid of buttons and draws a frame after each move.
+static void RENDER_HOVERED_FRAMES(Bench::State& state, bool is_retained) {
+    UI::Container container;
+    container.retained_mode(is_retained);
+    FILL_CONTAINER(container, state.argument());
+    Rendering::BatchRenderer batch(Bench::renderer());
+
+    SDL_Event     motion{};
+    std::uint64_t pixels_redrawn = 0;
+    motion.type = SDL_MOUSEMOTION;
+    while (state.keep_running()) {
+        motion.motion.x = (motion.motion.x + 7) % 1024;
+        motion.motion.y = (motion.motion.y + 5) % 768;
+        container.handle_event(motion);
+        container.render(batch);
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+        pixels_redrawn += container.pixels_redrawn();
+    }
+    Bench::do_not_optimize(pixels_redrawn);
+    state.set_items_processed(state.iterations() * state.argument());
+}
+
+/// Every button is redrawn every frame.
+static void container_render_hover(Bench::State& state) { RENDER_HOVERED_FRAMES(state, false); }
+BENCHMARK_FUNCTION(container_render_hover, 256, 1024);
+
+/// The same frames in retained mode, where only the buttons whose highlight changed are redrawn.
+static void container_render_hover_retained(Bench::State& state) { RENDER_HOVERED_FRAMES(state, true); }
+BENCHMARK_FUNCTION(container_render_hover_retained, 256, 1024);
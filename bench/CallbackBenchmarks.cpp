@@ -0,0 +1,87 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/InplaceFunction.h"
+
+#include <array>
+#include <functional>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+/// Big enough that std::function has to put it on the heap, like a lambda capturing a few values by copy.
+struct LargeCapture {
+    std::array<double, 6> values;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+/// Calls a callback the way Window calls its update callback: many times, through whatever wrapper holds it.
+template <typename Callback>
+static void CALL_REPEATEDLY(Bench::State& state, const Callback& callback) {
+    while (state.keep_running()) {
+        for (int i = 0; i < state.argument(); i++) { callback(i); }
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+static void callback_call_std_function(Bench::State& state) {
+    long long                total    = 0;
+    std::function<void(int)> callback = [&total](int i) { total += i; };
+    Bench::do_not_optimize(callback);
+    CALL_REPEATEDLY(state, callback);
+    Bench::do_not_optimize(total);
+}
+BENCHMARK_FUNCTION(callback_call_std_function, 1000);
+
+static void callback_call_inplace_function(Bench::State& state) {
+    long long                        total    = 0;
+    Core::InplaceFunction<void(int)> callback = [&total](int i) { total += i; };
+    Bench::do_not_optimize(callback);
+    CALL_REPEATEDLY(state, callback);
+    Bench::do_not_optimize(total);
+}
+BENCHMARK_FUNCTION(callback_call_inplace_function, 1000);
+
+/// The lower bound: the lambda's type is known, so the call can be inlined.
+static void callback_call_direct(Bench::State& state) {
+    long long total    = 0;
+    auto      callback = [&total](int i) { total += i; };
+    CALL_REPEATEDLY(state, callback);
+    Bench::do_not_optimize(total);
+}
+BENCHMARK_FUNCTION(callback_call_direct, 1000);
+
+/// Setting a callback with a large capture, as a Button or event handler is created.
+static void callback_create_std_function(Bench::State& state) {
+    LargeCapture capture{};
+    while (state.keep_running()) {
+        std::function<double()> callback = [capture]() { return capture.values[0]; };
+        Bench::do_not_optimize(callback);
+    }
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(callback_create_std_function);
+
+static void callback_create_inplace_function(Bench::State& state) {
+    LargeCapture capture{};
+    while (state.keep_running()) {
+        Core::InplaceFunction<double()> callback = [capture]() { return capture.values[0]; };
+        Bench::do_not_optimize(callback);
+    }
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(callback_create_inplace_function);
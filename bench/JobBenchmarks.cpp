@@ -0,0 +1,79 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/JobSystem.h"
+
+#include <cmath>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    struct Particle {
+        float x, y, velocity_x, velocity_y;
+    };
+}
+
+/// A stand-in for per-entity simulation work: a little arithmetic on each particle.
+static void STEP_PARTICLES(std::vector<Particle>& particles, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++) {
+        Particle& particle = particles[i];
+        particle.velocity_y += 0.1f;
+        particle.velocity_x *= 0.99f;
+        particle.x += particle.velocity_x;
+        particle.y += particle.velocity_y;
+        if (particle.y > 768.0f) {
+            particle.y          = 768.0f;
+            particle.velocity_y = -std::abs(particle.velocity_y) * 0.8f;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+static void particles_serial(Bench::State& state) {
+    std::vector<Particle> particles(static_cast<std::size_t>(state.argument()), Particle{0.0f, 0.0f, 1.0f, 0.0f});
+
+    while (state.keep_running()) {
+        STEP_PARTICLES(particles, 0, particles.size());
+        Bench::do_not_optimize(particles.data());
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(particles_serial, 1024, 65536, 1048576);
+
+static void particles_parallel_for(Bench::State& state) {
+    std::vector<Particle> particles(static_cast<std::size_t>(state.argument()), Particle{0.0f, 0.0f, 1.0f, 0.0f});
+
+    while (state.keep_running()) {
+        Core::JobSystem::access().parallel_for(particles.size(), 4096, [&](std::size_t begin, std::size_t end) {
+            STEP_PARTICLES(particles, begin, end);
+        });
+        Bench::do_not_optimize(particles.data());
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(particles_parallel_for, 1024, 65536, 1048576);
+
+/// The overhead of queuing and waiting on tiny jobs.
+static void job_run_and_wait(Bench::State& state) {
+    Core::JobSystem& jobs = Core::JobSystem::access();
+
+    while (state.keep_running()) {
+        Core::JobSystem::Counter counter;
+        for (int i = 0; i < state.argument(); i++) { jobs.run([]() {}, &counter); }
+        jobs.wait(counter);
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(job_run_and_wait, 16, 256, 4096);
@@ -0,0 +1,212 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/SimdLanes.h"
+#include "../core/PixelOps.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <SDL_surface.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    using Scalar = Core::ScalarPixels;
+
+    /// One 1024x768 frame's worth of pixels per iteration.
+    const std::size_t PIXEL_COUNT = 1024 * 768;
+
+    const std::uint32_t TINT = 0xC0FFA080;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+/// A mix of opaque, transparent and partly transparent runs, as sprites and glyphs have.
+static std::vector<std::uint32_t> MAKE_PIXELS() {
+    std::vector<std::uint32_t> pixels(PIXEL_COUNT);
+    std::uint32_t              state = 12345;
+    for (std::size_t i = 0; i < PIXEL_COUNT; i++) {
+        state = state * 1664525 + 1013904223;
+        std::uint32_t alpha = (i / 16) % 3 == 0 ? 255 : (i / 16) % 3 == 1 ? 0 : state >> 24;
+        pixels[i] = alpha << 24 | (state & 0x00FFFFFF);
+    }
+    return pixels;
+}
+
+static double POW_SRGB_TO_LINEAR(std::uint32_t byte) {
+    double value = byte / 255.0;
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+static std::uint32_t POW_LINEAR_TO_SRGB(float linear) {
+    double value = std::fmin(std::fmax(linear, 0.0f), 1.0f);
+    value = value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+    return static_cast<std::uint32_t>(value * 255.0 + 0.5);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Each kernel is timed twice: one pixel at a time with Core::ScalarPixels,
+ * which computes exactly the same results, and through PixelOps.
+ */
+
+static void pixels_premultiply_scalar(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    while (state.keep_running()) {
+        for (std::uint32_t& pixel : pixels) { pixel = Scalar::premultiply({pixel}).value; }
+        Bench::do_not_optimize(pixels.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_premultiply_scalar);
+
+static void pixels_premultiply(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    while (state.keep_running()) {
+        Core::PixelOps::premultiply(pixels.data(), pixels.size());
+        Bench::do_not_optimize(pixels.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_premultiply);
+
+static void pixels_unpremultiply_scalar(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    while (state.keep_running()) {
+        for (std::uint32_t& pixel : pixels) { pixel = Scalar::unpremultiply({pixel}).value; }
+        Bench::do_not_optimize(pixels.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_unpremultiply_scalar);
+
+static void pixels_unpremultiply(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    while (state.keep_running()) {
+        Core::PixelOps::unpremultiply(pixels.data(), pixels.size());
+        Bench::do_not_optimize(pixels.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_unpremultiply);
+
+static void pixels_modulate_scalar(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    while (state.keep_running()) {
+        for (std::uint32_t& pixel : pixels) { pixel = Scalar::multiply({pixel}, {TINT}).value; }
+        Bench::do_not_optimize(pixels.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_modulate_scalar);
+
+static void pixels_modulate(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    while (state.keep_running()) {
+        Core::PixelOps::modulate(pixels.data(), pixels.size(), TINT);
+        Bench::do_not_optimize(pixels.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_modulate);
+
+static void pixels_alpha_over_scalar(Bench::State& state) {
+    std::vector<std::uint32_t> src = MAKE_PIXELS();
+    std::vector<std::uint32_t> dst(PIXEL_COUNT, 0xFF203040);
+    while (state.keep_running()) {
+        for (std::size_t i = 0; i < PIXEL_COUNT; i++) { dst[i] = Scalar::blend({dst[i]}, {src[i]}).value; }
+        Bench::do_not_optimize(dst.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_alpha_over_scalar);
+
+static void pixels_alpha_over(Bench::State& state) {
+    std::vector<std::uint32_t> src = MAKE_PIXELS();
+    std::vector<std::uint32_t> dst(PIXEL_COUNT, 0xFF203040);
+    while (state.keep_running()) {
+        Core::PixelOps::alpha_over(dst.data(), src.data(), PIXEL_COUNT);
+        Bench::do_not_optimize(dst.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_alpha_over);
+
+/// Loading a PNG gives ABGR8888 pixels, which texture uploads used to hand to SDL_ConvertSurfaceFormat.
+static void pixels_swizzle_sdl(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    SDL_Surface* image = SDL_CreateRGBSurfaceWithFormatFrom(pixels.data(), 1024, 768, 32, 1024 * 4,
+                                                            SDL_PIXELFORMAT_ABGR8888);
+    while (state.keep_running()) {
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_ARGB8888, 0);
+        Bench::do_not_optimize(converted);
+        SDL_FreeSurface(converted);
+    }
+    SDL_FreeSurface(image);
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_swizzle_sdl);
+
+static void pixels_swizzle(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    SDL_Surface* image = SDL_CreateRGBSurfaceWithFormatFrom(pixels.data(), 1024, 768, 32, 1024 * 4,
+                                                            SDL_PIXELFORMAT_ABGR8888);
+    while (state.keep_running()) {
+        SDL_Surface* converted = Core::PixelOps::to_argb8888(image);
+        Bench::do_not_optimize(converted);
+        SDL_FreeSurface(converted);
+    }
+    SDL_FreeSurface(image);
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_swizzle);
+
+/// sRGB to linear light and back, with the curve worked out for every channel.
+static void pixels_srgb_round_trip_pow(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    std::vector<float>         linear(PIXEL_COUNT * 4);
+    while (state.keep_running()) {
+        for (std::size_t i = 0; i < PIXEL_COUNT; i++) {
+            std::uint32_t pixel = pixels[i];
+            linear[i * 4 + 0]   = static_cast<float>(POW_SRGB_TO_LINEAR((pixel >> 16) & 0xFF));
+            linear[i * 4 + 1]   = static_cast<float>(POW_SRGB_TO_LINEAR((pixel >> 8) & 0xFF));
+            linear[i * 4 + 2]   = static_cast<float>(POW_SRGB_TO_LINEAR(pixel & 0xFF));
+            linear[i * 4 + 3]   = static_cast<float>(pixel >> 24) / 255.0f;
+        }
+        for (std::size_t i = 0; i < PIXEL_COUNT; i++) {
+            pixels[i] = static_cast<std::uint32_t>(linear[i * 4 + 3] * 255.0f + 0.5f) << 24 |
+                        POW_LINEAR_TO_SRGB(linear[i * 4 + 0]) << 16 | POW_LINEAR_TO_SRGB(linear[i * 4 + 1]) << 8 |
+                        POW_LINEAR_TO_SRGB(linear[i * 4 + 2]);
+        }
+        Bench::do_not_optimize(pixels.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_srgb_round_trip_pow);
+
+static void pixels_srgb_round_trip(Bench::State& state) {
+    std::vector<std::uint32_t> pixels = MAKE_PIXELS();
+    std::vector<float>         linear(PIXEL_COUNT * 4);
+    while (state.keep_running()) {
+        Core::PixelOps::srgb_to_linear(pixels.data(), linear.data(), PIXEL_COUNT);
+        Core::PixelOps::linear_to_srgb(linear.data(), pixels.data(), PIXEL_COUNT);
+        Bench::do_not_optimize(pixels.data());
+    }
+    state.set_items_processed(state.iterations() * PIXEL_COUNT);
+}
+BENCHMARK_FUNCTION(pixels_srgb_round_trip);
@@ -0,0 +1,152 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../rendering/BatchRenderer.h"
+#include "../rendering/SoftwareRasterizer.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <SDL_render.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    const int FRAME_WIDTH  = 1024;
+    const int FRAME_HEIGHT = 768;
+    const int PANEL_COUNT  = 48;   ///< Translucent rectangles, as a UI's panels.
+    const int SPRITE_COUNT = 2000;
+    const int SPRITE_SIZE  = 32;
+    const int GLYPH_COUNT  = 4000; ///< About two screens of small text.
+    const int GLYPH_WIDTH  = 8;
+    const int GLYPH_HEIGHT = 14;
+
+    /// Pixels and coverage shared by both renderers, so they draw the same frame.
+    struct Scene {
+        std::vector<std::uint32_t> sprite_pixels; ///< A soft-edged disc, opaque in the middle.
+        std::vector<std::uint8_t>  glyph_coverage;
+        std::vector<std::uint32_t> glyph_pixels;  ///< The coverage as white ARGB8888, for SDL.
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static Scene MAKE_SCENE() {
+    Scene scene;
+    const float radius = SPRITE_SIZE / 2.0f;
+    for (int y = 0; y < SPRITE_SIZE; y++) {
+        for (int x = 0; x < SPRITE_SIZE; x++) {
+            float dx = x + 0.5f - radius, dy = y + 0.5f - radius;
+            float edge  = radius - (dx * dx + dy * dy) / radius; // Roughly the distance inside the rim, in pixels.
+            auto  alpha = static_cast<std::uint32_t>(edge <= 0.0f ? 0.0f : edge >= 4.0f ? 255.0f : edge * 63.75f);
+            scene.sprite_pixels.push_back(alpha << 24 | 0x00C08040);
+        }
+    }
+    for (int y = 0; y < GLYPH_HEIGHT; y++) {
+        for (int x = 0; x < GLYPH_WIDTH; x++) {
+            // A letter-like blob of strokes with antialiased edges.
+            std::uint8_t coverage = (x == 1 || x == 6 || y == 2 || y == 11) ? 255 : (x == 2 || y == 3) ? 96 : 0;
+            scene.glyph_coverage.push_back(coverage);
+            scene.glyph_pixels.push_back(static_cast<std::uint32_t>(coverage) << 24 | 0x00FFFFFF);
+        }
+    }
+    return scene;
+}
+
+static Rendering::BatchRenderer::TexturePtr MAKE_TEXTURE(const std::vector<std::uint32_t>& pixels, int width,
+                                                         int height) {
+    Rendering::BatchRenderer::TexturePtr texture(
+            SDL_CreateTexture(Bench::renderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, width, height),
+            SDL_DestroyTexture);
+    SDL_UpdateTexture(texture.get(), nullptr, pixels.data(), width * static_cast<int>(sizeof(std::uint32_t)));
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+static SDL_Rect PANEL_AREA(int index) {
+    return {(index * 211) % (FRAME_WIDTH - 200), (index * 97) % (FRAME_HEIGHT - 120), 200, 120};
+}
+
+static SDL_Point SPRITE_POSITION(int index, std::int64_t frame) {
+    return {static_cast<int>((index * 7919 + frame * 3) % (FRAME_WIDTH + SPRITE_SIZE)) - SPRITE_SIZE,
+            static_cast<int>((index * 104729 + frame) % (FRAME_HEIGHT + SPRITE_SIZE)) - SPRITE_SIZE};
+}
+
+static SDL_Point GLYPH_POSITION(int index) {
+    const int columns = FRAME_WIDTH / GLYPH_WIDTH;
+    return {(index % columns) * GLYPH_WIDTH, ((index / columns) * GLYPH_HEIGHT * 2) % FRAME_HEIGHT};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/// The frame as the framework draws it today, batched through SDL's single threaded software renderer.
+static void raster_sdl_software(Bench::State& state) {
+    Scene                    scene  = MAKE_SCENE();
+    auto                     sprite = MAKE_TEXTURE(scene.sprite_pixels, SPRITE_SIZE, SPRITE_SIZE);
+    auto                     glyph  = MAKE_TEXTURE(scene.glyph_pixels, GLYPH_WIDTH, GLYPH_HEIGHT);
+    Rendering::BatchRenderer batch(Bench::renderer());
+
+    std::int64_t frame = 0;
+    while (state.keep_running()) {
+        SDL_SetRenderDrawColor(Bench::renderer(), 24, 24, 32, 255);
+        SDL_RenderClear(Bench::renderer());
+        for (int i = 0; i < PANEL_COUNT; i++) { batch.fill_rect(PANEL_AREA(i), {40, 60, 90, 160}, 0); }
+        for (int i = 0; i < SPRITE_COUNT; i++) {
+            SDL_Point at = SPRITE_POSITION(i, frame);
+            batch.copy(sprite, {0, 0, SPRITE_SIZE, SPRITE_SIZE}, {at.x, at.y, SPRITE_SIZE, SPRITE_SIZE}, 1);
+        }
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            SDL_Point at = GLYPH_POSITION(i);
+            batch.copy(glyph, {0, 0, GLYPH_WIDTH, GLYPH_HEIGHT}, {at.x, at.y, GLYPH_WIDTH, GLYPH_HEIGHT}, 2,
+                       {230, 230, 210, 255});
+        }
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+        frame++;
+    }
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(raster_sdl_software);
+
+/// The same frame from the tiled rasterizer, uploaded with one SDL_UpdateTexture. The argument is the tile size.
+static void raster_tiled(Bench::State& state) {
+    Scene                         scene = MAKE_SCENE();
+    Rendering::SoftwareRasterizer raster(Bench::renderer(), FRAME_WIDTH, FRAME_HEIGHT,
+                                         static_cast<int>(state.argument()));
+    const Rendering::SoftwareRasterizer::Image sprite{scene.sprite_pixels.data(), SPRITE_SIZE, SPRITE_SIZE,
+                                                      SPRITE_SIZE * static_cast<int>(sizeof(std::uint32_t))};
+    const Rendering::SoftwareRasterizer::Mask  glyph{scene.glyph_coverage.data(), GLYPH_WIDTH, GLYPH_HEIGHT,
+                                                     GLYPH_WIDTH};
+
+    std::int64_t frame = 0;
+    while (state.keep_running()) {
+        raster.clear({24, 24, 32, 255});
+        for (int i = 0; i < PANEL_COUNT; i++) { raster.fill_rect(PANEL_AREA(i), {40, 60, 90, 160}); }
+        for (int i = 0; i < SPRITE_COUNT; i++) {
+            SDL_Point at = SPRITE_POSITION(i, frame);
+            raster.blit(sprite, {0, 0, SPRITE_SIZE, SPRITE_SIZE}, at.x, at.y);
+        }
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            SDL_Point at = GLYPH_POSITION(i);
+            raster.glyph(glyph, {0, 0, GLYPH_WIDTH, GLYPH_HEIGHT}, at.x, at.y, {230, 230, 210, 255});
+        }
+        raster.finish();
+        raster.present();
+        SDL_RenderFlush(Bench::renderer());
+        frame++;
+    }
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(raster_tiled, 32, 64, 128);
@@ -0,0 +1,122 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../rendering/BatchRenderer.h"
+#include "../rendering/SpriteSystem.h"
+
+#include <vector>
+
+#include <SDL_render.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    const int       SPRITE_SIZE    = 4;
+    const float     WORLD_WIDTH    = 2048.0f; ///< Twice the view in each direction, so about a quarter is drawn.
+    const float     WORLD_HEIGHT   = 1536.0f;
+    const float     UPDATE_SECONDS = 1.0f / 60.0f;
+    const SDL_FRect VIEW           = {512.0f, 384.0f, 1024.0f, 768.0f};
+
+    /// A sprite as a hand-written per-object loop would keep it.
+    struct Mover {
+        float     x, y, x_speed, y_speed;
+        SDL_Color tint;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static Rendering::BatchRenderer::TexturePtr MAKE_TEXTURE() {
+    return {SDL_CreateTexture(Bench::renderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 64, 64),
+            SDL_DestroyTexture};
+}
+
+/// Spreads sprites over the world on a fixed pattern, each drifting in its own direction.
+static Mover MAKE_MOVER(int index) {
+    return {static_cast<float>((index * 7919) % static_cast<int>(WORLD_WIDTH)),
+            static_cast<float>((index * 104729) % static_cast<int>(WORLD_HEIGHT)),
+            static_cast<float>(index % 61 - 30), static_cast<float>(index % 37 - 18),
+            {255, static_cast<Uint8>(index), 255, 255}};
+}
+
+static void FILL_SPRITES(Rendering::SpriteSystem& sprites, const Rendering::BatchRenderer::TexturePtr& texture,
+                         std::int64_t count) {
+    for (int i = 0; i < count; i++) {
+        Mover mover = MAKE_MOVER(i);
+        auto  id    = sprites.add(texture, {(i % 16) * SPRITE_SIZE, 0, SPRITE_SIZE, SPRITE_SIZE}, mover.x, mover.y,
+                                  mover.tint);
+        sprites.velocity(id, mover.x_speed, mover.y_speed);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/// The per-object loop the sprite system replaces: move, cull and queue one sprite at a time.
+static void sprites_per_object(Bench::State& state) {
+    auto                     texture = MAKE_TEXTURE();
+    std::vector<Mover>       movers;
+    Rendering::BatchRenderer batch(Bench::renderer());
+    for (int i = 0; i < state.argument(); i++) { movers.push_back(MAKE_MOVER(i)); }
+
+    while (state.keep_running()) {
+        for (int i = 0; i < static_cast<int>(movers.size()); i++) {
+            Mover& mover = movers[i];
+            mover.x += mover.x_speed * UPDATE_SECONDS;
+            mover.y += mover.y_speed * UPDATE_SECONDS;
+            SDL_Rect dest{static_cast<int>(mover.x - VIEW.x), static_cast<int>(mover.y - VIEW.y), SPRITE_SIZE, SPRITE_SIZE};
+            if (dest.x + dest.w < 0 || dest.x > VIEW.w || dest.y + dest.h < 0 || dest.y > VIEW.h) { continue; }
+            batch.copy(texture, {(i % 16) * SPRITE_SIZE, 0, SPRITE_SIZE, SPRITE_SIZE}, dest, 0, mover.tint);
+        }
+
+        // Only building the frame is measured. Rasterizing it costs the same either way.
+        state.pause_timing();
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+        state.resume_timing();
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(sprites_per_object, 10000, 100000);
+
+/// The same frame from the sprite system: SIMD integration, culling and quad generation.
+static void sprites_system(Bench::State& state) {
+    auto                     texture = MAKE_TEXTURE();
+    Rendering::SpriteSystem  sprites;
+    Rendering::BatchRenderer batch(Bench::renderer());
+    FILL_SPRITES(sprites, texture, state.argument());
+
+    while (state.keep_running()) {
+        sprites.integrate(UPDATE_SECONDS);
+        sprites.render(batch, VIEW);
+
+        state.pause_timing();
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+        state.resume_timing();
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(sprites_system, 10000, 100000);
+
+/// Only the movement, which the job system spreads across its workers.
+static void sprites_system_integrate(Bench::State& state) {
+    auto                    texture = MAKE_TEXTURE();
+    Rendering::SpriteSystem sprites;
+    FILL_SPRITES(sprites, texture, state.argument());
+
+    while (state.keep_running()) { sprites.integrate(UPDATE_SECONDS); }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(sprites_system_integrate, 10000, 100000);
@@ -0,0 +1,72 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/FontManager.h"
+
+#include <SDL_render.h>
+
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static std::string TEXT_OF_LENGTH(std::int64_t length) {
+    const std::string pangram = "The quick brown fox jumps over the lazy dog. ";
+    std::string       text;
+    while (static_cast<std::int64_t>(text.size()) < length) { text += pangram; }
+    return text.substr(0, static_cast<std::size_t>(length));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/// Rasterizes and uploads the text every time, as every frame used to.
+static void render_text_uncached(Bench::State& state) {
+    using Fonts = Core::FontManager;
+    Fonts::FontPtr    font  = Fonts::access().default_font();
+    const SDL_Color   color = Fonts::access().default_font_color();
+    const std::string text  = TEXT_OF_LENGTH(state.argument());
+
+    while (state.keep_running()) {
+        Fonts::access().invalidate_text(text, font, color);
+        Bench::do_not_optimize(Fonts::access().render_text(Bench::renderer(), text, font, color));
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(render_text_uncached, 8, 64, 256);
+
+static void render_text_cached(Bench::State& state) {
+    using Fonts = Core::FontManager;
+    Fonts::FontPtr    font  = Fonts::access().default_font();
+    const SDL_Color   color = Fonts::access().default_font_color();
+    const std::string text  = TEXT_OF_LENGTH(state.argument());
+
+    while (state.keep_running()) {
+        Bench::do_not_optimize(Fonts::access().render_text(Bench::renderer(), text, font, color));
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(render_text_cached, 8, 64, 256);
+
+/// Draws through the glyph atlas, including the renderer's work to draw the quads.
+static void draw_text_glyph_atlas(Bench::State& state) {
+    using Fonts = Core::FontManager;
+    Fonts::FontPtr    font  = Fonts::access().default_font();
+    const SDL_Color   color = Fonts::access().default_font_color();
+    const std::string text  = TEXT_OF_LENGTH(state.argument());
+
+    while (state.keep_running()) {
+        Fonts::access().draw_text(Bench::renderer(), text, font, color, 0, 0);
+        SDL_RenderFlush(Bench::renderer());
+    }
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(draw_text_glyph_atlas, 8, 64, 256);
@@ -0,0 +1,60 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/TextureManager.h"
+
+#include <thread>
+
+#include <SDL_image.h>
+#include <SDL_render.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static const char* const BALL_IMAGE = "resources/img/pixel-art-ball.png";
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/// Decoding and uploading on the render thread, the way images were loaded before the texture manager.
+static void texture_load_blocking(Bench::State& state) {
+    while (state.keep_running()) {
+        SDL_Surface* surface = IMG_Load(BALL_IMAGE);
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(Bench::renderer(), surface);
+        Bench::do_not_optimize(texture);
+        SDL_DestroyTexture(texture);
+        SDL_FreeSurface(surface);
+    }
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(texture_load_blocking);
+
+/// The render thread's share of the same load: queuing it, then uploading it once a worker has decoded it.
+static void texture_load_async(Bench::State& state) {
+    Core::TextureManager& textures = Core::TextureManager::access();
+
+    while (state.keep_running()) {
+        Core::TextureManager::Handle handle = textures.load(Bench::renderer(), BALL_IMAGE);
+
+        state.pause_timing();
+        while (textures.stats().pending_decodes > 0) { std::this_thread::yield(); }
+        state.resume_timing();
+
+        textures.upload_pending(Bench::renderer());
+        Bench::do_not_optimize(handle.texture());
+
+        state.pause_timing();
+        textures.release_renderer(Bench::renderer());
+        state.resume_timing();
+    }
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(texture_load_async);
@@ -0,0 +1,98 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../rendering/BatchRenderer.h"
+#include "../rendering/TileMap.h"
+
+#include <vector>
+
+#include <SDL_render.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    const int TILE_SIZE       = 16;
+    const int TILESET_COLUMNS = 16;
+    const int MAP_TILES       = 512; ///< The map is this many tiles square, far wider than the view.
+    const int VIEW_WIDTH      = 1024;
+    const int VIEW_HEIGHT     = 768;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static Rendering::BatchRenderer::TexturePtr MAKE_TILESET() {
+    return {SDL_CreateTexture(Bench::renderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                              TILESET_COLUMNS * TILE_SIZE, TILESET_COLUMNS * TILE_SIZE),
+            SDL_DestroyTexture};
+}
+
+/// Every tile is filled, with a pattern of tile ids that never repeats within the view.
+static Rendering::TileMap::Tile TILE_AT(int x, int y) {
+    return static_cast<Rendering::TileMap::Tile>(1 + (x * 7 + y * 13) % (TILESET_COLUMNS * TILESET_COLUMNS));
+}
+
+/// Scrolls diagonally, a few pixels a frame, wrapping around inside the map.
+static SDL_FRect CAMERA_AT(std::int64_t frame) {
+    const float range = static_cast<float>(MAP_TILES * TILE_SIZE - VIEW_WIDTH);
+    const float shift = static_cast<float>((frame * 3) % static_cast<std::int64_t>(range));
+    return {shift, shift * 0.5f, static_cast<float>(VIEW_WIDTH), static_cast<float>(VIEW_HEIGHT)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/// The per-tile loop the tile map replaces: every tile in view is its own copy.
+static void tiles_per_tile_copy(Bench::State& state) {
+    auto                     tileset = MAKE_TILESET();
+    Rendering::BatchRenderer batch(Bench::renderer());
+
+    std::int64_t frame = 0;
+    while (state.keep_running()) {
+        SDL_FRect camera = CAMERA_AT(frame++);
+        int       first_x = static_cast<int>(camera.x) / TILE_SIZE, first_y = static_cast<int>(camera.y) / TILE_SIZE;
+        for (int y = first_y; y <= first_y + VIEW_HEIGHT / TILE_SIZE; y++) {
+            for (int x = first_x; x <= first_x + VIEW_WIDTH / TILE_SIZE; x++) {
+                int      index = TILE_AT(x, y) - 1;
+                SDL_Rect source{(index % TILESET_COLUMNS) * TILE_SIZE, (index / TILESET_COLUMNS) * TILE_SIZE,
+                                TILE_SIZE, TILE_SIZE};
+                SDL_Rect dest{x * TILE_SIZE - static_cast<int>(camera.x), y * TILE_SIZE - static_cast<int>(camera.y),
+                              TILE_SIZE, TILE_SIZE};
+                batch.copy(tileset, source, dest);
+            }
+        }
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+    }
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(tiles_per_tile_copy);
+
+/// The same scrolling view from cached chunk textures.
+static void tiles_chunked(Bench::State& state) {
+    Rendering::TileMap       map({MAKE_TILESET(), TILE_SIZE, TILE_SIZE}, static_cast<int>(state.argument()));
+    Rendering::BatchRenderer batch(Bench::renderer());
+    for (int y = 0; y < MAP_TILES; y++) {
+        for (int x = 0; x < MAP_TILES; x++) { map.tile(x, y, TILE_AT(x, y)); }
+    }
+
+    std::int64_t frame = 0;
+    while (state.keep_running()) {
+        map.render(batch, CAMERA_AT(frame++));
+        batch.flush();
+        SDL_RenderFlush(Bench::renderer());
+    }
+    map.release_textures();
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(tiles_chunked, 16, 32);
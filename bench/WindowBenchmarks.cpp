@@ -0,0 +1,53 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Benchmark.h"
+#include "../core/EventDispatcher.h"
+#include "../rendering/Windowing.h"
+
+#include <SDL_events.h>
+
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+/// The cost of one frame of the main loop with nothing to update or draw.
+static void window_run_frame(Bench::State& state) {
+    Rendering::Window& window = Bench::window();
+    window.set_user_update_callback([]() {});
+    window.set_user_draw_callback([](SDL_Renderer*) {});
+
+    while (state.keep_running()) {
+        window.run_frames(1);
+    }
+    state.set_items_processed(state.iterations());
+}
+BENCHMARK_FUNCTION(window_run_frame);
+
+/// Queues a burst of mouse motion and drains it through a dispatcher with one handler per event type in use.
+static void event_dispatch_pending(Bench::State& state) {
+    Core::EventDispatcher dispatcher;
+    std::uint64_t         handled = 0;
+    dispatcher.add_handler(SDL_MOUSEMOTION, [&handled](SDL_Event&) { handled++; });
+    dispatcher.add_handler(SDL_KEYDOWN, [&handled](SDL_Event&) { handled++; });
+
+    SDL_Event motion{};
+    motion.type = SDL_MOUSEMOTION;
+    while (state.keep_running()) {
+        state.pause_timing();
+        for (int i = 0; i < state.argument(); i++) { SDL_PushEvent(&motion); }
+        state.resume_timing();
+
+        dispatcher.dispatch_pending();
+    }
+    Bench::do_not_optimize(handled);
+    state.set_items_processed(state.iterations() * state.argument());
+}
+BENCHMARK_FUNCTION(event_dispatch_pending, 16, 256, 1024);
@@ -0,0 +1,119 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        std::atomic<std::uint64_t> TOTAL_ALLOCATIONS{0};
+
+        // Plain integers, so counting from inside operator new can't itself allocate.
+        thread_local std::uint64_t THREAD_ALLOCATIONS     = 0;
+        thread_local std::uint64_t THREAD_BYTES_ALLOCATED = 0;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    std::uint64_t AllocationCounter::total_allocations() { return TOTAL_ALLOCATIONS.load(std::memory_order_relaxed); }
+
+    std::uint64_t AllocationCounter::thread_allocations() { return THREAD_ALLOCATIONS; }
+
+    std::uint64_t AllocationCounter::thread_bytes_allocated() { return THREAD_BYTES_ALLOCATED; }
+
+#ifdef GOLD_CARTRIDGE_COUNT_ALLOCATIONS
+
+////////////////////////////////////////////////////////////////////////////////
+/// Counting Allocation Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    static void* COUNTED_ALLOCATE(std::size_t bytes, std::size_t alignment) {
+        TOTAL_ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+        THREAD_ALLOCATIONS++;
+        THREAD_BYTES_ALLOCATED += bytes;
+
+        if (bytes == 0) { bytes = 1; }
+        if (alignment <= alignof(std::max_align_t)) { return std::malloc(bytes); }
+
+        // aligned_alloc wants a size that's a multiple of the alignment.
+        bytes = (bytes + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+        return _aligned_malloc(bytes, alignment);
+#else
+        return std::aligned_alloc(alignment, bytes);
+#endif
+    }
+
+    static void COUNTED_FREE(void* memory, std::size_t alignment) {
+#ifdef _WIN32
+        if (alignment > alignof(std::max_align_t)) {
+            _aligned_free(memory);
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        std::free(memory);
+    }
+
+    static void* ALLOCATE_OR_THROW(std::size_t bytes, std::size_t alignment) {
+        void* memory = COUNTED_ALLOCATE(bytes, alignment);
+        if (!memory) { throw std::bad_alloc(); }
+        return memory;
+    }
+
+#endif
+
+} // Core
+
+#ifdef GOLD_CARTRIDGE_COUNT_ALLOCATIONS
+
+void* operator new(std::size_t bytes) { return Core::ALLOCATE_OR_THROW(bytes, alignof(std::max_align_t)); }
+void* operator new[](std::size_t bytes) { return Core::ALLOCATE_OR_THROW(bytes, alignof(std::max_align_t)); }
+void* operator new(std::size_t bytes, std::align_val_t alignment) {
+    return Core::ALLOCATE_OR_THROW(bytes, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t bytes, std::align_val_t alignment) {
+    return Core::ALLOCATE_OR_THROW(bytes, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept {
+    return Core::COUNTED_ALLOCATE(bytes, alignof(std::max_align_t));
+}
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept {
+    return Core::COUNTED_ALLOCATE(bytes, alignof(std::max_align_t));
+}
+
+void operator delete(void* memory) noexcept { Core::COUNTED_FREE(memory, alignof(std::max_align_t)); }
+void operator delete[](void* memory) noexcept { Core::COUNTED_FREE(memory, alignof(std::max_align_t)); }
+void operator delete(void* memory, std::size_t) noexcept { Core::COUNTED_FREE(memory, alignof(std::max_align_t)); }
+void operator delete[](void* memory, std::size_t) noexcept { Core::COUNTED_FREE(memory, alignof(std::max_align_t)); }
+void operator delete(void* memory, std::align_val_t alignment) noexcept {
+    Core::COUNTED_FREE(memory, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* memory, std::align_val_t alignment) noexcept {
+    Core::COUNTED_FREE(memory, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept {
+    Core::COUNTED_FREE(memory, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* memory, std::size_t, std::align_val_t alignment) noexcept {
+    Core::COUNTED_FREE(memory, static_cast<std::size_t>(alignment));
+}
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_ALLOCATION_COUNTER_H
+#define GOLD_CARTRIDGE_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+namespace Core {
+
+    /**
+     * @brief Counts heap allocations made through operator new.
+     *
+     * Counting replaces the global operator new and delete, so it's only
+     * compiled in when GOLD_CARTRIDGE_COUNT_ALLOCATIONS is defined (the CMake
+     * option of the same name). Otherwise every count stays at zero.
+     * Allocations SDL and other C libraries make with malloc aren't counted.
+     */
+    class AllocationCounter {
+    public:
+        static constexpr bool is_enabled() {
+#ifdef GOLD_CARTRIDGE_COUNT_ALLOCATIONS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /// Allocations made by every thread since the program started.
+        static std::uint64_t total_allocations();
+
+        /// Allocations made by the calling thread, unaffected by job workers and other background threads.
+        static std::uint64_t thread_allocations();
+        static std::uint64_t thread_bytes_allocated();
+
+        AllocationCounter() = delete;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_ALLOCATION_COUNTER_H
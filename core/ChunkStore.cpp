@@ -0,0 +1,149 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "ChunkStore.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        const char          FILE_MAGIC[4] = {'G', 'C', 'T', 'M'};
+        const std::uint32_t FILE_VERSION  = 1;
+
+        /// Magic, version, width and height in chunks, and chunk size in tiles.
+        struct FileHeader {
+            char          magic[4];
+            std::uint32_t version;
+            std::uint32_t width_in_chunks;
+            std::uint32_t height_in_chunks;
+            std::uint32_t chunk_tiles;
+        };
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /// Seeks from the start of a file. Plain fseek takes a long, which is 32 bits on Windows.
+    static bool SEEK(std::FILE* file, std::int64_t offset) {
+#if defined(_WIN32)
+        return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+        return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    FileChunkStore::FileChunkStore(std::FILE* file, int width_in_chunks, int height_in_chunks, int chunk_tiles)
+            : m_file(file),
+              m_width_in_chunks(width_in_chunks),
+              m_height_in_chunks(height_in_chunks),
+              m_chunk_tiles(chunk_tiles) {}
+
+    FileChunkStore::~FileChunkStore() { std::fclose(m_file); }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    std::unique_ptr<FileChunkStore> FileChunkStore::open(const std::string& path) {
+        std::FILE* file = std::fopen(path.c_str(), "r+b");
+        if (!file) {
+            LOG_ERROR("Could not open tile map file %s", path.c_str());
+            return nullptr;
+        }
+
+        FileHeader header{};
+        if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+            std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FILE_VERSION ||
+            header.chunk_tiles == 0) {
+            LOG_ERROR("%s is not a tile map file, or was written by a different version", path.c_str());
+            std::fclose(file);
+            return nullptr;
+        }
+        return std::unique_ptr<FileChunkStore>(new FileChunkStore(file, static_cast<int>(header.width_in_chunks),
+                                                                  static_cast<int>(header.height_in_chunks),
+                                                                  static_cast<int>(header.chunk_tiles)));
+    }
+
+    std::unique_ptr<FileChunkStore> FileChunkStore::create(const std::string& path, int width_in_chunks,
+                                                           int height_in_chunks, int chunk_tiles) {
+        if (width_in_chunks <= 0 || height_in_chunks <= 0 || chunk_tiles <= 0) { return nullptr; }
+
+        std::FILE* file = std::fopen(path.c_str(), "w+b");
+        if (!file) {
+            LOG_ERROR("Could not create tile map file %s", path.c_str());
+            return nullptr;
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version          = FILE_VERSION;
+        header.width_in_chunks  = static_cast<std::uint32_t>(width_in_chunks);
+        header.height_in_chunks = static_cast<std::uint32_t>(height_in_chunks);
+        header.chunk_tiles      = static_cast<std::uint32_t>(chunk_tiles);
+        if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+            LOG_ERROR("Could not write tile map file %s", path.c_str());
+            std::fclose(file);
+            return nullptr;
+        }
+        return std::unique_ptr<FileChunkStore>(new FileChunkStore(file, width_in_chunks, height_in_chunks,
+                                                                  chunk_tiles));
+    }
+
+    int FileChunkStore::chunk_tiles() const { return m_chunk_tiles; }
+
+    bool FileChunkStore::load(int chunk_x, int chunk_y, Tile* tiles) {
+        if (!seek_to(chunk_x, chunk_y)) { return false; }
+
+        // A chunk past the end of the file was never saved, so whatever wasn't read is empty.
+        const std::size_t count = static_cast<std::size_t>(m_chunk_tiles) * m_chunk_tiles;
+        const std::size_t read  = std::fread(tiles, sizeof(Tile), count, m_file);
+        std::fill(tiles + read, tiles + count, Tile{0});
+        return !std::ferror(m_file);
+    }
+
+    bool FileChunkStore::save(int chunk_x, int chunk_y, const Tile* tiles) {
+        if (!seek_to(chunk_x, chunk_y)) { return false; }
+
+        const std::size_t count = static_cast<std::size_t>(m_chunk_tiles) * m_chunk_tiles;
+        if (std::fwrite(tiles, sizeof(Tile), count, m_file) != count) {
+            LOG_ERROR("Could not save tile map chunk %d, %d", chunk_x, chunk_y);
+            return false;
+        }
+        return true;
+    }
+
+    int FileChunkStore::width_in_chunks() const { return m_width_in_chunks; }
+    int FileChunkStore::height_in_chunks() const { return m_height_in_chunks; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool FileChunkStore::seek_to(int chunk_x, int chunk_y) {
+        if (chunk_x < 0 || chunk_y < 0 || chunk_x >= m_width_in_chunks || chunk_y >= m_height_in_chunks) {
+            return false;
+        }
+        const std::int64_t chunk_bytes = static_cast<std::int64_t>(m_chunk_tiles) * m_chunk_tiles * sizeof(Tile);
+        const std::int64_t index       = static_cast<std::int64_t>(chunk_y) * m_width_in_chunks + chunk_x;
+        std::clearerr(m_file);
+        return SEEK(m_file, static_cast<std::int64_t>(sizeof(FileHeader)) + index * chunk_bytes);
+    }
+
+} // Core
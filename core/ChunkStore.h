@@ -0,0 +1,103 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_CHUNK_STORE_H
+#define GOLD_CARTRIDGE_CHUNK_STORE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace Core {
+
+    /**
+     * @brief Somewhere a tile map keeps the chunks it doesn't have loaded.
+     *
+     * A chunk is a square of chunk_tiles() by chunk_tiles() tile ids, stored
+     * row by row. A tile map only keeps a limited number of chunks in memory,
+     * loading them as they come into view and saving changed ones before it
+     * lets them go, so the whole map never has to fit in memory at once.
+     */
+    class ChunkStore {
+    public:
+        using Tile = std::uint16_t;
+
+    public:
+        virtual ~ChunkStore() = default;
+
+        /// The width and height of every chunk, in tiles.
+        virtual int chunk_tiles() const = 0;
+
+        /**
+         * Reads a chunk.
+         * @param tiles Receives chunk_tiles() squared tile ids. Chunks never saved read as all zeros.
+         * @return False if the chunk is outside the store or couldn't be read.
+         */
+        virtual bool load(int chunk_x, int chunk_y, Tile* tiles) = 0;
+
+        /**
+         * Writes a chunk.
+         * @param tiles chunk_tiles() squared tile ids.
+         * @return False if the chunk is outside the store or couldn't be written.
+         */
+        virtual bool save(int chunk_x, int chunk_y, const Tile* tiles) = 0;
+    };
+
+    /**
+     * @brief Stores a fixed-size grid of chunks in one file, each at a fixed offset, so any chunk is one seek away.
+     *
+     * The file is a short header followed by every chunk in row order, tile ids
+     * in the machine's byte order. Chunks past the end of the file read as
+     * empty, so a new map's file only grows as chunks are saved.
+     */
+    class FileChunkStore : public ChunkStore {
+    public:
+        /**
+         * Opens an existing map file for reading and writing.
+         * @return The store, or null if the file is missing or isn't a map file.
+         */
+        static std::unique_ptr<FileChunkStore> open(const std::string& path);
+
+        /**
+         * Creates an empty map file, replacing any file already at the path.
+         * @param width_in_chunks The map's width, in chunks.
+         * @param height_in_chunks The map's height, in chunks.
+         * @param chunk_tiles The width and height of each chunk, in tiles.
+         * @return The store, or null if the file couldn't be created.
+         */
+        static std::unique_ptr<FileChunkStore> create(const std::string& path, int width_in_chunks,
+                                                      int height_in_chunks, int chunk_tiles);
+        ~FileChunkStore() override;
+
+        FileChunkStore(const FileChunkStore&) = delete;
+        void operator=(const FileChunkStore&) = delete;
+
+        int chunk_tiles() const override;
+        bool load(int chunk_x, int chunk_y, Tile* tiles) override;
+        bool save(int chunk_x, int chunk_y, const Tile* tiles) override;
+
+        int width_in_chunks() const;
+        int height_in_chunks() const;
+
+    private:
+        FileChunkStore(std::FILE* file, int width_in_chunks, int height_in_chunks, int chunk_tiles);
+
+        /// Seeks to a chunk's record. False if the chunk is outside the map.
+        bool seek_to(int chunk_x, int chunk_y);
+
+    private:
+        std::FILE* m_file;
+        int        m_width_in_chunks;
+        int        m_height_in_chunks;
+        int        m_chunk_tiles;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_CHUNK_STORE_H
@@ -0,0 +1,131 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "EventDispatcher.h"
+
+#include <algorithm>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    template <typename EntryList>
+    static bool ERASE_HANDLER(EntryList& handlers, EventDispatcher::HandlerId id) {
+        auto found = std::find_if(handlers.begin(), handlers.end(), [&](const auto& entry) { return entry.id == id; });
+        if (found == handlers.end()) { return false; }
+        handlers.erase(found);
+        return true;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    EventDispatcher::EventDispatcher()
+            : m_batch{},
+              m_next_id(1),
+              m_dispatched_count(0),
+              m_is_dispatching(false) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    EventDispatcher::HandlerId EventDispatcher::add_handler(std::uint32_t event_type, Handler handler) {
+        return add(false, event_type, std::move(handler));
+    }
+
+    EventDispatcher::HandlerId EventDispatcher::add_handler(Handler handler) {
+        return add(true, 0, std::move(handler));
+    }
+
+    void EventDispatcher::remove_handler(HandlerId id) {
+        if (m_is_dispatching) {
+            m_removed_while_dispatching.push_back(id);
+            return;
+        }
+
+        if (ERASE_HANDLER(m_handlers_for_all, id)) { return; }
+        for (auto& [event_type, handlers] : m_handlers_by_type) {
+            if (ERASE_HANDLER(handlers, id)) { return; }
+        }
+    }
+
+    int EventDispatcher::dispatch_pending() {
+        // One pump moves everything the OS has queued into SDL's queue, then the queue is drained in batches
+        // rather than one SDL_PollEvent call (and one implicit pump) per event.
+        SDL_PumpEvents();
+
+        int dispatched = 0;
+        int batch_count;
+        do {
+            batch_count = SDL_PeepEvents(m_batch.data(), BATCH_SIZE, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+            for (int i = 0; i < batch_count; i++) { dispatch(m_batch[i]); }
+            dispatched += std::max(batch_count, 0);
+        } while (batch_count == BATCH_SIZE);
+
+        return dispatched;
+    }
+
+    void EventDispatcher::dispatch(SDL_Event& event) {
+        // A handler that dispatches an event of its own leaves cleaning up to the outermost dispatch.
+        bool is_outermost = !m_is_dispatching;
+        m_is_dispatching = true;
+
+        auto typed_handlers = m_handlers_by_type.find(event.type);
+        if (typed_handlers != m_handlers_by_type.end()) { call_each(typed_handlers->second, event); }
+        call_each(m_handlers_for_all, event);
+        m_dispatched_count++;
+
+        if (is_outermost) {
+            m_is_dispatching = false;
+            apply_pending_changes();
+        }
+    }
+
+    std::uint64_t EventDispatcher::dispatched_count() const { return m_dispatched_count; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    EventDispatcher::HandlerId EventDispatcher::add(bool for_all_events, std::uint32_t event_type, Handler handler) {
+        HandlerId id = m_next_id++;
+        if (m_is_dispatching) {
+            // Growing a handler list now could move the handler that is running.
+            m_added_while_dispatching.push_back({for_all_events, event_type, {id, std::move(handler)}});
+        } else if (for_all_events) {
+            m_handlers_for_all.push_back({id, std::move(handler)});
+        } else {
+            m_handlers_by_type[event_type].push_back({id, std::move(handler)});
+        }
+        return id;
+    }
+
+    void EventDispatcher::call_each(std::vector<Entry>& handlers, SDL_Event& event) {
+        for (Entry& entry : handlers) {
+            bool was_removed = std::find(m_removed_while_dispatching.begin(), m_removed_while_dispatching.end(),
+                                         entry.id) != m_removed_while_dispatching.end();
+            if (!was_removed) { entry.handler(event); }
+        }
+    }
+
+    void EventDispatcher::apply_pending_changes() {
+        for (PendingEntry& pending : m_added_while_dispatching) {
+            if (pending.for_all_events) { m_handlers_for_all.push_back(std::move(pending.entry)); }
+            else { m_handlers_by_type[pending.event_type].push_back(std::move(pending.entry)); }
+        }
+        m_added_while_dispatching.clear();
+
+        for (HandlerId id : m_removed_while_dispatching) { remove_handler(id); }
+        m_removed_while_dispatching.clear();
+    }
+
+} // Core
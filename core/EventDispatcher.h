@@ -0,0 +1,100 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_EVENT_DISPATCHER_H
+#define GOLD_CARTRIDGE_EVENT_DISPATCHER_H
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_events.h>
+
+#include "InplaceFunction.h"
+
+namespace Core {
+
+    /**
+     * @brief Drains SDL's event queue and hands each event to the handlers registered for its type.
+     *
+     * Events are pulled off the queue in fixed-size batches into a buffer that
+     * is reused every time, so pumping the queue doesn't allocate. Each event
+     * is only offered to the handlers registered for its type, followed by the
+     * handlers registered for every event, in the order they were added.
+     * Handlers may be added or removed from inside a handler. Either change
+     * takes effect from the next event.
+     */
+    class EventDispatcher {
+    public:
+        using Handler = InplaceFunction<void(SDL_Event& event)>;
+        using HandlerId = std::uint64_t;
+
+        static constexpr int BATCH_SIZE = 64;
+
+    public:
+        EventDispatcher();
+
+        EventDispatcher(const EventDispatcher&) = delete;
+        void operator=(const EventDispatcher&) = delete;
+
+        /**
+         * Registers a handler for one type of event.
+         * @param event_type An SDL_EventType, or a type from SDL_RegisterEvents().
+         * @param handler The function to call with each event of that type.
+         * @return An id to pass to remove_handler().
+         */
+        HandlerId add_handler(std::uint32_t event_type, Handler handler);
+
+        /// Registers a handler that is offered every event, after the handlers for the event's type.
+        HandlerId add_handler(Handler handler);
+        void remove_handler(HandlerId id);
+
+        /**
+         * Pumps SDL's event queue and dispatches everything in it.
+         * @return The number of events dispatched.
+         */
+        int dispatch_pending();
+
+        /// Sends one event to its handlers without going through SDL's queue.
+        void dispatch(SDL_Event& event);
+
+        std::uint64_t dispatched_count() const;
+
+    private:
+        struct Entry {
+            HandlerId id;
+            Handler   handler;
+        };
+
+        struct PendingEntry {
+            bool          for_all_events;
+            std::uint32_t event_type;
+            Entry         entry;
+        };
+
+        HandlerId add(bool for_all_events, std::uint32_t event_type, Handler handler);
+
+        void call_each(std::vector<Entry>& handlers, SDL_Event& event);
+        void apply_pending_changes();
+
+    private:
+        std::array<SDL_Event, BATCH_SIZE>                     m_batch;
+        std::unordered_map<std::uint32_t, std::vector<Entry>> m_handlers_by_type;
+        std::vector<Entry>                                    m_handlers_for_all;
+        HandlerId                                             m_next_id;
+        std::uint64_t                                         m_dispatched_count;
+
+        bool                      m_is_dispatching;
+        std::vector<PendingEntry> m_added_while_dispatching;
+        std::vector<HandlerId>    m_removed_while_dispatching;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_EVENT_DISPATCHER_H
@@ -7,10 +7,16 @@
  */
 
 #include "FontManager.h"
+#include "Logger.h"
+#include "System.h"
+#include "PixelOps.h"
+#include "TexturePixels.h"
 
 #include <SDL_render.h>
 
-#include <iostream>
+#include <iomanip>
+#include <map>
+#include <vector>
 
 namespace Core {
 
@@ -19,11 +25,38 @@ namespace Core {
 ////////////////////////////////////////////////////////////////////////////////
 
     namespace {
-        std::shared_ptr<TTF_Font> DEFAULT_FONT;
-        const std::string         DEFAULT_FONT_FILE    = "resources/fonts/playfair-display-font/PlayfairDisplayRegular-ywLOY.ttf";
-        const int                 DEFAULT_FONT_PT_SIZE = 12;
+        const std::string         DEFAULT_FONT_FILE         = "resources/fonts/playfair-display-font/PlayfairDisplayRegular-ywLOY.ttf";
+        const std::string         BUNDLED_FONT_DIRECTORY    = "resources/fonts/open-sans/static";
+        const int                 DEFAULT_FONT_PT_SIZE      = 12;
         const SDL_Color           DEFAULT_FONT_COLOR{0, 0, 0, 255};
-        bool                      MANAGER_INITIALIZED  = false;
+        const std::size_t         DEFAULT_TEXT_CACHE_BUDGET = 8 * 1024 * 1024;
+        bool                      MANAGER_INITIALIZED       = false;
+
+        FontRegistry FONT_REGISTRY;
+        TextCache    TEXT_CACHE(DEFAULT_TEXT_CACHE_BUDGET);
+
+        // One atlas per font handle (which fixes the face and size) and renderer (which owns the texture).
+        using AtlasKey = std::pair<TTF_Font*, SDL_Renderer*>;
+        std::map<AtlasKey, std::unique_ptr<GlyphAtlas>> GLYPH_ATLASES;
+
+        // Reused between draw_text() calls so drawing text doesn't allocate once they've grown large enough.
+        std::vector<SDL_Vertex> TEXT_VERTICES;
+        std::vector<int>        TEXT_INDICES;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /// Finds the atlas for a font and renderer pair, (re)building it if the font changed since it was made.
+    static GlyphAtlas* ATLAS_FOR(SDL_Renderer* renderer, const std::shared_ptr<TTF_Font>& font) {
+        if (!renderer || !font) { return nullptr; }
+
+        std::unique_ptr<GlyphAtlas>& atlas = GLYPH_ATLASES[{font.get(), renderer}];
+        if (!atlas || !atlas->matches(font)) {
+            atlas = std::make_unique<GlyphAtlas>(renderer, font);
+        }
+        return atlas.get();
     }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,8 +69,9 @@ namespace Core {
 
     bool FontManager::start_up() {
         if (!is_initialized()) {
-            TTF_Font* font = TTF_OpenFont(DEFAULT_FONT_FILE.c_str(), DEFAULT_FONT_PT_SIZE);
-            DEFAULT_FONT = std::shared_ptr<TTF_Font>(font, TTF_CloseFont);
+            // Fonts are opened on first use. The bundled faces are parsed in
+            // the background so they are usually ready before anyone asks.
+            FONT_REGISTRY.preload_directory(BUNDLED_FONT_DIRECTORY, DEFAULT_FONT_PT_SIZE, TTF_STYLE_NORMAL);
 
             MANAGER_INITIALIZED = true;
         }
@@ -46,7 +80,9 @@ namespace Core {
 
     void FontManager::shut_down() {
         if (is_initialized()) {
-            DEFAULT_FONT.reset();
+            TEXT_CACHE.clear();
+            GLYPH_ATLASES.clear();
+            FONT_REGISTRY.clear();
             MANAGER_INITIALIZED = false;
         }
     }
@@ -56,31 +92,153 @@ namespace Core {
         return instance;
     }
 
-    std::shared_ptr<TTF_Font> FontManager::default_font() { return DEFAULT_FONT; }
+    std::shared_ptr<TTF_Font> FontManager::default_font() {
+        System::require(System::Fonts);
+        return FONT_REGISTRY.font(DEFAULT_FONT_FILE, DEFAULT_FONT_PT_SIZE, TTF_STYLE_NORMAL);
+    }
+
+    FontManager::FontPtr FontManager::font(const std::string& path, int point_size, int style) {
+        System::require(System::Fonts);
+        return FONT_REGISTRY.font(path, point_size, style);
+    }
+
+    void FontManager::preload_fonts(const std::string& directory, int point_size, int style) {
+        System::require(System::Fonts);
+        FONT_REGISTRY.preload_directory(directory, point_size, style);
+    }
+
+    bool FontManager::is_preloading_fonts() { return FONT_REGISTRY.is_preloading(); }
+
+    void FontManager::wait_for_font_preloads() { FONT_REGISTRY.wait_for_preloads(); }
+
+    FontRegistry::LoadReport FontManager::font_load_report() { return FONT_REGISTRY.load_report(); }
+
+    void FontManager::write_font_load_report(std::ostream& out) {
+        FontRegistry::LoadReport report = FONT_REGISTRY.load_report();
+
+        const std::ios_base::fmtflags previous_flags     = out.flags();
+        const std::streamsize         previous_precision = out.precision();
+
+        double total_map_ms  = 0.0;
+        double total_open_ms = 0.0;
+        out << std::fixed << std::setprecision(3);
+        out << "Font load report:" << std::endl;
+        for (const FontRegistry::LoadTiming& face : report.faces) {
+            total_map_ms += face.map_ms;
+            total_open_ms += face.open_ms;
+            out << "  " << (face.loaded ? "" : "[FAILED] ") << face.path << " @ " << face.point_size << "pt"
+                << "  map " << face.map_ms << " ms" << (face.shared_mapping ? " (shared)" : "")
+                << "  parse " << face.open_ms << " ms" << std::endl;
+        }
+        out << "  " << report.faces.size() << " faces from " << report.mapped_files << " mapped files ("
+            << static_cast<double>(report.mapped_bytes) / (1024.0 * 1024.0) << " MiB)" << std::endl;
+        out << "  map total " << total_map_ms << " ms, parse total " << total_open_ms
+            << " ms, background preload wall time " << report.preload_ms << " ms" << std::endl;
+        out.flags(previous_flags);
+        out.precision(previous_precision);
+    }
 
     int FontManager::default_font_size() { return DEFAULT_FONT_PT_SIZE; }
 
     SDL_Color FontManager::default_font_color() { return DEFAULT_FONT_COLOR; }
 
-    FontManager::TexturePtr
+    FontManager::SharedTexturePtr
     FontManager::render_text(SDL_Renderer* renderer, const std::string& text,
                              const FontPtr& font, const SDL_Color& font_color) {
+        if (SharedTexturePtr cached = TEXT_CACHE.find(renderer, text, font, font_color)) { return cached; }
+
         // Pre-render the text to a pixel surface.
         SDL_Surface* prerender = TTF_RenderText_Blended(font.get(), text.c_str(), font_color);
         if (!prerender) {
-            std::cerr << "Unable to render text to a drawing surface." << std::endl;
-            return {nullptr, SDL_DestroyTexture};
+            LOG_ERROR("Unable to render text to a drawing surface: %s", TTF_GetError());
+            return nullptr;
         }
 
         // Render the surface to a texture.
         SDL_Texture* final_render = SDL_CreateTextureFromSurface(renderer, prerender);
-        SDL_FreeSurface(prerender);
         if (!final_render) {
-            std::cerr << "Unable to convert text drawing surface to a texture." << std::endl;
-            return {nullptr, SDL_DestroyTexture};
+            SDL_FreeSurface(prerender);
+            LOG_ERROR("Unable to convert text drawing surface to a texture: %s", SDL_GetError());
+            return nullptr;
         }
 
-        return TexturePtr{final_render, SDL_DestroyTexture};
+        // Where textures are drawn in software, the drawing needs the pixels the texture was made from.
+        std::shared_ptr<SDL_Surface> pixels;
+        if (TexturePixels::access().is_kept_for(renderer)) {
+            pixels.reset(PixelOps::to_argb8888(prerender), SDL_FreeSurface);
+        }
+        SDL_FreeSurface(prerender);
+
+        SharedTexturePtr result = TexturePixels::access().adopt(final_render, std::move(pixels));
+        TEXT_CACHE.insert(renderer, text, font, font_color, result);
+        return result;
+    }
+
+    void FontManager::invalidate_text(SDL_Renderer* renderer, const std::string& text, const FontPtr& font,
+                                      const SDL_Color& font_color) {
+        TEXT_CACHE.invalidate(renderer, text, font, font_color);
+    }
+
+    void FontManager::invalidate_text(const std::string& text, const FontPtr& font, const SDL_Color& font_color) {
+        TEXT_CACHE.invalidate(text, font, font_color);
+    }
+
+    TextCache::Stats FontManager::text_cache_stats() { return TEXT_CACHE.stats(); }
+
+    std::size_t FontManager::text_cache_budget() { return TEXT_CACHE.budget(); }
+
+    void FontManager::text_cache_budget(std::size_t new_byte_budget) { TEXT_CACHE.budget(new_byte_budget); }
+
+    bool FontManager::draw_text(SDL_Renderer* renderer, const std::string& text, const FontPtr& font,
+                                const SDL_Color& font_color, int x, int y, const SDL_Rect* clip) {
+        TEXT_VERTICES.clear();
+        TEXT_INDICES.clear();
+        SharedTexturePtr atlas_texture = layout_text(renderer, text, font, font_color, x, y, clip,
+                                                     TEXT_VERTICES, TEXT_INDICES);
+        if (!atlas_texture) { return false; }
+        if (TEXT_INDICES.empty()) { return true; }
+
+        return SDL_RenderGeometry(renderer, atlas_texture.get(),
+                                  TEXT_VERTICES.data(), static_cast<int>(TEXT_VERTICES.size()),
+                                  TEXT_INDICES.data(), static_cast<int>(TEXT_INDICES.size())) == 0;
+    }
+
+    FontManager::SharedTexturePtr
+    FontManager::layout_text(SDL_Renderer* renderer, const std::string& text, const FontPtr& font,
+                             const SDL_Color& font_color, int x, int y, const SDL_Rect* clip,
+                             std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) {
+        GlyphAtlas* atlas = ATLAS_FOR(renderer, font);
+        if (!atlas) { return nullptr; }
+
+        if (!atlas->layout(text, font_color, x, y, clip, vertices, indices)) {
+            LOG_ERROR("Unable to update the glyph atlas texture: %s", SDL_GetError());
+            return nullptr;
+        }
+        return atlas->texture();
+    }
+
+    SDL_Point FontManager::text_size(SDL_Renderer* renderer, const std::string& text, const FontPtr& font) {
+        GlyphAtlas* atlas = ATLAS_FOR(renderer, font);
+        return atlas ? atlas->measure(text) : SDL_Point{0, 0};
+    }
+
+    GlyphAtlas::Stats FontManager::glyph_atlas_stats() {
+        GlyphAtlas::Stats total;
+        for (const auto& [key, atlas] : GLYPH_ATLASES) {
+            const GlyphAtlas::Stats& stats = atlas->stats();
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.evictions += stats.evictions;
+            total.growths += stats.growths;
+            total.glyphs += stats.glyphs;
+            total.bytes += stats.bytes;
+        }
+        return total;
+    }
+
+    void FontManager::release_renderer(SDL_Renderer* renderer) {
+        TEXT_CACHE.release_renderer(renderer);
+        std::erase_if(GLYPH_ATLASES, [renderer](const auto& entry) { return entry.first.second == renderer; });
     }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -10,14 +10,22 @@
 #define GOLD_CARTRIDGE_FONT_MANAGER_H
 
 #include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
 
 #include <SDL_ttf.h>
 
+#include "FontRegistry.h"
+#include "GlyphAtlas.h"
+#include "TextCache.h"
+
 namespace Core {
 
     class FontManager {
     public:
         using TexturePtr = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>;
+        using SharedTexturePtr = TextCache::TexturePtr;
         using FontPtr = std::shared_ptr<TTF_Font>;
 
         int default_font_size();
@@ -30,8 +38,63 @@ namespace Core {
         void shut_down();
 
         FontPtr default_font();
-        TexturePtr render_text(SDL_Renderer* renderer, const std::string& text,
-                               const FontPtr& font, const SDL_Color& font_color);
+
+        /**
+         * Gets a shared handle to a font face, loading it the first time it is asked for.
+         * @param path The font file to load.
+         * @param point_size The height of the font, in points.
+         * @param style A combination of TTF_STYLE_* flags.
+         * @return The font, or null if it could not be loaded.
+         */
+        FontPtr font(const std::string& path, int point_size, int style = TTF_STYLE_NORMAL);
+        void preload_fonts(const std::string& directory, int point_size, int style = TTF_STYLE_NORMAL);
+        bool is_preloading_fonts();
+        void wait_for_font_preloads();
+        FontRegistry::LoadReport font_load_report();
+        void write_font_load_report(std::ostream& out);
+
+        /**
+         * Renders a line of text to a texture, reusing an earlier result for the same text, font, color,
+         * and renderer if it is still in the text cache.
+         * @return The rendered text, or null if it could not be rendered.
+         */
+        SharedTexturePtr render_text(SDL_Renderer* renderer, const std::string& text,
+                                     const FontPtr& font, const SDL_Color& font_color);
+        /// Drops the cached render of a string on one renderer, as when a label that used it changes.
+        void invalidate_text(SDL_Renderer* renderer, const std::string& text, const FontPtr& font,
+                             const SDL_Color& font_color);
+        /// Drops a string's cached renders on every renderer. See TextCache::invalidate() for when that's wanted.
+        void invalidate_text(const std::string& text, const FontPtr& font, const SDL_Color& font_color);
+        TextCache::Stats text_cache_stats();
+        std::size_t text_cache_budget();
+        void text_cache_budget(std::size_t new_byte_budget);
+
+        /**
+         * Draws a line of text from the font's glyph atlas, rasterizing only glyphs not drawn before.
+         * @param renderer The renderer to draw with.
+         * @param text The UTF-8 text to draw.
+         * @param font The font to draw the text in.
+         * @param font_color The color of the text.
+         * @param x The x-coordinate of the text's top-left corner, in pixels.
+         * @param y The y-coordinate of the text's top-left corner, in pixels.
+         * @param clip An optional area to cut the text to, in pixels.
+         * @return True if the text was drawn.
+         */
+        bool draw_text(SDL_Renderer* renderer, const std::string& text, const FontPtr& font,
+                       const SDL_Color& font_color, int x, int y, const SDL_Rect* clip = nullptr);
+        SDL_Point text_size(SDL_Renderer* renderer, const std::string& text, const FontPtr& font);
+
+        /**
+         * Appends the glyph quads for a line of text to a vertex and index list instead of drawing them,
+         * so they can be batched with other geometry. Parameters match draw_text().
+         * @return The glyph atlas texture the quads sample from, or null if the text could not be laid out.
+         */
+        SharedTexturePtr layout_text(SDL_Renderer* renderer, const std::string& text, const FontPtr& font,
+                                     const SDL_Color& font_color, int x, int y, const SDL_Rect* clip,
+                                     std::vector<SDL_Vertex>& vertices, std::vector<int>& indices);
+
+        GlyphAtlas::Stats glyph_atlas_stats();
+        void release_renderer(SDL_Renderer* renderer);
 
         FontManager(const FontManager&) = delete;
         void operator=(const FontManager&) = delete;
@@ -0,0 +1,252 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "FontRegistry.h"
+#include "Logger.h"
+
+#include <SDL_rwops.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+
+        // SDL_ttf shares one FreeType library between all fonts, and FreeType
+        // requires opening and closing faces on a shared library to be
+        // serialized. Only mapping a font file can overlap with another face
+        // being opened.
+        std::mutex FREETYPE_MUTEX;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    static std::string NORMALIZED_PATH(const std::string& path) {
+        return std::filesystem::path(path).lexically_normal().generic_string();
+    }
+
+    static bool IS_FONT_FILE(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".ttf" || extension == ".otf";
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    FontRegistry::FontRegistry() : m_preload_ms(0.0) {}
+    FontRegistry::~FontRegistry() { wait_for_preloads(); }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    FontRegistry::FontPtr FontRegistry::font(const std::string& path, int point_size, int style) {
+        FontKey               key{NORMALIZED_PATH(path), point_size, style};
+        std::promise<FontPtr> promise;
+        FontFuture            future;
+        if (claim(key, promise, future)) {
+            promise.set_value(open(key));
+            forget_if_failed(key);
+        }
+        return future.get();
+    }
+
+    void FontRegistry::preload_directory(const std::string& directory, int point_size, int style) {
+        auto preload = [this, directory, point_size, style]() {
+            const Clock::time_point preload_start = Clock::now();
+
+            struct PendingFont {
+                FontKey               key;
+                std::promise<FontPtr> promise;
+            };
+
+            // Claim every face up front so that a request made while the
+            // directory is loading waits for it rather than opening it twice.
+            std::error_code          error;
+            std::vector<PendingFont> pending;
+            for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+                if (!entry.is_regular_file() || !IS_FONT_FILE(entry.path())) { continue; }
+
+                PendingFont font{{NORMALIZED_PATH(entry.path().string()), point_size, style}, {}};
+                FontFuture  future;
+                if (claim(font.key, font.promise, future)) { pending.push_back(std::move(font)); }
+            }
+            if (error) {
+                LOG_WARNING("Unable to list font directory %s: %s", directory.c_str(), error.message().c_str());
+            }
+
+            // FreeType opens one face at a time however many threads ask, so
+            // the faces are loaded one after another on this thread alone.
+            for (PendingFont& font : pending) {
+                font.promise.set_value(open(font.key));
+                forget_if_failed(font.key);
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_preload_ms += Milliseconds(Clock::now() - preload_start).count();
+        };
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_preloads.push_back(std::async(std::launch::async, preload));
+    }
+
+    bool FontRegistry::is_preloading() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::erase_if(m_preloads, [](const std::future<void>& preload) {
+            return preload.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+        return !m_preloads.empty();
+    }
+
+    void FontRegistry::wait_for_preloads() {
+        // Preloads claim fonts through m_mutex, so it can't be held while waiting for them.
+        std::vector<std::future<void>> preloads;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            preloads.swap(m_preloads);
+        }
+        for (std::future<void>& preload : preloads) { preload.wait(); }
+    }
+
+    void FontRegistry::clear() {
+        wait_for_preloads();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fonts.clear();
+    }
+
+    std::size_t FontRegistry::size() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fonts.size();
+    }
+
+    FontRegistry::LoadReport FontRegistry::load_report() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        LoadReport                  report;
+        report.faces      = m_load_timings;
+        report.preload_ms = m_preload_ms;
+        for (const auto& [path, file] : m_files) {
+            if (auto mapping = file.lock()) {
+                report.mapped_files++;
+                report.mapped_bytes += mapping->size();
+            }
+        }
+        return report;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool FontRegistry::claim(const FontKey& key, std::promise<FontPtr>& promise, FontFuture& future) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        found = m_fonts.find(key);
+        if (found != m_fonts.end()) {
+            future = found->second;
+            return false;
+        }
+        future = promise.get_future().share();
+        m_fonts.emplace(key, future);
+        return true;
+    }
+
+    void FontRegistry::forget_if_failed(const FontKey& key) {
+        // Anyone already waiting still sees the failure, but the next request tries the file again.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        found = m_fonts.find(key);
+        if (found != m_fonts.end() &&
+            found->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready && !found->second.get()) {
+            m_fonts.erase(found);
+        }
+    }
+
+    FontRegistry::FontPtr FontRegistry::open(const FontKey& key) {
+        LoadTiming timing{key.path, key.point_size, key.style, 0.0, 0.0, false, false};
+        auto       record_timing = [this, &timing]() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_load_timings.push_back(timing);
+        };
+
+        Clock::time_point map_start = Clock::now();
+        std::shared_ptr<const MappedFile> file = map_file(key.path, timing.shared_mapping);
+        if (!timing.shared_mapping) { timing.map_ms = Milliseconds(Clock::now() - map_start).count(); }
+        if (!file) {
+            LOG_ERROR("Unable to open font file %s", key.path.c_str());
+            record_timing();
+            return nullptr;
+        }
+
+        TTF_Font* font;
+        {
+            std::lock_guard<std::mutex> lock(FREETYPE_MUTEX);
+            Clock::time_point           open_start = Clock::now();
+            SDL_RWops*                  source     = SDL_RWFromConstMem(file->data(), static_cast<int>(file->size()));
+            constexpr int               close_source_with_font = 1;
+            font = TTF_OpenFontRW(source, close_source_with_font, key.point_size);
+            if (font) { TTF_SetFontStyle(font, key.style); }
+            timing.open_ms = Milliseconds(Clock::now() - open_start).count();
+        }
+
+        timing.loaded = font != nullptr;
+        record_timing();
+        if (!font) {
+            LOG_ERROR("Unable to load font %s at %dpt: %s", key.path.c_str(), key.point_size, SDL_GetError());
+            return nullptr;
+        }
+
+        // SDL_ttf reads from the font source for as long as the font is open,
+        // so the handle keeps the mapping alive.
+        return {font, [file](TTF_Font* font) {
+            std::lock_guard<std::mutex> lock(FREETYPE_MUTEX);
+            TTF_CloseFont(font);
+        }};
+    }
+
+    std::shared_ptr<const MappedFile> FontRegistry::map_file(const std::string& path, bool& shared_mapping) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (std::shared_ptr<const MappedFile> file = m_files[path].lock()) {
+                shared_mapping = true;
+                return file;
+            }
+        }
+
+        // Opening and mapping the file is a system call, so it happens outside the lock.
+        std::shared_ptr<const MappedFile> mapped = MappedFile::open(path);
+        if (!mapped) {
+            shared_mapping = false;
+            return nullptr;
+        }
+
+        // Another size or style of the same file may have been mapped meanwhile. Keep that one, so there's
+        // still only one mapping per file.
+        std::lock_guard<std::mutex>       lock(m_mutex);
+        std::weak_ptr<const MappedFile>&  cached = m_files[path];
+        std::shared_ptr<const MappedFile> file   = cached.lock();
+        shared_mapping = file != nullptr;
+        if (!file) {
+            file   = std::move(mapped);
+            cached = file;
+        }
+        return file;
+    }
+
+} // Core
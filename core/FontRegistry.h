@@ -0,0 +1,121 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_FONT_REGISTRY_H
+#define GOLD_CARTRIDGE_FONT_REGISTRY_H
+
+#include <compare>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SDL_ttf.h>
+
+#include "MappedFile.h"
+
+namespace Core {
+
+    /**
+     * @brief Opens each font face once and shares the handle with everyone who asks for it.
+     *
+     * Faces are keyed by file path, point size, and style, and are opened the
+     * first time they are requested. Whole directories can also be loaded ahead
+     * of time on a background thread. Asking for a face that is still being
+     * loaded in the background waits for that load instead of opening it again.
+     * A face that fails to open is forgotten, so the next request retries it.
+     * Font files are memory mapped, and every size and style of the same file
+     * shares one read-only mapping.
+     */
+    class FontRegistry {
+    public:
+        using FontPtr = std::shared_ptr<TTF_Font>;
+
+        /// How long it took to make one face ready for use.
+        struct LoadTiming {
+            std::string path;
+            int         point_size;
+            int         style;
+            double      map_ms;         ///< Time spent mapping the file, or zero if the mapping was shared.
+            double      open_ms;        ///< Time SDL_ttf spent parsing the face.
+            bool        shared_mapping; ///< Whether another face of the same file was already mapped.
+            bool        loaded;
+        };
+
+        struct LoadReport {
+            std::vector<LoadTiming> faces;
+            std::size_t             mapped_files = 0; ///< Files mapped right now.
+            std::size_t             mapped_bytes = 0; ///< Combined size of those files.
+            double                  preload_ms   = 0; ///< Wall-clock time of every finished directory preload.
+        };
+
+    public:
+        FontRegistry();
+        ~FontRegistry();
+
+        FontRegistry(const FontRegistry&) = delete;
+        void operator=(const FontRegistry&) = delete;
+
+        /**
+         * Gets a shared handle to a font face, opening it if this is the first request for it.
+         * @param path The font file to load.
+         * @param point_size The height of the font, in points.
+         * @param style A combination of TTF_STYLE_* flags.
+         * @return The font, or null if it could not be opened.
+         */
+        FontPtr font(const std::string& path, int point_size, int style);
+
+        /**
+         * Starts loading every .ttf and .otf file in a directory on a background thread. Faces are opened one
+         * at a time, since FreeType can't open them in parallel, so this keeps the loading off the caller's
+         * thread rather than making it faster.
+         * @param directory The directory to scan. Subdirectories are not searched.
+         * @param point_size The height to open every face at, in points.
+         * @param style A combination of TTF_STYLE_* flags to open every face with.
+         */
+        void preload_directory(const std::string& directory, int point_size, int style);
+        bool is_preloading();
+        void wait_for_preloads();
+
+        /// Waits for background loads to finish, then forgets every face.
+        void clear();
+        std::size_t size();
+        LoadReport load_report();
+
+    private:
+        struct FontKey {
+            std::string path;
+            int         point_size;
+            int         style;
+
+            auto operator<=>(const FontKey& other) const = default;
+        };
+
+        using FontFuture = std::shared_future<FontPtr>;
+
+        /// Registers a promise for a face, unless someone else already did.
+        bool claim(const FontKey& key, std::promise<FontPtr>& promise, FontFuture& future);
+        /// Drops a face's entry once its load has finished without a font, so it can be requested again.
+        void forget_if_failed(const FontKey& key);
+        FontPtr open(const FontKey& key);
+        std::shared_ptr<const MappedFile> map_file(const std::string& path, bool& shared_mapping);
+
+    private:
+        std::mutex                                             m_mutex;
+        std::map<FontKey, FontFuture>                          m_fonts;
+        std::map<std::string, std::weak_ptr<const MappedFile>> m_files;
+        std::vector<std::future<void>>                         m_preloads;
+        std::vector<LoadTiming>                                m_load_timings;
+        double                                                 m_preload_ms;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_FONT_REGISTRY_H
@@ -0,0 +1,104 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /// The offset of the first address at or after base + offset with the given alignment.
+    static std::size_t ALIGNED_OFFSET(const std::byte* base, std::size_t offset, std::size_t alignment) {
+        auto address = reinterpret_cast<std::uintptr_t>(base) + offset;
+        auto aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        return offset + static_cast<std::size_t>(aligned - address);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    FrameArena::FrameArena(std::size_t capacity) : m_offset(0), m_used_before(0) {
+        capacity = std::max<std::size_t>(capacity, 64);
+        m_blocks.push_back({std::unique_ptr<std::byte[]>(new std::byte[capacity]), capacity});
+        m_stats.capacity = capacity;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void* FrameArena::allocate(std::size_t bytes, std::size_t alignment) {
+        Block*      block = &m_blocks.back();
+        std::size_t start = ALIGNED_OFFSET(block->memory.get(), m_offset, alignment);
+        if (start + bytes > block->size) {
+            add_block(bytes + alignment);
+            block = &m_blocks.back();
+            start = ALIGNED_OFFSET(block->memory.get(), 0, alignment);
+        }
+
+        m_offset     = start + bytes;
+        m_stats.used = m_used_before + m_offset;
+        m_stats.peak = std::max(m_stats.peak, m_stats.used);
+        return block->memory.get() + start;
+    }
+
+    const char* FrameArena::format(const char* format, ...) {
+        std::va_list args;
+        va_start(args, format);
+        std::va_list measure_args;
+        va_copy(measure_args, args);
+        int length = std::vsnprintf(nullptr, 0, format, measure_args);
+        va_end(measure_args);
+
+        if (length < 0) {
+            va_end(args);
+            return "";
+        }
+        auto* text = allocate_array<char>(static_cast<std::size_t>(length) + 1);
+        std::vsnprintf(text, static_cast<std::size_t>(length) + 1, format, args);
+        va_end(args);
+        return text;
+    }
+
+    void FrameArena::reset() {
+        // Last frame spilled onto the heap. Make one block that would have held all of it, so the same work
+        // next frame fits without spilling.
+        if (m_blocks.size() > 1) {
+            std::size_t total = 0;
+            for (const Block& block : m_blocks) { total += block.size; }
+            m_blocks.clear();
+            m_blocks.push_back({std::unique_ptr<std::byte[]>(new std::byte[total]), total});
+            m_stats.capacity = total;
+        }
+        m_offset      = 0;
+        m_used_before = 0;
+        m_stats.used  = 0;
+    }
+
+    FrameArena::Stats FrameArena::stats() const { return m_stats; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void FrameArena::add_block(std::size_t minimum_bytes) {
+        m_used_before += m_offset;
+        std::size_t size = std::max(minimum_bytes, m_blocks.back().size);
+        m_blocks.push_back({std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+        m_offset = 0;
+        m_stats.overflow_blocks++;
+    }
+
+} // Core
@@ -0,0 +1,133 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_FRAME_ARENA_H
+#define GOLD_CARTRIDGE_FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Logger.h"
+
+namespace Core {
+
+    /**
+     * @brief Hands out memory for data that only lives until the end of the frame.
+     *
+     * Allocating moves a pointer forward through one large block, and reset()
+     * moves it back to the start, so neither touches the heap. Nothing is freed
+     * individually and no destructors run, so only trivially destructible data
+     * belongs here: vertices, event lists, formatted strings and the like.
+     *
+     * A frame that needs more than the block holds gets extra blocks from the
+     * heap. On the next reset they are merged into a single block big enough
+     * for that frame, so a steady workload stops allocating after its first
+     * few frames. Window resets its arena at the start of every frame. It may
+     * only be used from one thread at a time.
+     */
+    class FrameArena {
+    public:
+        struct Stats {
+            std::size_t   used            = 0; ///< Bytes handed out since the last reset, including alignment.
+            std::size_t   peak            = 0; ///< Most bytes used in any one frame.
+            std::size_t   capacity        = 0; ///< Bytes available before the heap is needed.
+            std::uint64_t overflow_blocks = 0; ///< Extra blocks taken from the heap because a frame ran out.
+        };
+
+    public:
+        explicit FrameArena(std::size_t capacity = 1024 * 1024);
+
+        FrameArena(const FrameArena&) = delete;
+        void operator=(const FrameArena&) = delete;
+
+        /**
+         * Reserves memory until the next reset.
+         * @param bytes The size of the memory.
+         * @param alignment The memory's alignment. Must be a power of two.
+         * @return The memory. Never null.
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+        /// Reserves uninitialized space for an array.
+        template <typename T>
+        T* allocate_array(std::size_t count) {
+            return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /// Constructs an object in the arena. Its destructor will never run.
+        template <typename T, typename... Args>
+        T* make(Args&&... args) {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed.");
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /// Formats a printf-style string into the arena. The string stays valid until the next reset.
+        const char* format(const char* format, ...) GOLD_CARTRIDGE_PRINTF_FORMAT(2, 3);
+
+        /// Makes all the memory available again. Everything allocated since the last reset is invalid.
+        void reset();
+
+        Stats stats() const;
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> memory;
+            std::size_t                  size;
+        };
+
+        void add_block(std::size_t minimum_bytes);
+
+    private:
+        std::vector<Block> m_blocks;
+        std::size_t        m_offset;       ///< Next free byte in the last block.
+        std::size_t        m_used_before;  ///< Bytes used in the blocks before the last one.
+        Stats              m_stats;
+    };
+
+    /**
+     * @brief Lets standard containers allocate from a FrameArena.
+     *
+     * Deallocating does nothing; the memory comes back when the arena is reset.
+     * Containers using it must be gone, or at least never touched again, by
+     * then.
+     */
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+        T* allocate(std::size_t count) { return m_arena->allocate_array<T>(count); }
+        void deallocate(T*, std::size_t) noexcept {}
+
+        FrameArena* arena() const noexcept { return m_arena; }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_arena == other.arena(); }
+
+    private:
+        FrameArena* m_arena;
+    };
+
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_FRAME_ARENA_H
@@ -0,0 +1,336 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "GlyphAtlas.h"
+#include "PixelOps.h"
+#include "TexturePixels.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        const int       ATLAS_WIDTH          = 512;
+        const int       ATLAS_INITIAL_HEIGHT = 128;
+        const int       ATLAS_MAX_HEIGHT     = 2048;
+        const int       GLYPH_PADDING        = 1; // Keeps texture filtering from bleeding between glyphs.
+        const SDL_Color GLYPH_COLOR{255, 255, 255, 255};
+        const char32_t  REPLACEMENT_CHARACTER = 0xFFFD;
+    }
+
+    static std::shared_ptr<SDL_Surface> MAKE_PIXELS(int width, int height) {
+        return {SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888), SDL_FreeSurface};
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /// Decodes the UTF-8 code point starting at text[pos] and moves pos past it.
+    static std::uint32_t NEXT_CODEPOINT(std::string_view text, std::size_t& pos) {
+        auto lead = static_cast<unsigned char>(text[pos++]);
+        if (lead < 0x80) { return lead; }
+
+        int           trailing_bytes;
+        std::uint32_t codepoint;
+        if ((lead & 0xE0) == 0xC0) { trailing_bytes = 1; codepoint = lead & 0x1F; }
+        else if ((lead & 0xF0) == 0xE0) { trailing_bytes = 2; codepoint = lead & 0x0F; }
+        else if ((lead & 0xF8) == 0xF0) { trailing_bytes = 3; codepoint = lead & 0x07; }
+        else { return REPLACEMENT_CHARACTER; }
+
+        for (int i = 0; i < trailing_bytes; i++) {
+            if (pos >= text.size() || (static_cast<unsigned char>(text[pos]) & 0xC0) != 0x80) {
+                return REPLACEMENT_CHARACTER;
+            }
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[pos++]) & 0x3F);
+        }
+        return codepoint;
+    }
+
+    /**
+     * Copies a whole surface into the ARGB8888 atlas pixels at (x, y), alpha included, with PixelOps'
+     * row kernels, which convert 32 bit formats as they go.
+     * @return False, copying nothing, if src's format has no kernel or it has a colorkey.
+     */
+    static bool COPY_INTO_ATLAS(const SDL_Surface* src, SDL_Surface* atlas, int x, int y) {
+        if (SDL_MUSTLOCK(src) || SDL_HasColorKey(const_cast<SDL_Surface*>(src))) { return false; }
+        const auto* src_row = static_cast<const std::uint8_t*>(src->pixels);
+        auto*       dst_row = static_cast<std::uint8_t*>(atlas->pixels) +
+                              static_cast<std::ptrdiff_t>(y) * atlas->pitch + x * sizeof(std::uint32_t);
+        for (int row = 0; row < src->h; row++, src_row += src->pitch, dst_row += atlas->pitch) {
+            if (!PixelOps::to_argb8888(reinterpret_cast<const std::uint32_t*>(src_row),
+                                       reinterpret_cast<std::uint32_t*>(dst_row),
+                                       static_cast<std::size_t>(src->w), src->format->format)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Appends one textured quad, cut down to the clip area if one is given.
+    static void APPEND_QUAD(SDL_Rect dest, SDL_Rect source, const SDL_Point& atlas_size, const SDL_Color& color,
+                            const SDL_Rect* clip, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) {
+        if (clip) {
+            SDL_Rect visible;
+            if (!SDL_IntersectRect(&dest, clip, &visible)) { return; }
+
+            // Glyphs are drawn unscaled, so the source shrinks by exactly as many pixels as the destination.
+            source.x += visible.x - dest.x;
+            source.y += visible.y - dest.y;
+            source.w = visible.w;
+            source.h = visible.h;
+            dest     = visible;
+        }
+
+        const float left   = static_cast<float>(dest.x);
+        const float top    = static_cast<float>(dest.y);
+        const float right  = static_cast<float>(dest.x + dest.w);
+        const float bottom = static_cast<float>(dest.y + dest.h);
+        const float u0     = static_cast<float>(source.x) / static_cast<float>(atlas_size.x);
+        const float v0     = static_cast<float>(source.y) / static_cast<float>(atlas_size.y);
+        const float u1     = static_cast<float>(source.x + source.w) / static_cast<float>(atlas_size.x);
+        const float v1     = static_cast<float>(source.y + source.h) / static_cast<float>(atlas_size.y);
+
+        const int first = static_cast<int>(vertices.size());
+        vertices.push_back({{left, top}, color, {u0, v0}});
+        vertices.push_back({{right, top}, color, {u1, v0}});
+        vertices.push_back({{right, bottom}, color, {u1, v1}});
+        vertices.push_back({{left, bottom}, color, {u0, v1}});
+        indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, std::shared_ptr<TTF_Font> font)
+            : m_renderer(renderer),
+              m_font(font),
+              m_font_handle(font.get()),
+              m_font_style(TTF_GetFontStyle(font.get())),
+              m_font_height(TTF_FontHeight(font.get())),
+              m_pixels(MAKE_PIXELS(ATLAS_WIDTH, ATLAS_INITIAL_HEIGHT)),
+              m_texture(nullptr),
+              m_dirty_area{0, 0, 0, 0},
+              m_texture_is_stale(true),
+              m_shelf_x(0),
+              m_shelf_y(0),
+              m_shelf_height(0) {}
+
+    GlyphAtlas::~GlyphAtlas() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool GlyphAtlas::matches(const std::shared_ptr<TTF_Font>& font) const {
+        return !m_font.expired() &&
+               font.get() == m_font_handle &&
+               TTF_GetFontStyle(font.get()) == m_font_style;
+    }
+
+    bool GlyphAtlas::layout(std::string_view text, const SDL_Color& color, int x, int y, const SDL_Rect* clip,
+                            std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) {
+        if (!m_pixels) { return false; }
+
+        // Make every glyph of the string resident before emitting any quads. If
+        // the atlas had to be cleared part way through, the glyphs added before
+        // that are gone again, so take one more pass to put them back.
+        for (int attempt = 0; attempt < 2; attempt++) {
+            const std::uint64_t evictions_before = m_stats.evictions;
+            for (std::size_t pos = 0; pos < text.size();) {
+                std::uint32_t codepoint = NEXT_CODEPOINT(text, pos);
+                if (m_glyphs.count(codepoint)) {
+                    m_stats.hits++;
+                } else {
+                    m_stats.misses++;
+                    find_or_add(codepoint);
+                }
+            }
+            if (m_stats.evictions == evictions_before) { break; }
+        }
+
+        if (!upload()) { return false; }
+
+        const SDL_Point atlas_size{m_pixels->w, m_pixels->h};
+        std::uint32_t   previous = 0;
+        int             pen_x    = x;
+        for (std::size_t pos = 0; pos < text.size();) {
+            std::uint32_t codepoint = NEXT_CODEPOINT(text, pos);
+            auto          found     = m_glyphs.find(codepoint);
+            if (found == m_glyphs.end()) { continue; } // Too large for the atlas, or missing from the font.
+
+            if (previous) { pen_x += TTF_GetFontKerningSizeGlyphs32(m_font_handle, previous, codepoint); }
+            const Glyph& glyph = found->second;
+            if (glyph.source.w > 0) {
+                SDL_Rect dest{pen_x + glyph.x_offset, y, glyph.source.w, glyph.source.h};
+                APPEND_QUAD(dest, glyph.source, atlas_size, color, clip, vertices, indices);
+            }
+            pen_x += glyph.advance;
+            previous = codepoint;
+        }
+        return true;
+    }
+
+    SDL_Point GlyphAtlas::measure(std::string_view text) {
+        std::uint32_t previous = 0;
+        int           width    = 0;
+        for (std::size_t pos = 0; pos < text.size();) {
+            std::uint32_t codepoint = NEXT_CODEPOINT(text, pos);
+            const Glyph*  glyph     = find_or_add(codepoint);
+            if (!glyph) { continue; }
+
+            if (previous) { width += TTF_GetFontKerningSizeGlyphs32(m_font_handle, previous, codepoint); }
+            width += glyph->advance;
+            previous = codepoint;
+        }
+        return {width, m_font_height};
+    }
+
+    const std::shared_ptr<SDL_Texture>& GlyphAtlas::texture() const { return m_texture; }
+
+    const std::shared_ptr<SDL_Surface>& GlyphAtlas::pixels() const { return m_pixels; }
+
+    const GlyphAtlas::Stats& GlyphAtlas::stats() const { return m_stats; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    const GlyphAtlas::Glyph* GlyphAtlas::find_or_add(std::uint32_t codepoint) {
+        auto found = m_glyphs.find(codepoint);
+        if (found != m_glyphs.end()) { return &found->second; }
+
+        int min_x, max_x, min_y, max_y, advance;
+        if (TTF_GlyphMetrics32(m_font_handle, codepoint, &min_x, &max_x, &min_y, &max_y, &advance) != 0) {
+            return nullptr;
+        }
+
+        // SDL_ttf places a lone glyph's image at its left bearing, or at zero if the bearing is positive.
+        Glyph glyph{{0, 0, 0, 0}, std::min(0, min_x), advance};
+
+        // Whitespace has no ink, so it only needs its metrics.
+        if (max_x > min_x && max_y > min_y) {
+            SDL_Surface* image = TTF_RenderGlyph32_Blended(m_font_handle, codepoint, GLYPH_COLOR);
+            if (!image) { return nullptr; }
+
+            SDL_Rect area;
+            if (!reserve(image->w, image->h, area)) {
+                SDL_FreeSurface(image);
+                return nullptr;
+            }
+
+            // Copy the glyph's alpha as-is rather than blending it over the empty atlas. SDL_ttf renders
+            // blended glyphs as ARGB8888, so this is normally a straight copy, and SDL only blits anything else.
+            if (!COPY_INTO_ATLAS(image, m_pixels.get(), area.x, area.y)) {
+                SDL_Rect blit_area = area;
+                SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(image, nullptr, m_pixels.get(), &blit_area);
+            }
+            SDL_FreeSurface(image);
+
+            if (SDL_RectEmpty(&m_dirty_area)) { m_dirty_area = area; }
+            else { SDL_UnionRect(&m_dirty_area, &area, &m_dirty_area); }
+            glyph.source = area;
+        }
+
+        m_stats.glyphs++;
+        return &m_glyphs.emplace(codepoint, glyph).first->second;
+    }
+
+    bool GlyphAtlas::reserve(int w, int h, SDL_Rect& area) {
+        const int padded_w = w + GLYPH_PADDING;
+        const int padded_h = h + GLYPH_PADDING;
+        if (padded_w > m_pixels->w || padded_h > ATLAS_MAX_HEIGHT) { return false; }
+
+        bool evicted = false;
+        while (true) {
+            if (m_shelf_x + padded_w > m_pixels->w) {
+                m_shelf_y += m_shelf_height;
+                m_shelf_x      = 0;
+                m_shelf_height = 0;
+            }
+
+            if (m_shelf_y + padded_h <= m_pixels->h) {
+                area = {m_shelf_x, m_shelf_y, w, h};
+                m_shelf_x += padded_w;
+                m_shelf_height = std::max(m_shelf_height, padded_h);
+                return true;
+            }
+
+            if (!grow()) {
+                if (evicted) { return false; }
+                evict();
+                evicted = true;
+            }
+        }
+    }
+
+    bool GlyphAtlas::grow() {
+        if (m_pixels->h >= ATLAS_MAX_HEIGHT) { return false; }
+
+        std::shared_ptr<SDL_Surface> larger = MAKE_PIXELS(m_pixels->w, std::min(m_pixels->h * 2, ATLAS_MAX_HEIGHT));
+        if (!larger) { return false; }
+
+        COPY_INTO_ATLAS(m_pixels.get(), larger.get(), 0, 0);
+        m_pixels = std::move(larger);
+
+        // The texture is recreated at the new size and fully uploaded on the next layout.
+        m_texture_is_stale = true;
+        m_stats.growths++;
+        m_stats.bytes = static_cast<std::size_t>(m_pixels->pitch) * m_pixels->h;
+        return true;
+    }
+
+    void GlyphAtlas::evict() {
+        m_glyphs.clear();
+        m_shelf_x      = 0;
+        m_shelf_y      = 0;
+        m_shelf_height = 0;
+
+        // Start over on fresh pixels and a fresh texture, since quads that are
+        // queued but not drawn yet may still be pointing at the old glyphs.
+        if (std::shared_ptr<SDL_Surface> cleared = MAKE_PIXELS(m_pixels->w, m_pixels->h)) {
+            m_pixels = std::move(cleared);
+        } else {
+            SDL_FillRect(m_pixels.get(), nullptr, 0);
+        }
+        m_texture_is_stale = true;
+        m_stats.glyphs     = 0;
+        m_stats.evictions++;
+    }
+
+    bool GlyphAtlas::upload() {
+        if (m_texture_is_stale) {
+            SDL_Texture* texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                                     m_pixels->w, m_pixels->h);
+            if (!texture) { return false; }
+
+            // The pixels stay attached to the texture they were made for, even once the atlas has moved on.
+            m_texture = TexturePixels::access().adopt(texture, m_pixels);
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            m_dirty_area       = {0, 0, m_pixels->w, m_pixels->h};
+            m_texture_is_stale = false;
+            m_stats.bytes      = static_cast<std::size_t>(m_pixels->pitch) * m_pixels->h;
+        }
+
+        if (!SDL_RectEmpty(&m_dirty_area)) {
+            const auto* first_pixel = static_cast<const Uint8*>(m_pixels->pixels) +
+                                      m_dirty_area.y * m_pixels->pitch + m_dirty_area.x * 4;
+            if (SDL_UpdateTexture(m_texture.get(), &m_dirty_area, first_pixel, m_pixels->pitch) != 0) { return false; }
+            m_dirty_area = {0, 0, 0, 0};
+        }
+        return true;
+    }
+
+} // Core
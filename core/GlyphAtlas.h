@@ -0,0 +1,123 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_GLYPH_ATLAS_H
+#define GOLD_CARTRIDGE_GLYPH_ATLAS_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_render.h>
+#include <SDL_ttf.h>
+
+namespace Core {
+
+    /**
+     * @brief A texture holding every glyph of one font face (font, size, and style) drawn so far.
+     *
+     * Glyphs are rasterized in white the first time they are needed and packed
+     * into rows ("shelves") of a single texture. Strings are then drawn as one
+     * batch of textured quads, tinted through the vertex colors. When the atlas
+     * fills up it grows, and once it reaches its maximum size it is cleared and
+     * refilled with whatever glyphs are requested next.
+     */
+    class GlyphAtlas {
+    public:
+        struct Stats {
+            std::uint64_t hits      = 0; ///< Glyph lookups satisfied by the atlas.
+            std::uint64_t misses    = 0; ///< Glyph lookups that needed rasterizing.
+            std::uint64_t evictions = 0; ///< Times the atlas was full and had to be cleared.
+            std::uint64_t growths   = 0; ///< Times the atlas texture was enlarged.
+            std::size_t   glyphs    = 0; ///< Glyphs currently stored.
+            std::size_t   bytes     = 0; ///< Size of the atlas pixel data.
+        };
+
+    public:
+        GlyphAtlas(SDL_Renderer* renderer, std::shared_ptr<TTF_Font> font);
+        ~GlyphAtlas();
+
+        GlyphAtlas(const GlyphAtlas&) = delete;
+        void operator=(const GlyphAtlas&) = delete;
+
+        /**
+         * Checks whether the atlas was built for this font handle in its current style.
+         * @param font The font being drawn with.
+         * @return False if the font was closed, or its style changed, since the atlas was made.
+         */
+        bool matches(const std::shared_ptr<TTF_Font>& font) const;
+
+        /**
+         * Appends the quads needed to draw a line of UTF-8 text to a vertex and index list.
+         * @param text The text to draw.
+         * @param color The color to tint the glyphs with.
+         * @param x The x-coordinate of the text's top-left corner, in pixels.
+         * @param y The y-coordinate of the text's top-left corner, in pixels.
+         * @param clip An optional area that glyphs are cut to, in pixels.
+         * @param vertices Receives four vertices per visible glyph.
+         * @param indices Receives six indices per visible glyph.
+         * @return False if the atlas texture could not be created or updated.
+         */
+        bool layout(std::string_view text, const SDL_Color& color, int x, int y, const SDL_Rect* clip,
+                    std::vector<SDL_Vertex>& vertices, std::vector<int>& indices);
+
+        /**
+         * Measures a line of UTF-8 text as layout() would place it.
+         * @param text The text to measure.
+         * @return The width and height of the text, in pixels.
+         */
+        SDL_Point measure(std::string_view text);
+
+        /**
+         * The atlas texture. Shared so that quads already handed out stay drawable if the atlas is rebuilt. The
+         * pixels it was made from are attached to it in TexturePixels.
+         */
+        const std::shared_ptr<SDL_Texture>& texture() const;
+
+        /// The ARGB8888 glyph images, as the texture holds them once the next layout() has uploaded them.
+        const std::shared_ptr<SDL_Surface>& pixels() const;
+        const Stats& stats() const;
+
+    private:
+        struct Glyph {
+            SDL_Rect source;   ///< Area of the atlas holding the glyph. Empty for blank glyphs.
+            int      x_offset; ///< Offset from the pen position to the left edge of the glyph image.
+            int      advance;  ///< Distance to move the pen after the glyph.
+        };
+
+        const Glyph* find_or_add(std::uint32_t codepoint);
+        bool reserve(int w, int h, SDL_Rect& area);
+        bool grow();
+        void evict();
+        bool upload();
+
+    private:
+        SDL_Renderer*           m_renderer;
+        std::weak_ptr<TTF_Font> m_font;
+        TTF_Font*               m_font_handle;
+        int                     m_font_style;
+        int                     m_font_height;
+
+        std::shared_ptr<SDL_Surface> m_pixels; ///< Shared with the textures made from it.
+        std::shared_ptr<SDL_Texture> m_texture;
+        SDL_Rect                     m_dirty_area;
+        bool                         m_texture_is_stale;
+
+        int m_shelf_x;
+        int m_shelf_y;
+        int m_shelf_height;
+
+        std::unordered_map<std::uint32_t, Glyph> m_glyphs;
+        Stats                                    m_stats;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_GLYPH_ATLAS_H
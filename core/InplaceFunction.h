@@ -0,0 +1,160 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_INPLACE_FUNCTION_H
+#define GOLD_CARTRIDGE_INPLACE_FUNCTION_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Core {
+
+    template <typename Signature, std::size_t Capacity = 64>
+    class InplaceFunction;
+
+    /**
+     * @brief A std::function that keeps its callable inside itself, so it never allocates.
+     *
+     * Callbacks that run every frame pay for std::function twice: a call
+     * through its type-erased wrapper, and a heap allocation whenever a
+     * lambda captures more than a couple of pointers. InplaceFunction stores
+     * the callable in a fixed buffer of Capacity bytes and calls it through a
+     * single function pointer. A callable that doesn't fit is a compile error
+     * rather than a hidden allocation; capture large state by reference or
+     * through a pointer instead.
+     *
+     * Callables that are trivially copyable, which covers most lambdas that
+     * capture only references, pointers and numbers, are copied and moved
+     * with a plain memcpy.
+     */
+    template <typename Result, typename... Args, std::size_t Capacity>
+    class InplaceFunction<Result(Args...), Capacity> {
+    public:
+        InplaceFunction() noexcept : m_invoke(nullptr), m_manage(nullptr) {}
+        InplaceFunction(std::nullptr_t) noexcept : InplaceFunction() {}
+
+        template <typename Callable,
+                  typename Stored = std::decay_t<Callable>,
+                  typename = std::enable_if_t<!std::is_same_v<Stored, InplaceFunction> &&
+                                              std::is_invocable_r_v<Result, Stored&, Args...>>>
+        InplaceFunction(Callable&& callable) : InplaceFunction() {
+            static_assert(sizeof(Stored) <= Capacity,
+                          "Callable is too big to store in place. Capture by reference or through a pointer.");
+            static_assert(alignof(Stored) <= alignof(std::max_align_t), "Callable is over-aligned.");
+            static_assert(std::is_nothrow_move_constructible_v<Stored>, "Callable must not throw when moved.");
+            static_assert(std::is_copy_constructible_v<Stored>, "Callable must be copyable.");
+
+            if (IS_EMPTY(callable)) { return; }
+            ::new (static_cast<void*>(m_storage)) Stored(std::forward<Callable>(callable));
+            m_invoke = &INVOKE<Stored>;
+            if constexpr (!std::is_trivially_copyable_v<Stored>) { m_manage = &MANAGE<Stored>; }
+        }
+
+        InplaceFunction(const InplaceFunction& other) : m_invoke(other.m_invoke), m_manage(other.m_manage) {
+            if (m_manage) { m_manage(Operation::Copy, m_storage, other.m_storage); }
+            else if (m_invoke) { std::memcpy(m_storage, other.m_storage, Capacity); }
+        }
+
+        InplaceFunction(InplaceFunction&& other) noexcept : m_invoke(other.m_invoke), m_manage(other.m_manage) {
+            if (m_manage) { m_manage(Operation::Move, m_storage, other.m_storage); }
+            else if (m_invoke) { std::memcpy(m_storage, other.m_storage, Capacity); }
+        }
+
+        ~InplaceFunction() { reset(); }
+
+        InplaceFunction& operator=(const InplaceFunction& other) {
+            if (this != &other) {
+                InplaceFunction copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+            if (this != &other) {
+                reset();
+                m_invoke = other.m_invoke;
+                m_manage = other.m_manage;
+                if (m_manage) { m_manage(Operation::Move, m_storage, other.m_storage); }
+                else if (m_invoke) { std::memcpy(m_storage, other.m_storage, Capacity); }
+            }
+            return *this;
+        }
+
+        InplaceFunction& operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        /// Calls the stored callable. Calling an empty InplaceFunction is a bug.
+        Result operator()(Args... args) const {
+            assert(m_invoke && "Called an empty InplaceFunction.");
+            return m_invoke(m_storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept { return m_invoke != nullptr; }
+
+    private:
+        enum class Operation { Copy, Move, Destroy };
+
+        using Invoker = Result (*)(void* storage, Args&&... args);
+        using Manager = void (*)(Operation operation, void* destination, void* source);
+
+        template <typename Stored>
+        static Result INVOKE(void* storage, Args&&... args) {
+            return std::invoke(*static_cast<Stored*>(storage), std::forward<Args>(args)...);
+        }
+
+        template <typename Stored>
+        static void MANAGE(Operation operation, void* destination, void* source) {
+            switch (operation) {
+                case Operation::Copy:
+                    ::new (destination) Stored(*static_cast<const Stored*>(source));
+                    break;
+                case Operation::Move:
+                    ::new (destination) Stored(std::move(*static_cast<Stored*>(source)));
+                    break;
+                case Operation::Destroy:
+                    static_cast<Stored*>(destination)->~Stored();
+                    break;
+            }
+        }
+
+        /// Null function pointers and empty std::functions make an empty InplaceFunction, as they do a std::function.
+        template <typename Callable>
+        static bool IS_EMPTY(const Callable& callable) {
+            using Stored = std::decay_t<Callable>;
+            if constexpr (std::is_pointer_v<Stored> || std::is_member_pointer_v<Stored>) {
+                return callable == nullptr;
+            } else if constexpr (std::is_same_v<Stored, std::function<Result(Args...)>>) {
+                return !callable;
+            } else {
+                return false;
+            }
+        }
+
+        void reset() noexcept {
+            if (m_manage) { m_manage(Operation::Destroy, m_storage, nullptr); }
+            m_invoke = nullptr;
+            m_manage = nullptr;
+        }
+
+    private:
+        alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+        Invoker                                         m_invoke;
+        Manager                                         m_manage; ///< Null when the callable is trivially copyable.
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_INPLACE_FUNCTION_H
@@ -0,0 +1,249 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "JobSystem.h"
+
+#include <cassert>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    static std::atomic<bool> JOB_SYSTEM_IS_RUNNING{false};
+
+    /// The index of the worker running on this thread, or -1 on threads outside the pool.
+    static thread_local int CURRENT_WORKER = -1;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    JobSystem::Counter::Counter() : m_pending(0) {}
+
+    JobSystem::Counter::~Counter() {
+        // The last job to finish may still be releasing the lock after the count reached zero.
+        std::lock_guard<std::mutex> lock(m_continuation_mutex);
+        assert(m_pending.load() == 0 && "A job counter was destroyed while jobs it tracks were still running.");
+    }
+
+    JobSystem::JobSystem()
+            : m_worker_count(0),
+              m_next_worker(0),
+              m_queued_tasks(0),
+              m_is_stopping(false),
+              m_stats_epoch(Clock::now()) {}
+
+    JobSystem::~JobSystem() { shut_down(); }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Counter Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool JobSystem::Counter::is_done() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+    int JobSystem::Counter::pending() const { return m_pending.load(std::memory_order_acquire); }
+
+    void JobSystem::Counter::add() { m_pending.fetch_add(1, std::memory_order_relaxed); }
+
+    void JobSystem::Counter::finish() {
+        std::vector<Continuation> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_continuation_mutex);
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) { ready.swap(m_continuations); }
+        }
+        for (Continuation& continuation : ready) {
+            JobSystem::access().schedule({std::move(continuation.job), continuation.counter});
+        }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    JobSystem& JobSystem::access() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    bool JobSystem::is_initialized() { return JOB_SYSTEM_IS_RUNNING.load(); }
+
+    bool JobSystem::start_up(int worker_count) {
+        if (is_initialized()) { return false; }
+
+        if (worker_count <= 0) {
+            worker_count = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+        }
+        m_worker_count = worker_count;
+        m_workers      = std::make_unique<Worker[]>(static_cast<std::size_t>(m_worker_count));
+        m_is_stopping  = false;
+        reset_stats();
+
+        m_threads.reserve(static_cast<std::size_t>(m_worker_count));
+        for (int i = 0; i < m_worker_count; i++) { m_threads.emplace_back(&JobSystem::worker_loop, this, i); }
+
+        JOB_SYSTEM_IS_RUNNING = true;
+        return true;
+    }
+
+    void JobSystem::shut_down() {
+        if (!is_initialized()) { return; }
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_is_stopping = true;
+        }
+        m_wake_workers.notify_all();
+        for (std::thread& thread : m_threads) { thread.join(); }
+
+        m_threads.clear();
+        m_workers.reset();
+        m_worker_count        = 0;
+        JOB_SYSTEM_IS_RUNNING = false;
+    }
+
+    int JobSystem::worker_count() const { return m_worker_count; }
+
+    void JobSystem::run(Job job, Counter* counter) {
+        if (counter) { counter->add(); }
+        schedule({std::move(job), counter});
+    }
+
+    void JobSystem::run_after(Counter& dependency, Job job, Counter* counter) {
+        if (counter) { counter->add(); }
+
+        {
+            std::lock_guard<std::mutex> lock(dependency.m_continuation_mutex);
+            if (!dependency.is_done()) {
+                dependency.m_continuations.push_back({std::move(job), counter});
+                return;
+            }
+        }
+        schedule({std::move(job), counter});
+    }
+
+    void JobSystem::wait(const Counter& counter) {
+        while (!counter.is_done()) {
+            Task task;
+            if (take_task(CURRENT_WORKER, task)) { execute(CURRENT_WORKER, task); }
+            else { std::this_thread::yield(); }
+        }
+    }
+
+    std::vector<JobSystem::WorkerStats> JobSystem::worker_stats() const {
+        std::vector<WorkerStats> stats(static_cast<std::size_t>(m_worker_count));
+        double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - m_stats_epoch).count();
+        for (int i = 0; i < m_worker_count; i++) {
+            WorkerStats& worker = stats[static_cast<std::size_t>(i)];
+            worker.jobs_run    = m_workers[i].jobs_run.load(std::memory_order_relaxed);
+            worker.jobs_stolen = m_workers[i].jobs_stolen.load(std::memory_order_relaxed);
+            worker.busy_ms     = static_cast<double>(m_workers[i].busy_ns.load(std::memory_order_relaxed)) / 1.0e6;
+            worker.utilization = elapsed_ms > 0.0 ? std::min(worker.busy_ms / elapsed_ms, 1.0) : 0.0;
+        }
+        return stats;
+    }
+
+    void JobSystem::reset_stats() {
+        for (int i = 0; i < m_worker_count; i++) {
+            m_workers[i].jobs_run    = 0;
+            m_workers[i].jobs_stolen = 0;
+            m_workers[i].busy_ns     = 0;
+        }
+        m_stats_epoch = Clock::now();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void JobSystem::schedule(Task task) {
+        if (m_worker_count == 0) { execute(CURRENT_WORKER, task); }
+        else { enqueue(std::move(task)); }
+    }
+
+    void JobSystem::enqueue(Task task) {
+        // Jobs queued by a worker stay with it, so a job and the jobs it spawns tend to share a cache.
+        int target = CURRENT_WORKER >= 0
+                     ? CURRENT_WORKER
+                     : static_cast<int>(m_next_worker.fetch_add(1, std::memory_order_relaxed) %
+                                        static_cast<unsigned>(m_worker_count));
+        {
+            std::lock_guard<std::mutex> lock(m_workers[target].queue_mutex);
+            m_workers[target].queue.push_back(std::move(task));
+            m_queued_tasks.fetch_add(1, std::memory_order_release);
+        }
+
+        // Taking the sleep lock, even briefly, means a worker can't miss this between checking for work and
+        // going to sleep.
+        { std::lock_guard<std::mutex> lock(m_sleep_mutex); }
+        m_wake_workers.notify_one();
+    }
+
+    bool JobSystem::take_task(int worker_index, Task& task) {
+        if (m_queued_tasks.load(std::memory_order_acquire) <= 0) { return false; }
+
+        if (worker_index >= 0) {
+            Worker&                     own = m_workers[worker_index];
+            std::lock_guard<std::mutex> lock(own.queue_mutex);
+            if (!own.queue.empty()) {
+                task = std::move(own.queue.back());
+                own.queue.pop_back();
+                m_queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Steal the oldest job from someone else. Old jobs tend to be the big ones that split into more work.
+        int first_victim = worker_index >= 0 ? worker_index + 1 : static_cast<int>(m_next_worker.load());
+        for (int i = 0; i < m_worker_count; i++) {
+            int victim_index = (first_victim + i) % m_worker_count;
+            if (victim_index == worker_index) { continue; }
+
+            Worker&                     victim = m_workers[victim_index];
+            std::lock_guard<std::mutex> lock(victim.queue_mutex);
+            if (!victim.queue.empty()) {
+                task = std::move(victim.queue.front());
+                victim.queue.pop_front();
+                m_queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+                if (worker_index >= 0) { m_workers[worker_index].jobs_stolen.fetch_add(1, std::memory_order_relaxed); }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void JobSystem::execute(int worker_index, Task& task) {
+        Clock::time_point start = Clock::now();
+        task.job();
+        if (worker_index >= 0) {
+            Worker& worker = m_workers[worker_index];
+            worker.busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count(),
+                                     std::memory_order_relaxed);
+            worker.jobs_run.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (task.counter) { task.counter->finish(); }
+    }
+
+    void JobSystem::worker_loop(int worker_index) {
+        CURRENT_WORKER = worker_index;
+        while (true) {
+            Task task;
+            if (take_task(worker_index, task)) {
+                execute(worker_index, task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleep_mutex);
+            m_wake_workers.wait(lock, [this]() { return m_queued_tasks.load() > 0 || m_is_stopping.load(); });
+            if (m_is_stopping && m_queued_tasks.load() <= 0) { break; }
+        }
+        CURRENT_WORKER = -1;
+    }
+
+} // Core
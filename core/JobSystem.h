@@ -0,0 +1,200 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_JOB_SYSTEM_H
+#define GOLD_CARTRIDGE_JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core {
+
+    /**
+     * @brief A pool of worker threads, one per spare core, that share out small jobs between them.
+     *
+     * Every worker has its own queue of jobs. A worker takes its newest job
+     * first, while it's still warm in the cache, and when its queue runs dry it
+     * steals the oldest job from another worker's queue. Jobs queued from
+     * outside the pool, such as from the update callback, are dealt out to the
+     * workers in turn.
+     *
+     * Waiting on a Counter from any thread runs queued jobs while it waits, so
+     * the waiting thread helps instead of sitting idle.
+     */
+    class JobSystem {
+    public:
+        using Job = std::function<void()>;
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Counts jobs that haven't finished yet.
+         *
+         * Pass one to run() to track the job, wait() on it to block until
+         * every tracked job is done, or hand it to run_after() to start a job
+         * once the others are done. It must outlive every job it tracks.
+         */
+        class Counter {
+        public:
+            Counter();
+            ~Counter();
+
+            Counter(const Counter&) = delete;
+            void operator=(const Counter&) = delete;
+
+            bool is_done() const;
+            int pending() const;
+
+        private:
+            friend class JobSystem;
+
+            struct Continuation {
+                Job      job;
+                Counter* counter;
+            };
+
+            void add();
+
+            /// Marks one job finished. The last one to finish starts everything waiting on the counter.
+            void finish();
+
+        private:
+            std::atomic<int>          m_pending;
+            std::mutex                m_continuation_mutex;
+            std::vector<Continuation> m_continuations;
+        };
+
+        struct WorkerStats {
+            std::uint64_t jobs_run    = 0;
+            std::uint64_t jobs_stolen = 0;   ///< Jobs this worker took from another worker's queue.
+            double        busy_ms     = 0.0; ///< Time spent running jobs since the stats were last reset.
+            double        utilization = 0.0; ///< busy_ms as a fraction of the time since the stats were last reset.
+        };
+
+    public:
+        static JobSystem& access();
+        static bool is_initialized();
+
+        /**
+         * Starts the worker threads.
+         * @param worker_count The number of workers, or zero for one less than the number of cores, leaving
+         *                     one for the main thread.
+         * @return False if the job system was already running.
+         */
+        bool start_up(int worker_count = 0);
+
+        /// Finishes every queued job, then stops the workers.
+        void shut_down();
+
+        int worker_count() const;
+
+        /**
+         * Queues a job. Without workers, the job runs right away on the calling thread.
+         * @param job The function to run.
+         * @param counter An optional counter that tracks the job.
+         */
+        void run(Job job, Counter* counter = nullptr);
+
+        /**
+         * Queues a job once every job tracked by another counter has finished.
+         * @param dependency The counter to wait for. If it's already done, the job is queued right away.
+         * @param job The function to run.
+         * @param counter An optional counter that tracks the job, from the moment run_after() is called.
+         */
+        void run_after(Counter& dependency, Job job, Counter* counter = nullptr);
+
+        /// Runs queued jobs on the calling thread until every job tracked by the counter has finished.
+        void wait(const Counter& counter);
+
+        /**
+         * Splits a range of indices into batches and runs the batches across the workers, and returns once
+         * they've all finished. The calling thread runs batches too.
+         * @param count The number of indices, starting from zero.
+         * @param batch_size The number of indices per job. Make it large enough that a batch does a few
+         *                   microseconds of work.
+         * @param body Called as body(begin, end) for each half-open batch of indices, from any thread.
+         */
+        template <typename Body>
+        void parallel_for(std::size_t count, std::size_t batch_size, const Body& body) {
+            if (count == 0) { return; }
+            batch_size = std::max<std::size_t>(batch_size, 1);
+            if (worker_count() == 0 || count <= batch_size) {
+                body(std::size_t{0}, count);
+                return;
+            }
+
+            Counter batches;
+            for (std::size_t begin = batch_size; begin < count; begin += batch_size) {
+                std::size_t end = std::min(begin + batch_size, count);
+                run([&body, begin, end]() { body(begin, end); }, &batches);
+            }
+            body(std::size_t{0}, batch_size);
+            wait(batches);
+        }
+
+        std::vector<WorkerStats> worker_stats() const;
+        void reset_stats();
+
+        JobSystem(const JobSystem&) = delete;
+        void operator=(const JobSystem&) = delete;
+
+    private:
+        struct Task {
+            Job      job;
+            Counter* counter;
+        };
+
+        struct Worker {
+            std::mutex       queue_mutex;
+            std::deque<Task> queue;
+
+            std::atomic<std::uint64_t> jobs_run{0};
+            std::atomic<std::uint64_t> jobs_stolen{0};
+            std::atomic<std::int64_t>  busy_ns{0};
+        };
+
+        JobSystem();
+        ~JobSystem();
+
+        /// Queues a task, or runs it right away when there are no workers.
+        void schedule(Task task);
+        void enqueue(Task task);
+
+        /**
+         * Takes a job from the given worker's own queue, or steals one from another worker.
+         * @param worker_index The worker looking for work, or -1 for a thread outside the pool.
+         */
+        bool take_task(int worker_index, Task& task);
+        void execute(int worker_index, Task& task);
+        void worker_loop(int worker_index);
+
+    private:
+        std::unique_ptr<Worker[]> m_workers;
+        std::vector<std::thread>  m_threads;
+        int                       m_worker_count;
+        std::atomic<unsigned>     m_next_worker;   ///< Where the next job from outside the pool goes.
+        std::atomic<std::int64_t> m_queued_tasks;  ///< Jobs queued but not yet taken, across every worker.
+        std::atomic<bool>         m_is_stopping;
+
+        std::mutex              m_sleep_mutex;
+        std::condition_variable m_wake_workers;
+
+        Clock::time_point m_stats_epoch;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_JOB_SYSTEM_H
@@ -0,0 +1,274 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        const Clock::time_point LOG_EPOCH           = Clock::now();
+        const int               DEFAULT_RATE_LIMIT  = 10;
+        const auto              WRITER_IDLE_WAIT    = std::chrono::milliseconds(10);
+        const char              TRUNCATION_MARKER[] = "...";
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    static const char* LEVEL_NAME(Logger::Level level) {
+        switch (level) {
+            case Logger::Level::Trace: return "TRACE";
+            case Logger::Level::Debug: return "DEBUG";
+            case Logger::Level::Info: return "INFO";
+            case Logger::Level::Warning: return "WARNING";
+            case Logger::Level::Error: return "ERROR";
+            default: return "?";
+        }
+    }
+
+    /// The file name without its directories, since __FILE__ is often a full path.
+    static const char* BASE_NAME(const char* path) {
+        const char* name = path;
+        for (const char* c = path; *c; c++) {
+            if (*c == '/' || *c == '\\') { name = c + 1; }
+        }
+        return name;
+    }
+
+    static std::int64_t NOW_NS() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - LOG_EPOCH).count();
+    }
+
+    /// Appends printf-style text at a position in a buffer, and returns the new end, never past the last byte.
+    static std::size_t APPEND(char* buffer, std::size_t size, std::size_t position, const char* format, ...)
+        GOLD_CARTRIDGE_PRINTF_FORMAT(4, 5);
+
+    static std::size_t APPEND(char* buffer, std::size_t size, std::size_t position, const char* format, ...) {
+        if (position + 1 >= size) { return position; }
+        std::va_list args;
+        va_start(args, format);
+        int written = std::vsnprintf(buffer + position, size - position, format, args);
+        va_end(args);
+        if (written < 0) { return position; }
+        return std::min(position + static_cast<std::size_t>(written), size - 1);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    Logger::Logger()
+            : m_slots(std::make_unique<Slot[]>(SLOT_COUNT)),
+              m_write_index(0),
+              m_read_index(0),
+              m_dropped(0),
+              m_written(0),
+              m_level(Level::Trace),
+              m_rate_limit(DEFAULT_RATE_LIMIT),
+              m_output(stderr),
+              m_owns_output(false),
+              m_is_running(false),
+              m_is_stopping(false) {
+        for (std::size_t i = 0; i < SLOT_COUNT; i++) { m_slots[i].sequence.store(i, std::memory_order_relaxed); }
+    }
+
+    Logger::~Logger() { shut_down(); }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    Logger& Logger::access() {
+        static Logger instance;
+        return instance;
+    }
+
+    bool Logger::start_up(const char* file_path) {
+        if (is_running()) { return false; }
+
+        if (file_path) {
+            std::FILE* file = std::fopen(file_path, "a");
+            if (!file) { return false; }
+            m_output      = file;
+            m_owns_output = true;
+        }
+
+        m_is_stopping = false;
+        m_writer      = std::thread(&Logger::writer_loop, this);
+        m_is_running  = true;
+        return true;
+    }
+
+    void Logger::shut_down() {
+        if (!is_running()) { return; }
+
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_is_stopping = true;
+        }
+        m_wake_writer.notify_one();
+        m_writer.join();
+        m_is_running = false;
+
+        std::lock_guard<std::mutex> lock(m_output_mutex);
+        if (m_owns_output) { std::fclose(m_output); }
+        m_output      = stderr;
+        m_owns_output = false;
+    }
+
+    bool Logger::is_running() const { return m_is_running.load(std::memory_order_acquire); }
+
+    Logger::Level Logger::level() const { return m_level.load(std::memory_order_relaxed); }
+    void Logger::level(Level minimum_level) { m_level.store(minimum_level, std::memory_order_relaxed); }
+
+    int Logger::rate_limit() const { return m_rate_limit.load(std::memory_order_relaxed); }
+    void Logger::rate_limit(int messages_per_second) {
+        m_rate_limit.store(messages_per_second, std::memory_order_relaxed);
+    }
+
+    std::uint64_t Logger::dropped_count() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    void Logger::flush() {
+        if (is_running()) {
+            const std::size_t target = m_write_index.load(std::memory_order_acquire);
+            while (m_written.load(std::memory_order_acquire) < target && is_running()) {
+                m_wake_writer.notify_one();
+                std::this_thread::yield();
+            }
+        }
+        std::lock_guard<std::mutex> lock(m_output_mutex);
+        std::fflush(m_output);
+    }
+
+    void Logger::write(Level level, RateLimit& limit, const char* file, int line, const char* format, ...) {
+        if (level < m_level.load(std::memory_order_relaxed)) { return; }
+
+        // Each call site gets a fresh allowance every second. Racing threads may both start a new window,
+        // which only lets a message or two more through.
+        const int          allowance = m_rate_limit.load(std::memory_order_relaxed);
+        const std::int64_t now_ms    = NOW_NS() / 1000000;
+        std::int64_t       window    = limit.window_start_ms.load(std::memory_order_relaxed);
+        if (now_ms - window >= 1000 &&
+            limit.window_start_ms.compare_exchange_strong(window, now_ms, std::memory_order_relaxed)) {
+            limit.written_in_window.store(0, std::memory_order_relaxed);
+        }
+        if (allowance > 0 && limit.written_in_window.fetch_add(1, std::memory_order_relaxed) >= allowance) {
+            limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const int suppressed = limit.suppressed.exchange(0, std::memory_order_relaxed);
+
+        std::va_list args;
+        va_start(args, format);
+        if (is_running()) {
+            if (!try_push(level, file, line, suppressed, format, args)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            } else if (level >= Level::Error) {
+                // Errors are worth getting out promptly. Everything else waits for the writer's next pass.
+                m_wake_writer.notify_one();
+            }
+        } else {
+            char text[MESSAGE_BYTES];
+            format_message(text, sizeof(text), level, file, line, suppressed, format, args);
+            output(level, NOW_NS(), text);
+        }
+        va_end(args);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    int Logger::format_message(char* buffer, std::size_t size, Level level, const char* file, int line,
+                               int suppressed, const char* format, std::va_list args) const {
+        int length = std::vsnprintf(buffer, size, format, args);
+        if (length < 0) { length = std::snprintf(buffer, size, "(unformattable log message: %s)", format); }
+
+        std::size_t position = std::min(static_cast<std::size_t>(std::max(length, 0)), size - 1);
+        if (static_cast<std::size_t>(length) >= size) {
+            std::memcpy(buffer + size - sizeof(TRUNCATION_MARKER), TRUNCATION_MARKER, sizeof(TRUNCATION_MARKER));
+        }
+        if (suppressed > 0) {
+            position = APPEND(buffer, size, position, " (%d similar message%s suppressed)", suppressed,
+                              suppressed == 1 ? "" : "s");
+        }
+        if (level >= Level::Warning) { position = APPEND(buffer, size, position, " [%s:%d]", BASE_NAME(file), line); }
+        return static_cast<int>(position);
+    }
+
+    bool Logger::try_push(Level level, const char* file, int line, int suppressed, const char* format,
+                          std::va_list args) {
+        // A bounded multi-producer queue: each slot's sequence number says whose turn it is. It equals the
+        // write position when the slot is free to claim, and the position plus one once the message is in.
+        std::size_t position = m_write_index.load(std::memory_order_relaxed);
+        Slot*       slot;
+        while (true) {
+            slot = &m_slots[position & (SLOT_COUNT - 1)];
+            std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            auto        lag      = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (lag == 0) {
+                if (m_write_index.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+            } else if (lag < 0) {
+                return false; // The writer hasn't emptied this slot yet, so the buffer is full.
+            } else {
+                position = m_write_index.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level   = level;
+        slot->time_ns = NOW_NS();
+        format_message(slot->text, sizeof(slot->text), level, file, line, suppressed, format, args);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    void Logger::output(Level level, std::int64_t time_ns, const char* text) {
+        std::lock_guard<std::mutex> lock(m_output_mutex);
+        std::fprintf(m_output, "[%10.3f] %-7s %s\n", static_cast<double>(time_ns) / 1.0e9, LEVEL_NAME(level), text);
+    }
+
+    bool Logger::drain() {
+        bool wrote_any = false;
+        while (true) {
+            Slot& slot = m_slots[m_read_index & (SLOT_COUNT - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != m_read_index + 1) { break; }
+
+            output(slot.level, slot.time_ns, slot.text);
+            slot.sequence.store(m_read_index + SLOT_COUNT, std::memory_order_release);
+            m_read_index++;
+            m_written.store(m_read_index, std::memory_order_release);
+            wrote_any = true;
+        }
+        if (wrote_any) {
+            std::lock_guard<std::mutex> lock(m_output_mutex);
+            std::fflush(m_output);
+        }
+        return wrote_any;
+    }
+
+    void Logger::writer_loop() {
+        while (!m_is_stopping.load(std::memory_order_acquire)) {
+            if (drain()) { continue; }
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+            m_wake_writer.wait_for(lock, WRITER_IDLE_WAIT, [this]() { return m_is_stopping.load(); });
+        }
+        drain();
+    }
+
+} // Core
@@ -0,0 +1,151 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_LOGGER_H
+#define GOLD_CARTRIDGE_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/// Messages below this level are compiled out entirely: 0 trace, 1 debug, 2 info, 3 warning, 4 error.
+#ifndef GOLD_CARTRIDGE_MIN_LOG_LEVEL
+#define GOLD_CARTRIDGE_MIN_LOG_LEVEL 2
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GOLD_CARTRIDGE_PRINTF_FORMAT(format_index, first_arg_index) \
+    __attribute__((format(printf, format_index, first_arg_index)))
+#else
+#define GOLD_CARTRIDGE_PRINTF_FORMAT(format_index, first_arg_index)
+#endif
+
+namespace Core {
+
+    /**
+     * @brief Writes log messages on a background thread, so logging never waits on I/O.
+     *
+     * Messages are formatted with printf-style format strings straight into
+     * fixed-size slots of a lock-free ring buffer, without allocating. A
+     * background thread drains the buffer to stderr or a file. If the buffer
+     * is full, new messages are dropped and counted rather than making the
+     * caller wait. Before start_up() and after shut_down() messages are
+     * written straight away on the calling thread instead.
+     *
+     * Use the LOG_* macros rather than calling write() directly. Each one
+     * limits how often its own line can log, so an error hit every frame
+     * shows up a few times a second with a count of what was left out.
+     */
+    class Logger {
+    public:
+        enum class Level : std::uint8_t { Trace, Debug, Info, Warning, Error };
+
+        /// Tracks how often one logging call site has written. The LOG_* macros keep one per call site.
+        struct RateLimit {
+            std::atomic<std::int64_t> window_start_ms{-1};
+            std::atomic<int>          written_in_window{0};
+            std::atomic<int>          suppressed{0};
+        };
+
+    public:
+        static Logger& access();
+
+        /**
+         * Starts the background writer.
+         * @param file_path A file to append messages to, or null for stderr.
+         * @return False if the logger was already running or the file couldn't be opened.
+         */
+        bool start_up(const char* file_path = nullptr);
+
+        /// Writes every message still in the buffer, then stops the background writer.
+        void shut_down();
+        bool is_running() const;
+
+        /// Messages below this level are skipped at runtime. Levels compiled out can't be turned back on.
+        Level level() const;
+        void level(Level minimum_level);
+
+        /// The most messages one call site may write per second before the rest are counted instead.
+        int rate_limit() const;
+        void rate_limit(int messages_per_second);
+
+        /// Messages lost because the buffer was full.
+        std::uint64_t dropped_count() const;
+
+        /// Blocks until every message logged so far has been written.
+        void flush();
+
+        void write(Level level, RateLimit& limit, const char* file, int line, const char* format, ...)
+            GOLD_CARTRIDGE_PRINTF_FORMAT(6, 7);
+
+        Logger(const Logger&) = delete;
+        void operator=(const Logger&) = delete;
+
+    private:
+        static constexpr std::size_t SLOT_COUNT    = 1024; ///< Must be a power of two.
+        static constexpr std::size_t MESSAGE_BYTES = 240;
+
+        struct alignas(64) Slot {
+            std::atomic<std::size_t> sequence;
+            Level                    level;
+            std::int64_t             time_ns;
+            char                     text[MESSAGE_BYTES];
+        };
+
+        Logger();
+        ~Logger();
+
+        /// Formats the message prefix and text into a buffer, returning its length.
+        int format_message(char* buffer, std::size_t size, Level level, const char* file, int line, int suppressed,
+                           const char* format, std::va_list args) const;
+        bool try_push(Level level, const char* file, int line, int suppressed, const char* format, std::va_list args);
+        void output(Level level, std::int64_t time_ns, const char* text);
+        bool drain();
+        void writer_loop();
+
+    private:
+        std::unique_ptr<Slot[]>    m_slots;
+        std::atomic<std::size_t>   m_write_index;
+        std::size_t                m_read_index; ///< Only touched by the writer thread.
+        std::atomic<std::uint64_t> m_dropped;
+        std::atomic<std::uint64_t> m_written;
+        std::atomic<Level>         m_level;
+        std::atomic<int>           m_rate_limit;
+
+        std::FILE*              m_output;
+        bool                    m_owns_output;
+        std::mutex              m_output_mutex; ///< Keeps direct writes from interleaving with the writer thread.
+        std::atomic<bool>       m_is_running;
+        std::atomic<bool>       m_is_stopping;
+        std::mutex              m_wake_mutex;
+        std::condition_variable m_wake_writer;
+        std::thread             m_writer;
+    };
+
+} // Core
+
+#define GOLD_CARTRIDGE_LOG(level, ...)                                                                          \
+    do {                                                                                                         \
+        if constexpr (static_cast<int>(level) >= GOLD_CARTRIDGE_MIN_LOG_LEVEL) {                                \
+            static Core::Logger::RateLimit gold_cartridge_log_rate_limit;                                        \
+            Core::Logger::access().write(level, gold_cartridge_log_rate_limit, __FILE__, __LINE__, __VA_ARGS__); \
+        }                                                                                                        \
+    } while (false)
+
+#define LOG_TRACE(...)   GOLD_CARTRIDGE_LOG(Core::Logger::Level::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...)   GOLD_CARTRIDGE_LOG(Core::Logger::Level::Debug, __VA_ARGS__)
+#define LOG_INFO(...)    GOLD_CARTRIDGE_LOG(Core::Logger::Level::Info, __VA_ARGS__)
+#define LOG_WARNING(...) GOLD_CARTRIDGE_LOG(Core::Logger::Level::Warning, __VA_ARGS__)
+#define LOG_ERROR(...)   GOLD_CARTRIDGE_LOG(Core::Logger::Level::Error, __VA_ARGS__)
+
+#endif //GOLD_CARTRIDGE_LOGGER_H
@@ -0,0 +1,103 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    MappedFile::MappedFile(std::string path, const void* data, std::size_t size, void* mapping_handle)
+            : m_path(std::move(path)),
+              m_data(data),
+              m_size(size),
+              m_mapping_handle(mapping_handle) {}
+
+#ifdef _WIN32
+
+    std::shared_ptr<const MappedFile> MappedFile::open(const std::string& path) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) { return nullptr; }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        // The mapping keeps the file open on its own, so the file handle can go right away.
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) { return nullptr; }
+
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!data) {
+            CloseHandle(mapping);
+            return nullptr;
+        }
+
+        auto size = static_cast<std::size_t>(file_size.QuadPart);
+        return std::shared_ptr<const MappedFile>(new MappedFile(path, data, size, mapping));
+    }
+
+    MappedFile::~MappedFile() {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping_handle);
+    }
+
+#else
+
+    std::shared_ptr<const MappedFile> MappedFile::open(const std::string& path) {
+        int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0) { return nullptr; }
+
+        struct stat file_info{};
+        if (fstat(file, &file_info) != 0 || file_info.st_size == 0) {
+            close(file);
+            return nullptr;
+        }
+
+        // The mapping holds its own reference to the file, so the descriptor can go right away.
+        auto  size = static_cast<std::size_t>(file_info.st_size);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+        close(file);
+        if (data == MAP_FAILED) { return nullptr; }
+
+        return std::shared_ptr<const MappedFile>(new MappedFile(path, data, size, nullptr));
+    }
+
+    MappedFile::~MappedFile() {
+        munmap(const_cast<void*>(m_data), m_size);
+    }
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    const unsigned char* MappedFile::data() const { return static_cast<const unsigned char*>(m_data); }
+
+    std::size_t MappedFile::size() const { return m_size; }
+
+    const std::string& MappedFile::path() const { return m_path; }
+
+} // Core
@@ -0,0 +1,54 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_MAPPED_FILE_H
+#define GOLD_CARTRIDGE_MAPPED_FILE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace Core {
+
+    /**
+     * @brief A whole file mapped read-only into memory.
+     *
+     * Pages are read from disk on first touch and are backed by the operating
+     * system's file cache, so several users of the same mapping, or several
+     * processes mapping the same file, share one copy of its bytes.
+     */
+    class MappedFile {
+    public:
+        /**
+         * Maps a file into memory.
+         * @param path The file to map.
+         * @return The mapping, or null if the file could not be opened or is empty.
+         */
+        static std::shared_ptr<const MappedFile> open(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        void operator=(const MappedFile&) = delete;
+
+        const unsigned char* data() const;
+        std::size_t size() const;
+        const std::string& path() const;
+
+    private:
+        MappedFile(std::string path, const void* data, std::size_t size, void* mapping_handle);
+
+    private:
+        std::string m_path;
+        const void* m_data;
+        std::size_t m_size;
+        void*       m_mapping_handle; ///< Only used on Windows, where the view and mapping are closed separately.
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_MAPPED_FILE_H
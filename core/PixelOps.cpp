@@ -0,0 +1,337 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "PixelOps.h"
+#include "SimdLanes.h"
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace Core::PixelOps {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        using Lanes = Core::PixelLanes;
+        using Scalar = Core::ScalarPixels;
+
+        /// Steps in the table that gives a first guess at a linear value's sRGB byte.
+        const int LINEAR_STEPS = 4096;
+
+        struct SrgbTables {
+            float        to_linear[256];
+            float        thresholds[256]; ///< The linear value halfway between each sRGB byte and the one below.
+            std::uint8_t guesses[LINEAR_STEPS + 1];
+        };
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Runs a kernel along a row with the widest lanes, then again with ScalarPixels for the pixels left over.
+     * The kernel is called as kernel(tag, begin, count), where tag's type names the lanes to use, and returns
+     * where it stopped.
+     */
+    template <typename Kernel>
+    static void FOR_ROW(std::size_t count, const Kernel& kernel) {
+        std::size_t done = kernel(std::type_identity<Lanes>{}, std::size_t{0}, count);
+        kernel(std::type_identity<Scalar>{}, done, count);
+    }
+
+    /// Applies a per-pixel operation, written once for both lane types, from src to dst.
+    template <typename Operation>
+    static void MAP_ROW(const std::uint32_t* src, std::uint32_t* dst, std::size_t count, const Operation& operation) {
+        FOR_ROW(count, [&](auto tag, std::size_t i, std::size_t end) {
+            using Pixels = typename decltype(tag)::type;
+            for (; i + Pixels::WIDTH <= end; i += Pixels::WIDTH) { operation(Pixels::load(src + i)).store(dst + i); }
+            return i;
+        });
+    }
+
+    template <typename Pixels>
+    static Pixels SWAP_RED_BLUE(Pixels pixels) {
+        return (pixels & Pixels::splat(0xFF00FF00)) |
+               (Pixels::template shift_right<16>(pixels) & Pixels::splat(0x000000FF)) |
+               (Pixels::template shift_left<16>(pixels) & Pixels::splat(0x00FF0000));
+    }
+
+    static double SRGB_TO_LINEAR(double value) {
+        return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+    }
+
+    static const SrgbTables& SRGB_TABLES() {
+        static const SrgbTables tables = []() {
+            SrgbTables built{};
+            for (int i = 0; i < 256; i++) {
+                built.to_linear[i]  = static_cast<float>(SRGB_TO_LINEAR(i / 255.0));
+                built.thresholds[i] = i == 0 ? 0.0f : static_cast<float>(SRGB_TO_LINEAR((i - 0.5) / 255.0));
+            }
+            int byte = 0;
+            for (int step = 0; step <= LINEAR_STEPS; step++) {
+                float value = static_cast<float>(step) / LINEAR_STEPS;
+                while (byte < 255 && value >= built.thresholds[byte + 1]) { byte++; }
+                built.guesses[step] = static_cast<std::uint8_t>(byte);
+            }
+            return built;
+        }();
+        return tables;
+    }
+
+    /**
+     * The sRGB byte nearest a linear value. The table's guess is at most a step or so out, since sRGB is never
+     * steeper than the table is fine, and the thresholds settle it exactly.
+     */
+    static std::uint32_t LINEAR_TO_SRGB_BYTE(const SrgbTables& tables, float value) {
+        if (!(value > 0.0f)) { return 0; }
+        if (value >= 1.0f) { return 255; }
+
+        int byte = tables.guesses[static_cast<int>(value * LINEAR_STEPS)];
+        while (byte < 255 && value >= tables.thresholds[byte + 1]) { byte++; }
+        while (byte > 0 && value < tables.thresholds[byte]) { byte--; }
+        return static_cast<std::uint32_t>(byte);
+    }
+
+    /// Whether to_argb8888() has a kernel for a format.
+    static bool CAN_CONVERT(std::uint32_t format) {
+        return format == SDL_PIXELFORMAT_ARGB8888 || format == SDL_PIXELFORMAT_ABGR8888 ||
+               format == SDL_PIXELFORMAT_RGBA8888 || format == SDL_PIXELFORMAT_BGRA8888 ||
+               format == SDL_PIXELFORMAT_RGB888 || format == SDL_PIXELFORMAT_BGR888;
+    }
+
+    static bool IS_ARGB8888(const SDL_Surface* surface) {
+        return surface && surface->format && surface->format->format == SDL_PIXELFORMAT_ARGB8888;
+    }
+
+    /// Calls row(pixels, width) for each row of a surface, locking it if it has to be.
+    template <typename Row>
+    static void FOR_EACH_ROW(SDL_Surface* surface, const Row& row) {
+        const bool must_lock = SDL_MUSTLOCK(surface);
+        if (must_lock && SDL_LockSurface(surface) != 0) { return; }
+        auto* bytes = static_cast<std::uint8_t*>(surface->pixels);
+        for (int y = 0; y < surface->h; y++, bytes += surface->pitch) {
+            row(reinterpret_cast<std::uint32_t*>(bytes), static_cast<std::size_t>(surface->w));
+        }
+        if (must_lock) { SDL_UnlockSurface(surface); }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void fill(std::uint32_t* pixels, std::size_t count, std::uint32_t color) {
+        FOR_ROW(count, [&](auto tag, std::size_t i, std::size_t end) {
+            using Pixels = typename decltype(tag)::type;
+            const Pixels fill = Pixels::splat(color);
+            for (; i + Pixels::WIDTH <= end; i += Pixels::WIDTH) { fill.store(pixels + i); }
+            return i;
+        });
+    }
+
+    void premultiply(std::uint32_t* pixels, std::size_t count) {
+        MAP_ROW(pixels, pixels, count, [](auto lanes) { return decltype(lanes)::premultiply(lanes); });
+    }
+
+    void unpremultiply(std::uint32_t* pixels, std::size_t count) {
+        MAP_ROW(pixels, pixels, count, [](auto lanes) { return decltype(lanes)::unpremultiply(lanes); });
+    }
+
+    void modulate(std::uint32_t* pixels, std::size_t count, std::uint32_t color) {
+        MAP_ROW(pixels, pixels, count, [color](auto lanes) {
+            using Pixels = decltype(lanes);
+            return Pixels::multiply(lanes, Pixels::splat(color));
+        });
+    }
+
+    void alpha_over(std::uint32_t* dst, const std::uint32_t* src, std::size_t count) {
+        FOR_ROW(count, [&](auto tag, std::size_t i, std::size_t end) {
+            using Pixels = typename decltype(tag)::type;
+            for (; i + Pixels::WIDTH <= end; i += Pixels::WIDTH) {
+                Pixels pixels = Pixels::load(src + i);
+                if (Pixels::transparent_mask(pixels) == Pixels::ALL_LANES) { continue; }
+                if (Pixels::opaque_mask(pixels) == Pixels::ALL_LANES) {
+                    pixels.store(dst + i);
+                    continue;
+                }
+                Pixels::blend(Pixels::load(dst + i), pixels).store(dst + i);
+            }
+            return i;
+        });
+    }
+
+    void alpha_over(std::uint32_t* dst, const std::uint32_t* src, std::size_t count, std::uint32_t tint) {
+        FOR_ROW(count, [&](auto tag, std::size_t i, std::size_t end) {
+            using Pixels = typename decltype(tag)::type;
+            const Pixels tint_lanes = Pixels::splat(tint);
+            for (; i + Pixels::WIDTH <= end; i += Pixels::WIDTH) {
+                Pixels pixels = Pixels::multiply(Pixels::load(src + i), tint_lanes);
+                if (Pixels::transparent_mask(pixels) == Pixels::ALL_LANES) { continue; }
+                Pixels::blend(Pixels::load(dst + i), pixels).store(dst + i);
+            }
+            return i;
+        });
+    }
+
+    void alpha_over_color(std::uint32_t* dst, std::size_t count, std::uint32_t color) {
+        FOR_ROW(count, [&](auto tag, std::size_t i, std::size_t end) {
+            using Pixels = typename decltype(tag)::type;
+            const Pixels src = Pixels::splat(color);
+            for (; i + Pixels::WIDTH <= end; i += Pixels::WIDTH) {
+                Pixels::blend(Pixels::load(dst + i), src).store(dst + i);
+            }
+            return i;
+        });
+    }
+
+    void alpha_over_coverage(std::uint32_t* dst, const std::uint8_t* coverage, std::size_t count,
+                             std::uint32_t color) {
+        FOR_ROW(count, [&](auto tag, std::size_t i, std::size_t end) {
+            using Pixels = typename decltype(tag)::type;
+            for (; i + Pixels::WIDTH <= end; i += Pixels::WIDTH) {
+                Pixels pixels = Pixels::from_coverage(coverage + i, color);
+                if (Pixels::transparent_mask(pixels) == Pixels::ALL_LANES) { continue; }
+                if (Pixels::opaque_mask(pixels) == Pixels::ALL_LANES) {
+                    pixels.store(dst + i);
+                    continue;
+                }
+                Pixels::blend(Pixels::load(dst + i), pixels).store(dst + i);
+            }
+            return i;
+        });
+    }
+
+    bool to_argb8888(const std::uint32_t* src, std::uint32_t* dst, std::size_t count, std::uint32_t source_format) {
+        switch (source_format) {
+            case SDL_PIXELFORMAT_ARGB8888:
+                if (dst != src && count > 0) { std::memmove(dst, src, count * sizeof(std::uint32_t)); }
+                return true;
+            case SDL_PIXELFORMAT_ABGR8888:
+                MAP_ROW(src, dst, count, [](auto pixels) { return SWAP_RED_BLUE(pixels); });
+                return true;
+            case SDL_PIXELFORMAT_RGBA8888:
+                MAP_ROW(src, dst, count, [](auto pixels) {
+                    using Pixels = decltype(pixels);
+                    return Pixels::template shift_right<8>(pixels) | Pixels::template shift_left<24>(pixels);
+                });
+                return true;
+            case SDL_PIXELFORMAT_BGRA8888:
+                MAP_ROW(src, dst, count, [](auto pixels) {
+                    using Pixels = decltype(pixels);
+                    return Pixels::template shift_right<24>(pixels) | Pixels::template shift_left<24>(pixels) |
+                           (Pixels::template shift_right<8>(pixels) & Pixels::splat(0x0000FF00)) |
+                           (Pixels::template shift_left<8>(pixels) & Pixels::splat(0x00FF0000));
+                });
+                return true;
+            case SDL_PIXELFORMAT_RGB888:
+                MAP_ROW(src, dst, count, [](auto pixels) {
+                    return pixels | decltype(pixels)::splat(0xFF000000);
+                });
+                return true;
+            case SDL_PIXELFORMAT_BGR888:
+                MAP_ROW(src, dst, count, [](auto pixels) {
+                    return SWAP_RED_BLUE(pixels) | decltype(pixels)::splat(0xFF000000);
+                });
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void srgb_to_linear(const std::uint32_t* pixels, float* linear, std::size_t count) {
+        const SrgbTables& tables = SRGB_TABLES();
+        for (std::size_t i = 0; i < count; i++, linear += 4) {
+            const std::uint32_t pixel = pixels[i];
+            linear[0] = tables.to_linear[(pixel >> 16) & 0xFF];
+            linear[1] = tables.to_linear[(pixel >> 8) & 0xFF];
+            linear[2] = tables.to_linear[pixel & 0xFF];
+            linear[3] = static_cast<float>(pixel >> 24) * (1.0f / 255.0f);
+        }
+    }
+
+    void linear_to_srgb(const float* linear, std::uint32_t* pixels, std::size_t count) {
+        const SrgbTables& tables = SRGB_TABLES();
+        for (std::size_t i = 0; i < count; i++, linear += 4) {
+            const float alpha = std::fmin(std::fmax(linear[3], 0.0f), 1.0f);
+            pixels[i] = static_cast<std::uint32_t>(alpha * 255.0f + 0.5f) << 24 |
+                        LINEAR_TO_SRGB_BYTE(tables, linear[0]) << 16 | LINEAR_TO_SRGB_BYTE(tables, linear[1]) << 8 |
+                        LINEAR_TO_SRGB_BYTE(tables, linear[2]);
+        }
+    }
+
+    bool premultiply(SDL_Surface* surface) {
+        if (!IS_ARGB8888(surface)) { return false; }
+        FOR_EACH_ROW(surface, [](std::uint32_t* row, std::size_t width) { premultiply(row, width); });
+        return true;
+    }
+
+    bool unpremultiply(SDL_Surface* surface) {
+        if (!IS_ARGB8888(surface)) { return false; }
+        FOR_EACH_ROW(surface, [](std::uint32_t* row, std::size_t width) { unpremultiply(row, width); });
+        return true;
+    }
+
+    bool modulate(SDL_Surface* surface, const SDL_Color& color) {
+        if (!IS_ARGB8888(surface)) { return false; }
+        const std::uint32_t argb = to_argb(color);
+        FOR_EACH_ROW(surface, [argb](std::uint32_t* row, std::size_t width) { modulate(row, width, argb); });
+        return true;
+    }
+
+    bool alpha_over(SDL_Surface* dst, const SDL_Surface* src, int x, int y) {
+        if (!IS_ARGB8888(dst) || !IS_ARGB8888(src) || SDL_MUSTLOCK(src) || SDL_MUSTLOCK(dst)) { return false; }
+
+        SDL_Rect placed{x, y, src->w, src->h}, bounds{0, 0, dst->w, dst->h}, visible;
+        if (!SDL_IntersectRect(&placed, &bounds, &visible)) { return true; }
+
+        const auto* src_row = static_cast<const std::uint8_t*>(src->pixels) +
+                              static_cast<std::ptrdiff_t>(visible.y - y) * src->pitch +
+                              static_cast<std::ptrdiff_t>(visible.x - x) * sizeof(std::uint32_t);
+        auto*       dst_row = static_cast<std::uint8_t*>(dst->pixels) +
+                              static_cast<std::ptrdiff_t>(visible.y) * dst->pitch +
+                              static_cast<std::ptrdiff_t>(visible.x) * sizeof(std::uint32_t);
+        for (int row = 0; row < visible.h; row++, src_row += src->pitch, dst_row += dst->pitch) {
+            alpha_over(reinterpret_cast<std::uint32_t*>(dst_row), reinterpret_cast<const std::uint32_t*>(src_row),
+                       static_cast<std::size_t>(visible.w));
+        }
+        return true;
+    }
+
+    SDL_Surface* to_argb8888(SDL_Surface* surface) {
+        if (!surface || !surface->format) { return nullptr; }
+        // The kernels only move channels, so a colorkey's pixels would come out opaque. SDL turns them transparent.
+        const std::uint32_t format = surface->format->format;
+        if (!CAN_CONVERT(format) || SDL_HasColorKey(surface)) {
+            return SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        }
+
+        SDL_Surface* converted = SDL_CreateRGBSurfaceWithFormat(0, surface->w, surface->h, 32,
+                                                                SDL_PIXELFORMAT_ARGB8888);
+        if (!converted) { return nullptr; }
+
+        SDL_BlendMode blend_mode;
+        if (SDL_GetSurfaceBlendMode(surface, &blend_mode) == 0) { SDL_SetSurfaceBlendMode(converted, blend_mode); }
+
+        const bool must_lock = SDL_MUSTLOCK(surface);
+        if (must_lock && SDL_LockSurface(surface) != 0) {
+            SDL_FreeSurface(converted);
+            return nullptr;
+        }
+        const auto* src_row = static_cast<const std::uint8_t*>(surface->pixels);
+        FOR_EACH_ROW(converted, [&](std::uint32_t* row, std::size_t width) {
+            to_argb8888(reinterpret_cast<const std::uint32_t*>(src_row), row, width, format);
+            src_row += surface->pitch;
+        });
+        if (must_lock) { SDL_UnlockSurface(surface); }
+        return converted;
+    }
+
+} // Core::PixelOps
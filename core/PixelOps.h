@@ -0,0 +1,100 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_PIXEL_OPS_H
+#define GOLD_CARTRIDGE_PIXEL_OPS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <SDL_pixels.h>
+#include <SDL_surface.h>
+
+/**
+ * @brief Whole-row and whole-surface pixel kernels: compositing, tinting, premultiplication and format conversion.
+ *
+ * Every kernel works on ARGB8888 pixels, SDL_PIXELFORMAT_ARGB8888, the format
+ * the framework's textures use. Colors are straight unless a function says
+ * otherwise. The integer kernels run on Core::PixelLanes, several pixels at a
+ * time, and give exactly the same results as Core::ScalarPixels one pixel at
+ * a time. Surface functions handle ARGB8888 surfaces only and return false
+ * for anything else.
+ */
+namespace Core::PixelOps {
+
+    /// Packs a color as one ARGB8888 pixel.
+    inline std::uint32_t to_argb(const SDL_Color& color) {
+        return static_cast<std::uint32_t>(color.a) << 24 | static_cast<std::uint32_t>(color.r) << 16 |
+               static_cast<std::uint32_t>(color.g) << 8 | color.b;
+    }
+
+    void fill(std::uint32_t* pixels, std::size_t count, std::uint32_t color);
+
+    /// Multiplies each pixel's color channels by its alpha.
+    void premultiply(std::uint32_t* pixels, std::size_t count);
+
+    /// Divides premultiplied pixels' color channels by their alpha. Fully transparent pixels become zero.
+    void unpremultiply(std::uint32_t* pixels, std::size_t count);
+
+    /// Multiplies every channel, alpha included, by the same channel of a color, as a tint does.
+    void modulate(std::uint32_t* pixels, std::size_t count, std::uint32_t color);
+
+    /// Blends src over dst, as SDL_BLENDMODE_BLEND does. Opaque and transparent runs skip the blend.
+    void alpha_over(std::uint32_t* dst, const std::uint32_t* src, std::size_t count);
+
+    /// Blends src, modulated by a tint, over dst.
+    void alpha_over(std::uint32_t* dst, const std::uint32_t* src, std::size_t count, std::uint32_t tint);
+
+    /// Blends one color over every pixel of dst.
+    void alpha_over_color(std::uint32_t* dst, std::size_t count, std::uint32_t color);
+
+    /**
+     * Blends a color over dst through a row of coverage, as antialiased text is drawn.
+     * @param coverage One byte per pixel, 0 for none and 255 for full. The color's alpha is scaled by it.
+     */
+    void alpha_over_coverage(std::uint32_t* dst, const std::uint8_t* coverage, std::size_t count,
+                             std::uint32_t color);
+
+    /**
+     * Converts 32 bit pixels to ARGB8888 by moving their channels. dst may be src.
+     * @param source_format ARGB8888, ABGR8888, RGBA8888, BGRA8888, RGB888 or BGR888. The last two become opaque.
+     * @return False, converting nothing, for any other format.
+     */
+    bool to_argb8888(const std::uint32_t* src, std::uint32_t* dst, std::size_t count, std::uint32_t source_format);
+
+    /**
+     * Converts sRGB pixels to linear light, for blending or filtering with correct brightness.
+     * @param linear Receives four floats per pixel, red, green, blue and alpha, each from 0 to 1. Alpha is
+     *               already linear, so it is only scaled.
+     */
+    void srgb_to_linear(const std::uint32_t* pixels, float* linear, std::size_t count);
+
+    /// Converts linear light back to sRGB pixels, clamping to 0 to 1 and rounding to the nearest sRGB value.
+    void linear_to_srgb(const float* linear, std::uint32_t* pixels, std::size_t count);
+
+    bool premultiply(SDL_Surface* surface);
+    bool unpremultiply(SDL_Surface* surface);
+    bool modulate(SDL_Surface* surface, const SDL_Color& color);
+
+    /**
+     * Blends one surface over another.
+     * @param x Where src's left edge goes on dst. src is clipped to dst's edges.
+     * @param y Where src's top edge goes on dst.
+     */
+    bool alpha_over(SDL_Surface* dst, const SDL_Surface* src, int x, int y);
+
+    /**
+     * Copies a surface into a new ARGB8888 surface. Formats to_argb8888() knows are converted with its
+     * kernels. Others, and surfaces with a colorkey, go through SDL_ConvertSurfaceFormat.
+     * @return The new surface, which the caller frees, or null if it couldn't be made.
+     */
+    SDL_Surface* to_argb8888(SDL_Surface* surface);
+
+} // Core::PixelOps
+
+#endif //GOLD_CARTRIDGE_PIXEL_OPS_H
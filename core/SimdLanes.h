@@ -0,0 +1,416 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_SIMD_LANES_H
+#define GOLD_CARTRIDGE_SIMD_LANES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * The widest instruction set the compiler was told it may use. AVX needs GOLD_CARTRIDGE_ENABLE_AVX in CMake, and
+ * AVX2 needs GOLD_CARTRIDGE_ENABLE_AVX2.
+ */
+#if defined(GOLD_CARTRIDGE_DISABLE_SIMD)
+#define GOLD_CARTRIDGE_SIMD_NAME "scalar"
+#elif defined(__AVX2__)
+#define GOLD_CARTRIDGE_SIMD_AVX2 1
+#define GOLD_CARTRIDGE_SIMD_AVX 1
+#define GOLD_CARTRIDGE_SIMD_SSE2 1
+#define GOLD_CARTRIDGE_SIMD_NAME "AVX2"
+#include <immintrin.h>
+#elif defined(__AVX__)
+#define GOLD_CARTRIDGE_SIMD_AVX 1
+#define GOLD_CARTRIDGE_SIMD_SSE2 1
+#define GOLD_CARTRIDGE_SIMD_NAME "AVX"
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GOLD_CARTRIDGE_SIMD_SSE2 1
+#define GOLD_CARTRIDGE_SIMD_NAME "SSE2"
+#include <emmintrin.h>
+#else
+#define GOLD_CARTRIDGE_SIMD_NAME "scalar"
+#endif
+
+namespace Core {
+
+    /**
+     * @brief As many floats as one SIMD register holds, with the few operations the framework's kernels need.
+     *
+     * WIDTH is 8 with AVX, 4 with SSE2, and 1 otherwise, so a kernel written
+     * against FloatLanes is also its own scalar fallback. Kernels step through
+     * their arrays WIDTH elements at a time and finish the remainder with
+     * plain scalar code. Loads and stores don't need to be aligned.
+     */
+    struct FloatLanes {
+#if defined(GOLD_CARTRIDGE_SIMD_AVX)
+        static constexpr int WIDTH = 8;
+        __m256 value;
+
+        static FloatLanes load(const float* source) { return {_mm256_loadu_ps(source)}; }
+        static FloatLanes splat(float scalar) { return {_mm256_set1_ps(scalar)}; }
+        void store(float* destination) const { _mm256_storeu_ps(destination, value); }
+
+        friend FloatLanes operator+(FloatLanes a, FloatLanes b) { return {_mm256_add_ps(a.value, b.value)}; }
+        friend FloatLanes operator-(FloatLanes a, FloatLanes b) { return {_mm256_sub_ps(a.value, b.value)}; }
+        friend FloatLanes operator*(FloatLanes a, FloatLanes b) { return {_mm256_mul_ps(a.value, b.value)}; }
+        static FloatLanes min(FloatLanes a, FloatLanes b) { return {_mm256_min_ps(a.value, b.value)}; }
+        static FloatLanes max(FloatLanes a, FloatLanes b) { return {_mm256_max_ps(a.value, b.value)}; }
+
+        /// Bit i is set when lane i of a is less than or equal to lane i of b.
+        static int less_equal_mask(FloatLanes a, FloatLanes b) {
+            return _mm256_movemask_ps(_mm256_cmp_ps(a.value, b.value, _CMP_LE_OQ));
+        }
+#elif defined(GOLD_CARTRIDGE_SIMD_SSE2)
+        static constexpr int WIDTH = 4;
+        __m128 value;
+
+        static FloatLanes load(const float* source) { return {_mm_loadu_ps(source)}; }
+        static FloatLanes splat(float scalar) { return {_mm_set1_ps(scalar)}; }
+        void store(float* destination) const { _mm_storeu_ps(destination, value); }
+
+        friend FloatLanes operator+(FloatLanes a, FloatLanes b) { return {_mm_add_ps(a.value, b.value)}; }
+        friend FloatLanes operator-(FloatLanes a, FloatLanes b) { return {_mm_sub_ps(a.value, b.value)}; }
+        friend FloatLanes operator*(FloatLanes a, FloatLanes b) { return {_mm_mul_ps(a.value, b.value)}; }
+        static FloatLanes min(FloatLanes a, FloatLanes b) { return {_mm_min_ps(a.value, b.value)}; }
+        static FloatLanes max(FloatLanes a, FloatLanes b) { return {_mm_max_ps(a.value, b.value)}; }
+
+        /// Bit i is set when lane i of a is less than or equal to lane i of b.
+        static int less_equal_mask(FloatLanes a, FloatLanes b) { return _mm_movemask_ps(_mm_cmple_ps(a.value, b.value)); }
+#else
+        static constexpr int WIDTH = 1;
+        float value;
+
+        static FloatLanes load(const float* source) { return {*source}; }
+        static FloatLanes splat(float scalar) { return {scalar}; }
+        void store(float* destination) const { *destination = value; }
+
+        friend FloatLanes operator+(FloatLanes a, FloatLanes b) { return {a.value + b.value}; }
+        friend FloatLanes operator-(FloatLanes a, FloatLanes b) { return {a.value - b.value}; }
+        friend FloatLanes operator*(FloatLanes a, FloatLanes b) { return {a.value * b.value}; }
+        static FloatLanes min(FloatLanes a, FloatLanes b) { return {a.value < b.value ? a.value : b.value}; }
+        static FloatLanes max(FloatLanes a, FloatLanes b) { return {a.value > b.value ? a.value : b.value}; }
+
+        /// Bit i is set when lane i of a is less than or equal to lane i of b.
+        static int less_equal_mask(FloatLanes a, FloatLanes b) { return a.value <= b.value ? 1 : 0; }
+#endif
+
+        /// Every lane's bit set, for combining masks.
+        static constexpr int ALL_LANES = (1 << WIDTH) - 1;
+    };
+
+    /**
+     * @brief One ARGB8888 pixel with the operations of PixelLanes, for the pixels left over after the wide loop.
+     *
+     * Colors are straight, not premultiplied, and every division by 255 is
+     * rounded, so these give exactly the same results as the SIMD lanes.
+     */
+    struct ScalarPixels {
+        static constexpr int WIDTH     = 1;
+        static constexpr int ALL_LANES = 1;
+        std::uint32_t value;
+
+        static ScalarPixels load(const std::uint32_t* source) { return {*source}; }
+        static ScalarPixels splat(std::uint32_t pixel) { return {pixel}; }
+        void store(std::uint32_t* destination) const { *destination = value; }
+
+        /// x / 255, rounded, for x up to 255 * 255.
+        static std::uint32_t div255(std::uint32_t x) {
+            x += 128;
+            return (x + (x >> 8)) >> 8;
+        }
+
+        /// src drawn over dst: each color channel becomes src * a + dst * (1 - a), and alpha a + dst alpha * (1 - a).
+        static ScalarPixels blend(ScalarPixels dst, ScalarPixels src) {
+            const std::uint32_t alpha   = src.value >> 24;
+            const std::uint32_t inverse = 255 - alpha;
+            std::uint32_t       result  = 0;
+            for (int shift = 0; shift < 24; shift += 8) {
+                std::uint32_t channel = ((src.value >> shift) & 0xFF) * alpha + ((dst.value >> shift) & 0xFF) * inverse;
+                result |= div255(channel) << shift;
+            }
+            return {result | div255(255 * alpha + (dst.value >> 24) * inverse) << 24};
+        }
+
+        /// Multiplies each channel of a by the same channel of b, as a tint does.
+        static ScalarPixels multiply(ScalarPixels a, ScalarPixels b) {
+            std::uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                result |= div255(((a.value >> shift) & 0xFF) * ((b.value >> shift) & 0xFF)) << shift;
+            }
+            return {result};
+        }
+
+        /// The color, with its alpha scaled by a coverage value from 0 to 255, as a glyph mask gives.
+        static ScalarPixels from_coverage(const std::uint8_t* coverage, std::uint32_t color) {
+            return {(color & 0x00FFFFFF) | div255(*coverage * (color >> 24)) << 24};
+        }
+
+        /// Bit i is set when lane i is fully opaque.
+        static int opaque_mask(ScalarPixels pixels) { return pixels.value >= 0xFF000000 ? 1 : 0; }
+
+        /// Bit i is set when lane i is fully transparent.
+        static int transparent_mask(ScalarPixels pixels) { return pixels.value < 0x01000000 ? 1 : 0; }
+
+        /// Multiplies each color channel by alpha. Alpha is unchanged.
+        static ScalarPixels premultiply(ScalarPixels pixels) {
+            const std::uint32_t alpha  = pixels.value >> 24;
+            std::uint32_t       result = pixels.value & 0xFF000000;
+            for (int shift = 0; shift < 24; shift += 8) {
+                result |= div255(((pixels.value >> shift) & 0xFF) * alpha) << shift;
+            }
+            return {result};
+        }
+
+        /// Divides each color channel by alpha, undoing premultiply() as nearly as 8 bits allow. Alpha 0 gives 0.
+        static ScalarPixels unpremultiply(ScalarPixels pixels) {
+            const std::uint32_t alpha  = pixels.value >> 24;
+            const float         scale  = alpha == 0 ? 0.0f : 255.0f / static_cast<float>(alpha);
+            std::uint32_t       result = pixels.value & 0xFF000000;
+            for (int shift = 0; shift < 24; shift += 8) {
+                float channel = static_cast<float>((pixels.value >> shift) & 0xFF) * scale + 0.5f;
+                result |= static_cast<std::uint32_t>(std::min(channel, 255.0f)) << shift;
+            }
+            return {result};
+        }
+
+        /// Bitwise operations on whole pixels, for moving channels between formats.
+        friend ScalarPixels operator&(ScalarPixels a, ScalarPixels b) { return {a.value & b.value}; }
+        friend ScalarPixels operator|(ScalarPixels a, ScalarPixels b) { return {a.value | b.value}; }
+        template <int BITS> static ScalarPixels shift_left(ScalarPixels pixels) { return {pixels.value << BITS}; }
+        template <int BITS> static ScalarPixels shift_right(ScalarPixels pixels) { return {pixels.value >> BITS}; }
+    };
+
+#if defined(GOLD_CARTRIDGE_SIMD_SSE2)
+    /**
+     * @brief As many ARGB8888 pixels as one integer SIMD register holds: 8 with AVX2, 4 with SSE2.
+     *
+     * The same operations as ScalarPixels, with the same results. Each pixel's
+     * channels are widened to 16 bits so that products of two channels fit.
+     */
+    struct PixelLanes {
+#if defined(GOLD_CARTRIDGE_SIMD_AVX2)
+        static constexpr int WIDTH = 8;
+        __m256i value;
+
+        static PixelLanes load(const std::uint32_t* source) {
+            return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source))};
+        }
+        static PixelLanes splat(std::uint32_t pixel) { return {_mm256_set1_epi32(static_cast<int>(pixel))}; }
+        void store(std::uint32_t* destination) const {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), value);
+        }
+
+        static PixelLanes blend(PixelLanes dst, PixelLanes src) {
+            const __m256i zero      = _mm256_setzero_si256();
+            const __m256i max       = _mm256_set1_epi16(255);
+            const __m256i alpha_max = _mm256_set1_epi64x(0x00FF000000000000);
+            __m256i       src_low   = _mm256_unpacklo_epi8(src.value, zero);
+            __m256i       src_high  = _mm256_unpackhi_epi8(src.value, zero);
+            __m256i       alpha_low  = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_low, 0xFF), 0xFF);
+            __m256i       alpha_high = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_high, 0xFF), 0xFF);
+            __m256i low  = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_or_si256(src_low, alpha_max), alpha_low),
+                                            _mm256_mullo_epi16(_mm256_unpacklo_epi8(dst.value, zero),
+                                                               _mm256_sub_epi16(max, alpha_low)));
+            __m256i high = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_or_si256(src_high, alpha_max), alpha_high),
+                                            _mm256_mullo_epi16(_mm256_unpackhi_epi8(dst.value, zero),
+                                                               _mm256_sub_epi16(max, alpha_high)));
+            return {_mm256_packus_epi16(div255(low), div255(high))};
+        }
+
+        static PixelLanes multiply(PixelLanes a, PixelLanes b) {
+            const __m256i zero = _mm256_setzero_si256();
+            __m256i low  = _mm256_mullo_epi16(_mm256_unpacklo_epi8(a.value, zero), _mm256_unpacklo_epi8(b.value, zero));
+            __m256i high = _mm256_mullo_epi16(_mm256_unpackhi_epi8(a.value, zero), _mm256_unpackhi_epi8(b.value, zero));
+            return {_mm256_packus_epi16(div255(low), div255(high))};
+        }
+
+        static PixelLanes from_coverage(const std::uint8_t* coverage, std::uint32_t color) {
+            __m256i scaled = _mm256_mullo_epi16(
+                    _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(coverage))),
+                    _mm256_set1_epi32(static_cast<int>(color >> 24)));
+            __m256i alpha  = _mm256_slli_epi32(div255(scaled), 24);
+            return {_mm256_or_si256(alpha, _mm256_set1_epi32(static_cast<int>(color & 0x00FFFFFF)))};
+        }
+
+        static int opaque_mask(PixelLanes pixels) {
+            const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+            __m256i is_opaque = _mm256_cmpeq_epi32(_mm256_and_si256(pixels.value, alpha), alpha);
+            return _mm256_movemask_ps(_mm256_castsi256_ps(is_opaque));
+        }
+
+        static int transparent_mask(PixelLanes pixels) {
+            const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+            __m256i is_clear = _mm256_cmpeq_epi32(_mm256_and_si256(pixels.value, alpha), _mm256_setzero_si256());
+            return _mm256_movemask_ps(_mm256_castsi256_ps(is_clear));
+        }
+
+        static PixelLanes premultiply(PixelLanes pixels) {
+            const __m256i zero       = _mm256_setzero_si256();
+            const __m256i alpha_max  = _mm256_set1_epi64x(0x00FF000000000000);
+            __m256i       low        = _mm256_unpacklo_epi8(pixels.value, zero);
+            __m256i       high       = _mm256_unpackhi_epi8(pixels.value, zero);
+            __m256i       alpha_low  = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(low, 0xFF), 0xFF);
+            __m256i       alpha_high = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(high, 0xFF), 0xFF);
+            alpha_low  = _mm256_or_si256(alpha_low, alpha_max);
+            alpha_high = _mm256_or_si256(alpha_high, alpha_max);
+            return {_mm256_packus_epi16(div255(_mm256_mullo_epi16(low, alpha_low)),
+                                        div255(_mm256_mullo_epi16(high, alpha_high)))};
+        }
+
+        static PixelLanes unpremultiply(PixelLanes pixels) {
+            const __m256i alpha       = _mm256_srli_epi32(pixels.value, 24);
+            const __m256  alpha_float = _mm256_cvtepi32_ps(alpha);
+            const __m256  scale       = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(255.0f), alpha_float),
+                                                      _mm256_cmp_ps(alpha_float, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+            __m256i result = _mm256_or_si256(_mm256_slli_epi32(alpha, 24), scale_channel<0>(pixels.value, scale));
+            result = _mm256_or_si256(result, scale_channel<8>(pixels.value, scale));
+            return {_mm256_or_si256(result, scale_channel<16>(pixels.value, scale))};
+        }
+
+        friend PixelLanes operator&(PixelLanes a, PixelLanes b) { return {_mm256_and_si256(a.value, b.value)}; }
+        friend PixelLanes operator|(PixelLanes a, PixelLanes b) { return {_mm256_or_si256(a.value, b.value)}; }
+        template <int BITS> static PixelLanes shift_left(PixelLanes pixels) {
+            return {_mm256_slli_epi32(pixels.value, BITS)};
+        }
+        template <int BITS> static PixelLanes shift_right(PixelLanes pixels) {
+            return {_mm256_srli_epi32(pixels.value, BITS)};
+        }
+
+    private:
+        /// The channel at SHIFT bits into each pixel, times scale, rounded and capped at 255, and put back in place.
+        template <int SHIFT>
+        static __m256i scale_channel(__m256i pixels, __m256 scale) {
+            __m256i channel = _mm256_and_si256(_mm256_srli_epi32(pixels, SHIFT), _mm256_set1_epi32(0xFF));
+            __m256  scaled  = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(channel), scale), _mm256_set1_ps(0.5f));
+            return _mm256_slli_epi32(_mm256_cvttps_epi32(_mm256_min_ps(scaled, _mm256_set1_ps(255.0f))), SHIFT);
+        }
+
+        /// x / 255, rounded, in each 16-bit lane. Also right for 32-bit lanes holding up to 255 * 255.
+        static __m256i div255(__m256i x) {
+            x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+            return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+        }
+#else
+        static constexpr int WIDTH = 4;
+        __m128i value;
+
+        static PixelLanes load(const std::uint32_t* source) {
+            return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(source))};
+        }
+        static PixelLanes splat(std::uint32_t pixel) { return {_mm_set1_epi32(static_cast<int>(pixel))}; }
+        void store(std::uint32_t* destination) const {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), value);
+        }
+
+        static PixelLanes blend(PixelLanes dst, PixelLanes src) {
+            const __m128i zero       = _mm_setzero_si128();
+            const __m128i max        = _mm_set1_epi16(255);
+            const __m128i alpha_max  = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+            __m128i       src_low    = _mm_unpacklo_epi8(src.value, zero);
+            __m128i       src_high   = _mm_unpackhi_epi8(src.value, zero);
+            __m128i       alpha_low  = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_low, 0xFF), 0xFF);
+            __m128i       alpha_high = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_high, 0xFF), 0xFF);
+            __m128i low  = _mm_add_epi16(_mm_mullo_epi16(_mm_or_si128(src_low, alpha_max), alpha_low),
+                                         _mm_mullo_epi16(_mm_unpacklo_epi8(dst.value, zero),
+                                                         _mm_sub_epi16(max, alpha_low)));
+            __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_or_si128(src_high, alpha_max), alpha_high),
+                                         _mm_mullo_epi16(_mm_unpackhi_epi8(dst.value, zero),
+                                                         _mm_sub_epi16(max, alpha_high)));
+            return {_mm_packus_epi16(div255(low), div255(high))};
+        }
+
+        static PixelLanes multiply(PixelLanes a, PixelLanes b) {
+            const __m128i zero = _mm_setzero_si128();
+            __m128i low  = _mm_mullo_epi16(_mm_unpacklo_epi8(a.value, zero), _mm_unpacklo_epi8(b.value, zero));
+            __m128i high = _mm_mullo_epi16(_mm_unpackhi_epi8(a.value, zero), _mm_unpackhi_epi8(b.value, zero));
+            return {_mm_packus_epi16(div255(low), div255(high))};
+        }
+
+        static PixelLanes from_coverage(const std::uint8_t* coverage, std::uint32_t color) {
+            const __m128i zero = _mm_setzero_si128();
+            int           bytes;
+            std::memcpy(&bytes, coverage, sizeof(bytes));
+            __m128i widened = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+            __m128i scaled  = _mm_mullo_epi16(widened, _mm_set1_epi32(static_cast<int>(color >> 24)));
+            __m128i alpha   = _mm_slli_epi32(div255(scaled), 24);
+            return {_mm_or_si128(alpha, _mm_set1_epi32(static_cast<int>(color & 0x00FFFFFF)))};
+        }
+
+        static int opaque_mask(PixelLanes pixels) {
+            const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+            __m128i is_opaque = _mm_cmpeq_epi32(_mm_and_si128(pixels.value, alpha), alpha);
+            return _mm_movemask_ps(_mm_castsi128_ps(is_opaque));
+        }
+
+        static int transparent_mask(PixelLanes pixels) {
+            const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+            __m128i is_clear = _mm_cmpeq_epi32(_mm_and_si128(pixels.value, alpha), _mm_setzero_si128());
+            return _mm_movemask_ps(_mm_castsi128_ps(is_clear));
+        }
+
+        static PixelLanes premultiply(PixelLanes pixels) {
+            const __m128i zero       = _mm_setzero_si128();
+            const __m128i alpha_max  = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+            __m128i       low        = _mm_unpacklo_epi8(pixels.value, zero);
+            __m128i       high       = _mm_unpackhi_epi8(pixels.value, zero);
+            __m128i       alpha_low  = _mm_shufflehi_epi16(_mm_shufflelo_epi16(low, 0xFF), 0xFF);
+            __m128i       alpha_high = _mm_shufflehi_epi16(_mm_shufflelo_epi16(high, 0xFF), 0xFF);
+            alpha_low  = _mm_or_si128(alpha_low, alpha_max);
+            alpha_high = _mm_or_si128(alpha_high, alpha_max);
+            return {_mm_packus_epi16(div255(_mm_mullo_epi16(low, alpha_low)),
+                                     div255(_mm_mullo_epi16(high, alpha_high)))};
+        }
+
+        static PixelLanes unpremultiply(PixelLanes pixels) {
+            const __m128i alpha       = _mm_srli_epi32(pixels.value, 24);
+            const __m128  alpha_float = _mm_cvtepi32_ps(alpha);
+            const __m128  scale       = _mm_and_ps(_mm_div_ps(_mm_set1_ps(255.0f), alpha_float),
+                                                   _mm_cmpneq_ps(alpha_float, _mm_setzero_ps()));
+            __m128i result = _mm_or_si128(_mm_slli_epi32(alpha, 24), scale_channel<0>(pixels.value, scale));
+            result = _mm_or_si128(result, scale_channel<8>(pixels.value, scale));
+            return {_mm_or_si128(result, scale_channel<16>(pixels.value, scale))};
+        }
+
+        friend PixelLanes operator&(PixelLanes a, PixelLanes b) { return {_mm_and_si128(a.value, b.value)}; }
+        friend PixelLanes operator|(PixelLanes a, PixelLanes b) { return {_mm_or_si128(a.value, b.value)}; }
+        template <int BITS> static PixelLanes shift_left(PixelLanes pixels) {
+            return {_mm_slli_epi32(pixels.value, BITS)};
+        }
+        template <int BITS> static PixelLanes shift_right(PixelLanes pixels) {
+            return {_mm_srli_epi32(pixels.value, BITS)};
+        }
+
+    private:
+        /// The channel at SHIFT bits into each pixel, times scale, rounded and capped at 255, and put back in place.
+        template <int SHIFT>
+        static __m128i scale_channel(__m128i pixels, __m128 scale) {
+            __m128i channel = _mm_and_si128(_mm_srli_epi32(pixels, SHIFT), _mm_set1_epi32(0xFF));
+            __m128  scaled  = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(channel), scale), _mm_set1_ps(0.5f));
+            return _mm_slli_epi32(_mm_cvttps_epi32(_mm_min_ps(scaled, _mm_set1_ps(255.0f))), SHIFT);
+        }
+
+        /// x / 255, rounded, in each 16-bit lane. Also right for 32-bit lanes holding up to 255 * 255.
+        static __m128i div255(__m128i x) {
+            x = _mm_add_epi16(x, _mm_set1_epi16(128));
+            return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+        }
+#endif
+
+    public:
+        /// Every lane's bit set, for comparing masks.
+        static constexpr int ALL_LANES = (1 << WIDTH) - 1;
+    };
+#else
+    using PixelLanes = ScalarPixels;
+#endif
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_SIMD_LANES_H
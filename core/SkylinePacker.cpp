@@ -0,0 +1,114 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    SkylinePacker::SkylinePacker(int width, int height)
+            : m_width(std::max(width, 0)),
+              m_height(std::max(height, 0)),
+              m_used_area(0) {
+        reset();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool SkylinePacker::insert(int w, int h, SDL_Point& position) {
+        if (w <= 0 || h <= 0) { return false; }
+
+        // Bottom-left rule: lowest top edge wins, then the narrowest segment, which leaves wide ones for wide
+        // rectangles.
+        std::size_t best_segment = m_skyline.size();
+        int         best_top     = std::numeric_limits<int>::max();
+        int         best_width   = std::numeric_limits<int>::max();
+        for (std::size_t i = 0; i < m_skyline.size(); i++) {
+            int y = fit(i, w, h);
+            if (y < 0) { continue; }
+            if (y + h < best_top || (y + h == best_top && m_skyline[i].width < best_width)) {
+                best_segment = i;
+                best_top     = y + h;
+                best_width   = m_skyline[i].width;
+            }
+        }
+        if (best_segment == m_skyline.size()) { return false; }
+
+        position = {m_skyline[best_segment].x, best_top - h};
+        m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(best_segment),
+                         Segment{position.x, best_top, w});
+
+        // Cut back the segments the new one now covers.
+        const int   right = position.x + w;
+        std::size_t next  = best_segment + 1;
+        while (next < m_skyline.size() && m_skyline[next].x < right) {
+            Segment& covered = m_skyline[next];
+            int      overlap = right - covered.x;
+            if (overlap < covered.width) {
+                covered.x += overlap;
+                covered.width -= overlap;
+                break;
+            }
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(next));
+        }
+
+        // Neighbours at the same height are one segment.
+        for (std::size_t i = 0; i + 1 < m_skyline.size();) {
+            if (m_skyline[i].y == m_skyline[i + 1].y) {
+                m_skyline[i].width += m_skyline[i + 1].width;
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            } else {
+                i++;
+            }
+        }
+
+        m_used_area += static_cast<std::uint64_t>(w) * static_cast<std::uint64_t>(h);
+        return true;
+    }
+
+    void SkylinePacker::reset() {
+        m_skyline.assign(1, Segment{0, 0, m_width});
+        m_used_area = 0;
+    }
+
+    int SkylinePacker::width() const { return m_width; }
+
+    int SkylinePacker::height() const { return m_height; }
+
+    double SkylinePacker::occupancy() const {
+        std::uint64_t area = static_cast<std::uint64_t>(m_width) * static_cast<std::uint64_t>(m_height);
+        return area > 0 ? static_cast<double>(m_used_area) / static_cast<double>(area) : 0.0;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    int SkylinePacker::fit(std::size_t segment, int w, int h) const {
+        if (m_skyline[segment].x + w > m_width) { return -1; }
+
+        // The rectangle rests on the highest segment under it.
+        int y               = 0;
+        int width_remaining = w;
+        for (std::size_t i = segment; width_remaining > 0; i++) {
+            y = std::max(y, m_skyline[i].y);
+            if (y + h > m_height) { return -1; }
+            width_remaining -= m_skyline[i].width;
+        }
+        return y;
+    }
+
+} // Core
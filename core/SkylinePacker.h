@@ -0,0 +1,75 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_SKYLINE_PACKER_H
+#define GOLD_CARTRIDGE_SKYLINE_PACKER_H
+
+#include <cstdint>
+#include <vector>
+
+#include <SDL_rect.h>
+
+namespace Core {
+
+    /**
+     * @brief Packs rectangles into a fixed-size area, one at a time, with the skyline bottom-left method.
+     *
+     * The packer only remembers the outline of the filled area's upper edge,
+     * the "skyline", as a list of flat segments. Each rectangle goes where its
+     * top edge ends up lowest, so the area fills evenly from one edge. Space
+     * trapped under an overhanging rectangle is never reused, which costs a
+     * little density compared to tracking every free rectangle, but keeps each
+     * insert down to one pass over the skyline. Inserting the tallest
+     * rectangles first packs noticeably tighter when they're all known ahead
+     * of time.
+     */
+    class SkylinePacker {
+    public:
+        SkylinePacker(int width, int height);
+
+        /**
+         * Finds room for a rectangle and marks it as used.
+         * @param w The rectangle's width.
+         * @param h The rectangle's height.
+         * @param position Receives the rectangle's top-left corner.
+         * @return False if the rectangle doesn't fit anywhere.
+         */
+        bool insert(int w, int h, SDL_Point& position);
+
+        /// Empties the area.
+        void reset();
+
+        int width() const;
+        int height() const;
+
+        /// The fraction of the area covered by inserted rectangles, between zero and one.
+        double occupancy() const;
+
+    private:
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        /**
+         * Checks whether a rectangle can sit on the skyline starting at a segment.
+         * @return The height the rectangle would rest at, or -1 if it runs off the area.
+         */
+        int fit(std::size_t segment, int w, int h) const;
+
+    private:
+        int                  m_width;
+        int                  m_height;
+        std::vector<Segment> m_skyline;
+        std::uint64_t        m_used_area;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_SKYLINE_PACKER_H
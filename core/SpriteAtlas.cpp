@@ -0,0 +1,245 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "SpriteAtlas.h"
+#include "Logger.h"
+#include "PixelOps.h"
+#include "TexturePixels.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <SDL_image.h>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    static const Uint32 ATLAS_FORMAT      = SDL_PIXELFORMAT_ARGB8888;
+    static const char*  ATLAS_FILE_HEADER = "# gold_cartridge sprite atlas";
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /// Uploads part of a page's pixels to its texture.
+    static bool UPLOAD_AREA(SDL_Texture* texture, SDL_Surface* pixels, const SDL_Rect& area) {
+        const auto* first_pixel = static_cast<const Uint8*>(pixels->pixels) + area.y * pixels->pitch + area.x * 4;
+        return SDL_UpdateTexture(texture, &area, first_pixel, pixels->pitch) == 0;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    SpriteAtlas::SpriteAtlas(SDL_Renderer* renderer, int page_size, int padding)
+            : m_renderer(renderer),
+              m_page_size(page_size),
+              m_padding(std::max(padding, 0)) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    SpriteAtlas::Sprite::operator bool() const { return page >= 0; }
+
+    SpriteAtlas::Sprite SpriteAtlas::add(const std::string& name, SDL_Surface* image) {
+        if (!image) { return {nullptr, {0, 0, 0, 0}, -1}; }
+
+        auto existing = m_sprites.find(name);
+        if (existing != m_sprites.end()) { return existing->second; }
+
+        const int padded_w = image->w + m_padding;
+        const int padded_h = image->h + m_padding;
+        if (padded_w > m_page_size || padded_h > m_page_size) {
+            LOG_ERROR("Sprite \"%s\" is %dx%d, too large for a %d pixel atlas page.", name.c_str(), image->w, image->h,
+                      m_page_size);
+            return {nullptr, {0, 0, 0, 0}, -1};
+        }
+
+        // Earlier pages may still have gaps that fit a small image, so try them all before starting another.
+        Page*       page       = nullptr;
+        std::size_t page_index = 0;
+        SDL_Point   position;
+        for (; page_index < m_pages.size(); page_index++) {
+            Page& candidate = *m_pages[page_index];
+            if (!candidate.is_sealed && candidate.packer.insert(padded_w, padded_h, position)) {
+                page = &candidate;
+                break;
+            }
+        }
+        if (!page) {
+            page = add_page();
+            if (!page || !page->packer.insert(padded_w, padded_h, position)) { return {nullptr, {0, 0, 0, 0}, -1}; }
+        }
+
+        // Copy the pixels as they are rather than blending them over the empty page.
+        SDL_Rect area{position.x, position.y, image->w, image->h};
+        SDL_Rect blit_area = area;
+        SDL_BlendMode blend_mode;
+        SDL_GetSurfaceBlendMode(image, &blend_mode);
+        SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(image, nullptr, page->pixels.get(), &blit_area);
+        SDL_SetSurfaceBlendMode(image, blend_mode);
+
+        if (page->texture && !UPLOAD_AREA(page->texture.get(), page->pixels.get(), area)) {
+            LOG_ERROR("Could not upload sprite \"%s\": %s", name.c_str(), SDL_GetError());
+        }
+
+        Sprite sprite{page->texture, area, static_cast<int>(page_index)};
+        m_sprites.emplace(name, sprite);
+        return sprite;
+    }
+
+    SpriteAtlas::Sprite SpriteAtlas::add_file(const std::string& path) {
+        auto existing = m_sprites.find(path);
+        if (existing != m_sprites.end()) { return existing->second; }
+
+        SDL_Surface* image = IMG_Load(path.c_str());
+        if (!image) {
+            LOG_ERROR("Could not load sprite \"%s\": %s", path.c_str(), SDL_GetError());
+            return {nullptr, {0, 0, 0, 0}, -1};
+        }
+        Sprite sprite = add(path, image);
+        SDL_FreeSurface(image);
+        return sprite;
+    }
+
+    SpriteAtlas::Sprite SpriteAtlas::find(const std::string& name) const {
+        auto found = m_sprites.find(name);
+        return found != m_sprites.end() ? found->second : Sprite{nullptr, {0, 0, 0, 0}, -1};
+    }
+
+    bool SpriteAtlas::save(const std::string& directory, const std::string& name) const {
+        const std::filesystem::path base(directory);
+
+        std::ofstream atlas_file(base / (name + ".atlas"));
+        if (!atlas_file) { return false; }
+        atlas_file << ATLAS_FILE_HEADER << "\n";
+
+        for (std::size_t i = 0; i < m_pages.size(); i++) {
+            std::string page_file = name + "_" + std::to_string(i) + ".png";
+            if (IMG_SavePNG(m_pages[i]->pixels.get(), (base / page_file).string().c_str()) != 0) {
+                LOG_ERROR("Could not write atlas page \"%s\": %s", page_file.c_str(), SDL_GetError());
+                return false;
+            }
+            atlas_file << "page " << i << " " << page_file << "\n";
+        }
+
+        // The name goes last so it may contain spaces.
+        for (const auto& [sprite_name, sprite] : m_sprites) {
+            atlas_file << "sprite " << sprite.page << " " << sprite.source.x << " " << sprite.source.y << " "
+                       << sprite.source.w << " " << sprite.source.h << " " << sprite_name << "\n";
+        }
+        return static_cast<bool>(atlas_file);
+    }
+
+    bool SpriteAtlas::load(const std::string& atlas_file) {
+        std::ifstream in(atlas_file);
+        if (!in) {
+            LOG_ERROR("Could not open sprite atlas \"%s\".", atlas_file.c_str());
+            return false;
+        }
+
+        const std::filesystem::path directory = std::filesystem::path(atlas_file).parent_path();
+        const int                   first_page = static_cast<int>(m_pages.size());
+        std::string                 line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string        kind;
+            fields >> kind;
+
+            if (kind == "page") {
+                int         index;
+                std::string page_file;
+                fields >> index >> std::ws;
+                std::getline(fields, page_file);
+
+                SDL_Surface* loaded    = IMG_Load((directory / page_file).string().c_str());
+                SDL_Surface* converted = loaded ? PixelOps::to_argb8888(loaded) : nullptr;
+                if (loaded) { SDL_FreeSurface(loaded); }
+                if (!converted || !add_page(converted)) {
+                    LOG_ERROR("Could not load atlas page \"%s\": %s", page_file.c_str(), SDL_GetError());
+                    return false;
+                }
+            } else if (kind == "sprite") {
+                Sprite      sprite{nullptr, {0, 0, 0, 0}, -1};
+                std::string name;
+                if (!(fields >> sprite.page >> sprite.source.x >> sprite.source.y >> sprite.source.w
+                             >> sprite.source.h >> std::ws) || !std::getline(fields, name)) {
+                    continue;
+                }
+
+                sprite.page += first_page;
+                if (sprite.page < first_page || sprite.page >= static_cast<int>(m_pages.size())) { continue; }
+                sprite.texture = m_pages[static_cast<std::size_t>(sprite.page)]->texture;
+                m_sprites.emplace(std::move(name), std::move(sprite));
+            }
+        }
+        return true;
+    }
+
+    int SpriteAtlas::page_size() const { return m_page_size; }
+
+    SpriteAtlas::Stats SpriteAtlas::stats() const {
+        Stats stats;
+        stats.sprites = m_sprites.size();
+        stats.pages   = m_pages.size();
+
+        double used_area  = 0.0;
+        double total_area = 0.0;
+        for (const auto& [name, sprite] : m_sprites) {
+            used_area += static_cast<double>(sprite.source.w) * sprite.source.h;
+        }
+        for (const auto& page : m_pages) { total_area += static_cast<double>(page->pixels->w) * page->pixels->h; }
+        stats.occupancy = total_area > 0.0 ? used_area / total_area : 0.0;
+        return stats;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    SpriteAtlas::Page* SpriteAtlas::add_page(SDL_Surface* image) {
+        const bool is_loaded = image != nullptr;
+        if (!image) {
+            image = SDL_CreateRGBSurfaceWithFormat(0, m_page_size, m_page_size, 32, ATLAS_FORMAT);
+            if (!image) {
+                LOG_ERROR("Could not create an atlas page: %s", SDL_GetError());
+                return nullptr;
+            }
+        }
+        std::shared_ptr<SDL_Surface> pixels(image, SDL_FreeSurface);
+
+        TexturePtr texture;
+        if (m_renderer) {
+            SDL_Texture* created = SDL_CreateTexture(m_renderer, ATLAS_FORMAT, SDL_TEXTUREACCESS_STATIC,
+                                                     pixels->w, pixels->h);
+            if (!created) {
+                LOG_ERROR("Could not create an atlas page texture: %s", SDL_GetError());
+                return nullptr;
+            }
+            texture = TexturePixels::access().adopt(created, pixels);
+            SDL_SetTextureBlendMode(created, SDL_BLENDMODE_BLEND);
+            // Upload the whole page once, so the padding between sprites starts out transparent rather than
+            // whatever the driver left in the new texture.
+            UPLOAD_AREA(created, pixels.get(), {0, 0, pixels->w, pixels->h});
+        }
+
+        const int width  = pixels->w;
+        const int height = pixels->h;
+        m_pages.push_back(std::make_unique<Page>(Page{std::move(pixels), std::move(texture),
+                                                      SkylinePacker(width, height), is_loaded}));
+        return m_pages.back().get();
+    }
+
+} // Core
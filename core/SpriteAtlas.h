@@ -0,0 +1,122 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_SPRITE_ATLAS_H
+#define GOLD_CARTRIDGE_SPRITE_ATLAS_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_render.h>
+#include <SDL_surface.h>
+
+#include "SkylinePacker.h"
+
+namespace Core {
+
+    /**
+     * @brief Packs many small images into a few large textures, so sprites drawn from it batch together.
+     *
+     * Each image becomes a named sprite: a texture and the area of it that
+     * holds the image. Sprites on the same page share a texture, so a
+     * BatchRenderer draws all of them in one call. Pages are filled with a
+     * SkylinePacker and a new page is started when one runs out of room.
+     *
+     * An atlas can be packed at runtime, or ahead of time with the
+     * gold_cartridge_atlas tool, which calls save() to write the pages as PNG
+     * files along with a text file naming every sprite. load() reads that back
+     * without any packing. Without a renderer, an atlas only keeps the page
+     * images, which is all save() needs.
+     */
+    class SpriteAtlas {
+    public:
+        using TexturePtr = std::shared_ptr<SDL_Texture>;
+
+        /// An image's place in the atlas. Draw it with BatchRenderer::copy(sprite.texture, sprite.source, ...).
+        struct Sprite {
+            TexturePtr texture; ///< The page texture. Null if the atlas has no renderer.
+            SDL_Rect   source;  ///< Area of the page holding the image.
+            int        page;
+
+            explicit operator bool() const;
+        };
+
+        struct Stats {
+            std::size_t sprites   = 0;
+            std::size_t pages     = 0;
+            double      occupancy = 0.0; ///< Fraction of all page area covered by sprites.
+        };
+
+    public:
+        /**
+         * @param renderer The renderer to make page textures for, or null to only pack images.
+         * @param page_size The width and height of each page, in pixels.
+         * @param padding Empty pixels kept around each sprite, so texture filtering doesn't bleed between them.
+         */
+        explicit SpriteAtlas(SDL_Renderer* renderer, int page_size = 2048, int padding = 1);
+
+        SpriteAtlas(const SpriteAtlas&) = delete;
+        void operator=(const SpriteAtlas&) = delete;
+
+        /**
+         * Packs an image into the atlas and uploads it to its page texture.
+         * @param name The name to find the sprite by. If a sprite already has this name, it's returned instead.
+         * @param image The image to copy in. The atlas doesn't keep it.
+         * @return The new sprite, or an empty one if the image is larger than a page or a page couldn't be made.
+         */
+        Sprite add(const std::string& name, SDL_Surface* image);
+
+        /// Loads an image file and adds it, named after its path.
+        Sprite add_file(const std::string& path);
+
+        /// Finds a sprite by name. Returns an empty sprite if there is none.
+        Sprite find(const std::string& name) const;
+
+        /**
+         * Writes every page as "<name>_<page>.png" and a "<name>.atlas" file describing the sprites.
+         * @param directory The directory to write into. It must already exist.
+         * @param name The base name of the files.
+         * @return False if any file could not be written.
+         */
+        bool save(const std::string& directory, const std::string& name) const;
+
+        /**
+         * Adds the sprites and pages described by a ".atlas" file made with save(). Sprites added afterward
+         * go on new pages.
+         * @param atlas_file The path of the ".atlas" file. Page images are looked for next to it.
+         * @return False if the file or any of its pages could not be read.
+         */
+        bool load(const std::string& atlas_file);
+
+        int page_size() const;
+        Stats stats() const;
+
+    private:
+        struct Page {
+            std::shared_ptr<SDL_Surface> pixels;    ///< Also attached to the texture, in TexturePixels.
+            TexturePtr                   texture;
+            SkylinePacker                packer;
+            bool                         is_sealed; ///< Loaded from disk, so the packer doesn't know what's used.
+        };
+
+        /// Adds a page, optionally starting from an existing image. Takes ownership of the image.
+        Page* add_page(SDL_Surface* image = nullptr);
+
+    private:
+        SDL_Renderer*                           m_renderer;
+        int                                     m_page_size;
+        int                                     m_padding;
+        std::vector<std::unique_ptr<Page>>      m_pages;
+        std::unordered_map<std::string, Sprite> m_sprites;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_SPRITE_ATLAS_H
@@ -8,51 +8,143 @@
 
 #include "System.h"
 
-#include <functional>
-#include <iostream>
-#include <memory>
-#include <optional>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <thread>
 
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 
 #include "FontManager.h"
+#include "JobSystem.h"
+#include "Logger.h"
+#include "TextureManager.h"
 
 namespace Core {
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Helper logging functions.
+/// Translation Unit Variables
 ////////////////////////////////////////////////////////////////////////////////
 
-    static void LOG_STATUS(const std::string& message) {
-        std::cout << message << std::endl;
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        struct SubsystemInfo {
+            System::Subsystem flag;
+            const char*       name;
+            const char*       start_message;
+            const char*       failure_message;
+            bool              (*start)();
+            bool              runs_on_worker; ///< Doesn't touch SDL's main-thread-only state, so it can start in parallel.
+        };
+
+        const SubsystemInfo SUBSYSTEMS[] = {
+            {System::Jobs, "Job system",
+             "Starting job system worker threads...",
+             "Job system failed to start! Jobs will run on the thread that queues them.",
+             []() { return JobSystem::access().start_up() || JobSystem::is_initialized(); }, false},
+            {System::Images, "SDL_image",
+             "Starting SDL_image, and configuring for PNG file loading...",
+             "PNG file loader could not be initialized! Continuing with only basic SDL2 image file support",
+             []() -> bool { return (IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG); }, true},
+            {System::Fonts, "SDL_ttf and font manager",
+             "Starting SDL_ttf and the core font manager...",
+             "SDL_ttf failed to initialize! Continuing with no font support.",
+             []() { return TTF_Init() == 0 && FontManager::access().start_up(); }, true},
+            {System::Video, "Video",
+             "Starting SDL2's Video subsystem...",
+             "Video failed to initialize!",
+             []() { return SDL_InitSubSystem(SDL_INIT_VIDEO) == 0; }, false},
+            {System::Audio, "Audio",
+             "Starting SDL2's Audio subsystem...",
+             "Audio playback failed to initialize!",
+             []() { return SDL_InitSubSystem(SDL_INIT_AUDIO) == 0; }, false},
+            {System::Events, "Events",
+             "Starting SDL2's Event handling subsystem...",
+             "Event handling failed to initialize!",
+             []() { return SDL_InitSubSystem(SDL_INIT_EVENTS) == 0; }, false},
+            {System::GameController, "Game controllers",
+             "Starting SDL2's Gamepad and Joystick Input subsystems...",
+             "Game Controller Input handling failed to initialize!",
+             []() { return SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) == 0; }, false},
+            {System::Haptic, "Haptic",
+             "Starting SDL2's Haptic Feedback subsystem...",
+             "Haptic Feedback failed to initialize!",
+             []() { return SDL_InitSubSystem(SDL_INIT_HAPTIC) == 0; }, false},
+            {System::Timer, "Timer",
+             "Starting SDL2's Timer subsystem...",
+             "Timers failed to initialize!",
+             []() { return SDL_InitSubSystem(SDL_INIT_TIMER) == 0; }, false},
+        };
+
+        std::atomic<System::Subsystems> RUNNING_SUBSYSTEMS{0};
+        std::atomic<System::Subsystems> FAILED_SUBSYSTEMS{0}; ///< Not retried until the next shut_down().
+        std::mutex                      STARTUP_MUTEX; ///< Held while subsystems are being started.
+
+        std::mutex                       TIMELINE_MUTEX;
+        std::vector<System::StartupStep> STARTUP_TIMELINE;
+        Clock::time_point                STARTUP_EPOCH;
+        std::thread::id                  MAIN_THREAD;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    static double MS_SINCE_STARTUP(Clock::time_point time) {
+        return std::chrono::duration<double, std::milli>(time - STARTUP_EPOCH).count();
     }
 
-    static void LOG_ERROR(const std::string& message) {
-        std::cerr << message << std::endl;
-        std::cerr << "SDL2 last reported: " << SDL_GetError() << std::endl;
+    /// Starts one subsystem, and records how long it took on the startup timeline.
+    static bool START_SUBSYSTEM(const SubsystemInfo& subsystem) {
+        LOG_INFO("%s", subsystem.start_message);
+        Clock::time_point start     = Clock::now();
+        bool              succeeded = subsystem.start();
+        Clock::time_point end       = Clock::now();
+        if (!succeeded) {
+            LOG_ERROR("%s SDL2 last reported: %s", subsystem.failure_message, SDL_GetError());
+            FAILED_SUBSYSTEMS.fetch_or(subsystem.flag);
+        } else {
+            RUNNING_SUBSYSTEMS.fetch_or(subsystem.flag);
+        }
+
+        std::lock_guard<std::mutex> lock(TIMELINE_MUTEX);
+        STARTUP_TIMELINE.push_back({subsystem.name, std::this_thread::get_id() == MAIN_THREAD ? "main" : "worker",
+                                    MS_SINCE_STARTUP(start), MS_SINCE_STARTUP(end) - MS_SINCE_STARTUP(start),
+                                    succeeded});
+        return succeeded;
     }
 
-    static void ASSERT_TASK(const std::function<bool()>& task,
-                            const std::optional<std::string>& start_message,
-                            const std::optional<std::string>& failure_message) {
-        if (start_message) {
-            LOG_STATUS(*start_message);
+    /// Starts every listed subsystem that isn't running yet. Call with STARTUP_MUTEX held.
+    static bool START_SUBSYSTEMS(System::Subsystems subsystems) {
+        std::atomic<bool> all_started{(subsystems & FAILED_SUBSYSTEMS.load()) == 0};
+        subsystems &= ~(RUNNING_SUBSYSTEMS.load() | FAILED_SUBSYSTEMS.load());
+        if (subsystems == 0) { return all_started; }
+
+        // The job system is first in the table and starts first, so the rest can be spread across its workers.
+        if ((subsystems & System::Jobs) && !START_SUBSYSTEM(SUBSYSTEMS[0])) { all_started = false; }
+
+        JobSystem::Counter background;
+        for (const SubsystemInfo& subsystem : SUBSYSTEMS) {
+            if ((subsystems & subsystem.flag) && subsystem.runs_on_worker) {
+                JobSystem::access().run([&subsystem, &all_started]() {
+                    if (!START_SUBSYSTEM(subsystem)) { all_started = false; }
+                }, &background);
+            }
         }
-        if (!task()) {
-            if (failure_message) {
-                LOG_ERROR(*failure_message);
+
+        for (const SubsystemInfo& subsystem : SUBSYSTEMS) {
+            if ((subsystems & subsystem.flag) && !subsystem.runs_on_worker && subsystem.flag != System::Jobs) {
+                if (!START_SUBSYSTEM(subsystem)) { all_started = false; }
             }
-            abort();
         }
-    }
 
-    static void LOG_TASK(const std::function<bool()>& task,
-                         const std::optional<std::string>& start_message,
-                         const std::optional<std::string>& failure_message) {
-        if (start_message) { LOG_STATUS(*start_message); }
-        if (!task() && failure_message) { LOG_ERROR(*failure_message); }
+        JobSystem::access().wait(background);
+        return all_started;
     }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -64,71 +156,104 @@ namespace Core {
         return m_core_system_initialized;
     }
 
-    bool System::start_up() {
+    bool System::start_up(Subsystems subsystems) {
 
         static System instance;
 
+        std::lock_guard<std::mutex> lock(STARTUP_MUTEX);
         if (!is_initialized()) {
-            // Initialize all core SDL subsystems.
-            ASSERT_TASK([]() { return SDL_InitSubSystem(SDL_INIT_VIDEO) == 0; },
-                        "Starting SDL2's Video subsystem...",
-                        "Video failed to initialize!");
-
-            ASSERT_TASK([]() -> bool { return SDL_InitSubSystem(SDL_INIT_AUDIO) == 0; },
-                        "Starting SDL2's Audio subsystem...",
-                        "Audio playback failed to initialize!");
-
-            ASSERT_TASK([]() { return SDL_InitSubSystem(SDL_INIT_EVENTS) == 0; },
-                        "Starting SDL2's Event handling subsystem...",
-                        "Event handling failed to initialize!");
-
-            ASSERT_TASK([]() { return SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) == 0; },
-                        "Starting SDL2's Gamepad and Joystick Input subsystems...",
-                        "Game Controller Input handling failed to initialize!");
-
-            ASSERT_TASK([]() { return SDL_InitSubSystem(SDL_INIT_HAPTIC) == 0; },
-                        "Starting SDL2's Haptic Feedback subsystem...",
-                        "Haptic Feedback failed to initialize!");
-
-            ASSERT_TASK([]() { return SDL_InitSubSystem(SDL_INIT_TIMER) == 0; },
-                        "Starting SDL2's Timer subsystem...",
-                        "Timers failed to initialize!");
-
-            // Initialize SDL_image optional subsystem.
-            LOG_TASK([]() { return ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)); },
-                     "Starting SDL_image, and configuring for PNG file loading...",
-                     "PNG file loader could not be initialized! Continuing with only basic SDL2 image file support");
-
-            // Initialize SDL_ttf optional subsystem.
-            LOG_TASK([]() { return TTF_Init() == 0; },
-                     "Starting SDL_ttf...",
-                     "SDL_ttf failed to initialize! Continuing with no font support.");
-
-            if (TTF_WasInit()) {
-                LOG_TASK([]() { return FontManager::access().start_up(); },
-                         "Starting core font manager...",
-                         "Font manager failed to initialize! Continuing with limited to no font support.");
-            }
+            Logger::access().start_up();
+            STARTUP_EPOCH = Clock::now();
+            MAIN_THREAD   = std::this_thread::get_id();
+            m_core_system_initialized = true;
         }
-        return m_core_system_initialized = true;
+        return START_SUBSYSTEMS(subsystems);
+    }
+
+    bool System::require(Subsystems subsystems) {
+        // Subsystems that already failed aren't retried, so there's nothing to lock for.
+        if ((subsystems & ~(RUNNING_SUBSYSTEMS.load() | FAILED_SUBSYSTEMS.load())) == 0) {
+            return is_running(subsystems);
+        }
+        if (!is_initialized()) { return start_up(subsystems); }
+
+        std::lock_guard<std::mutex> lock(STARTUP_MUTEX);
+        return START_SUBSYSTEMS(subsystems);
+    }
+
+    bool System::is_running(Subsystems subsystems) {
+        return (RUNNING_SUBSYSTEMS.load() & subsystems) == subsystems;
+    }
+
+    void System::use_headless_drivers() {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
     }
 
     void System::shut_down() {
+        std::lock_guard<std::mutex> lock(STARTUP_MUTEX);
         if (is_initialized()) {
-            LOG_STATUS("Shutting down core font manager...");
-            FontManager::access().shut_down();
+            if (is_running(Jobs)) {
+                LOG_INFO("Shutting down job system worker threads...");
+                JobSystem::access().shut_down();
+            }
 
-            LOG_STATUS("Shutting down the SDL_ttf...");
-            TTF_Quit();
+            if (is_running(Fonts)) {
+                LOG_INFO("Shutting down core font manager...");
+                FontManager::access().shut_down();
+            }
 
-            LOG_STATUS("Shutting down the SDL_image...");
-            IMG_Quit();
+            LOG_INFO("Shutting down core texture manager...");
+            TextureManager::access().shut_down();
 
-            LOG_STATUS("Shutting down the SDL2 library...");
+            if (is_running(Fonts)) {
+                LOG_INFO("Shutting down the SDL_ttf...");
+                TTF_Quit();
+            }
+
+            if (is_running(Images)) {
+                LOG_INFO("Shutting down the SDL_image...");
+                IMG_Quit();
+            }
+
+            LOG_INFO("Shutting down the SDL2 library...");
             SDL_Quit();
 
+            RUNNING_SUBSYSTEMS        = 0;
+            FAILED_SUBSYSTEMS         = 0;
             m_core_system_initialized = false;
+
+            // Anything logged from here on is written straight away.
+            Logger::access().shut_down();
+        }
+    }
+
+    std::vector<System::StartupStep> System::startup_timeline() {
+        std::lock_guard<std::mutex> lock(TIMELINE_MUTEX);
+        return STARTUP_TIMELINE;
+    }
+
+    void System::write_startup_report(std::ostream& out) {
+        std::vector<StartupStep> timeline = startup_timeline();
+
+        const std::ios_base::fmtflags previous_flags     = out.flags();
+        const std::streamsize         previous_precision = out.precision();
+
+        double finished_ms = 0.0;
+        double total_ms    = 0.0;
+        out << std::fixed << std::setprecision(3);
+        out << "Startup report:" << std::endl;
+        for (const StartupStep& step : timeline) {
+            finished_ms = std::max(finished_ms, step.start_ms + step.duration_ms);
+            total_ms += step.duration_ms;
+            out << "  " << (step.succeeded ? "" : "[FAILED] ") << std::left << std::setw(26) << step.name
+                << std::right << " " << std::setw(6) << step.thread << "  at " << std::setw(9) << step.start_ms
+                << " ms  took " << std::setw(9) << step.duration_ms << " ms" << std::endl;
         }
+        out << "  " << timeline.size() << " subsystems, " << total_ms << " ms of work finished "
+            << finished_ms << " ms after startup began" << std::endl;
+        out.flags(previous_flags);
+        out.precision(previous_precision);
     }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -138,4 +263,4 @@ namespace Core {
     System::System() = default;
     System::~System() { shut_down(); }
 
-} // Core namespace.
\ No newline at end of file
+} // Core namespace.
@@ -9,14 +9,75 @@
 #ifndef GOLD_CARTRIDGE_SYSTEM_H
 #define GOLD_CARTRIDGE_SYSTEM_H
 
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
 namespace Core {
 
     class System {
+    public:
+        /// Parts of the framework and SDL that can be started separately. Combine them with |.
+        enum Subsystem : std::uint32_t {
+            Video          = 1u << 0,
+            Audio          = 1u << 1,
+            Events         = 1u << 2,
+            GameController = 1u << 3, ///< Gamepads and joysticks.
+            Haptic         = 1u << 4,
+            Timer          = 1u << 5,
+            Jobs           = 1u << 6, ///< The job system's worker threads.
+            Images         = 1u << 7, ///< SDL_image, set up for PNG files.
+            Fonts          = 1u << 8, ///< SDL_ttf and the core font manager.
+
+            /// What a typical windowed application needs. Audio, gamepads and haptics are left to start on demand.
+            Default    = Video | Events | Timer | Jobs | Images | Fonts,
+            Everything = Default | Audio | GameController | Haptic,
+        };
+        using Subsystems = std::uint32_t;
+
+        /// When and where one subsystem was started, relative to the first start_up() call.
+        struct StartupStep {
+            std::string name;
+            std::string thread;      ///< "main" or "worker".
+            double      start_ms;
+            double      duration_ms;
+            bool        succeeded;
+        };
+
     public:
         static bool is_initialized();
-        static bool start_up();
+
+        /**
+         * Starts the given subsystems. Images and fonts are set up on job system workers while SDL's own
+         * subsystems start on the calling thread, which should be the main thread.
+         * @param subsystems The subsystems the application needs up front. Others start when first required.
+         * @return False if any of them failed to start. The rest are still usable.
+         */
+        static bool start_up(Subsystems subsystems = Default);
+
+        /**
+         * Starts any of the given subsystems that aren't running yet. Parts of the framework call this before
+         * first using a subsystem, so it's cheap when they're already running. Video and Events must be
+         * required from the main thread.
+         * @return True if all of them are running.
+         */
+        static bool require(Subsystems subsystems);
+
+        /// True if every one of the given subsystems is running.
+        static bool is_running(Subsystems subsystems);
         static void shut_down();
 
+        /**
+         * Makes SDL use its "dummy" video and audio drivers so start_up() works on machines without a
+         * display or sound card. Must be called before start_up(). Pair with a headless Rendering::Window.
+         */
+        static void use_headless_drivers();
+
+        /// Every subsystem started so far, in the order they finished.
+        static std::vector<StartupStep> startup_timeline();
+        static void write_startup_report(std::ostream& out);
+
         System(const System&) = delete;
         void operator=(const System&) = delete;
 
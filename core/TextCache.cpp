@@ -0,0 +1,157 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "TextCache.h"
+
+#include <functional>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    static std::uint32_t PACK_COLOR(const SDL_Color& color) {
+        return (std::uint32_t(color.r) << 24) | (std::uint32_t(color.g) << 16) |
+               (std::uint32_t(color.b) << 8) | std::uint32_t(color.a);
+    }
+
+    static std::size_t TEXTURE_BYTES(SDL_Texture* texture) {
+        int w = 0, h = 0;
+        SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+        return static_cast<std::size_t>(w) * h * 4;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    TextCache::TextCache(std::size_t byte_budget) : m_budget(byte_budget) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    double TextCache::Stats::hit_rate() const {
+        const std::uint64_t lookups = hits + misses;
+        return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+
+    TextCache::TexturePtr
+    TextCache::find(SDL_Renderer* renderer, std::string_view text, const FontPtr& font, const SDL_Color& color) {
+        auto found = m_index.find(KeyView{text, font.get(), PACK_COLOR(color), renderer});
+        if (found == m_index.end()) {
+            m_stats.misses++;
+            return nullptr;
+        }
+
+        // A closed font's address may have been reused by a new one, so its entries are stale.
+        EntryList::iterator entry = found->second;
+        if (entry->font.expired()) {
+            erase(entry);
+            m_stats.misses++;
+            return nullptr;
+        }
+
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+        m_stats.hits++;
+        return entry->texture;
+    }
+
+    void TextCache::insert(SDL_Renderer* renderer, std::string_view text, const FontPtr& font,
+                           const SDL_Color& color, TexturePtr texture) {
+        if (!texture) { return; }
+
+        const std::size_t bytes = TEXTURE_BYTES(texture.get());
+        if (bytes > m_budget) { return; }
+
+        auto existing = m_index.find(KeyView{text, font.get(), PACK_COLOR(color), renderer});
+        if (existing != m_index.end()) { erase(existing->second); }
+        trim_to(m_budget - bytes);
+
+        m_entries.push_front(Entry{std::string(text), {}, font, std::move(texture), bytes});
+        Entry& entry = m_entries.front();
+        entry.key = KeyView{entry.text, font.get(), PACK_COLOR(color), renderer};
+        m_index.emplace(entry.key, m_entries.begin());
+        m_stats.bytes += bytes;
+        m_stats.entries++;
+    }
+
+    void TextCache::invalidate(SDL_Renderer* renderer, std::string_view text, const FontPtr& font,
+                               const SDL_Color& color) {
+        auto found = m_index.find(KeyView{text, font.get(), PACK_COLOR(color), renderer});
+        if (found != m_index.end()) { erase(found->second); }
+    }
+
+    void TextCache::invalidate(std::string_view text, const FontPtr& font, const SDL_Color& color) {
+        const std::uint32_t packed_color = PACK_COLOR(color);
+        for (auto entry = m_entries.begin(); entry != m_entries.end();) {
+            auto next = std::next(entry);
+            if (entry->key.text == text && entry->key.font == font.get() && entry->key.color == packed_color) {
+                erase(entry);
+            }
+            entry = next;
+        }
+    }
+
+    void TextCache::release_renderer(SDL_Renderer* renderer) {
+        for (auto entry = m_entries.begin(); entry != m_entries.end();) {
+            auto next = std::next(entry);
+            if (entry->key.renderer == renderer) { erase(entry); }
+            entry = next;
+        }
+    }
+
+    void TextCache::clear() {
+        m_index.clear();
+        m_entries.clear();
+        m_stats.bytes   = 0;
+        m_stats.entries = 0;
+    }
+
+    std::size_t TextCache::budget() const { return m_budget; }
+
+    void TextCache::budget(std::size_t new_byte_budget) {
+        m_budget = new_byte_budget;
+        trim_to(m_budget);
+    }
+
+    TextCache::Stats TextCache::stats() const {
+        Stats stats  = m_stats;
+        stats.budget = m_budget;
+        return stats;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    std::size_t TextCache::KeyHash::operator()(const KeyView& key) const {
+        std::size_t hash = std::hash<std::string_view>{}(key.text);
+        auto        mix  = [&hash](std::size_t value) { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+        mix(std::hash<const void*>{}(key.font));
+        mix(key.color);
+        mix(std::hash<const void*>{}(key.renderer));
+        return hash;
+    }
+
+    void TextCache::erase(EntryList::iterator entry) {
+        m_stats.bytes -= entry->bytes;
+        m_stats.entries--;
+        m_index.erase(entry->key);
+        m_entries.erase(entry);
+    }
+
+    void TextCache::trim_to(std::size_t byte_budget) {
+        while (m_stats.bytes > byte_budget && !m_entries.empty()) {
+            erase(std::prev(m_entries.end()));
+            m_stats.evictions++;
+        }
+    }
+
+} // Core
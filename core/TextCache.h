@@ -0,0 +1,119 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_TEXT_CACHE_H
+#define GOLD_CARTRIDGE_TEXT_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <SDL_render.h>
+#include <SDL_ttf.h>
+
+namespace Core {
+
+    /**
+     * @brief A least-recently-used cache of whole strings rendered to textures.
+     *
+     * Entries are keyed by text, font, color, and renderer, and the cache keeps
+     * the total size of its textures under a byte budget by dropping the
+     * entries that went unused the longest. Textures are handed out as shared
+     * pointers, so dropping an entry never destroys a texture still held
+     * elsewhere.
+     */
+    class TextCache {
+    public:
+        using TexturePtr = std::shared_ptr<SDL_Texture>;
+        using FontPtr = std::shared_ptr<TTF_Font>;
+
+        struct Stats {
+            std::size_t   entries   = 0;
+            std::size_t   bytes     = 0;
+            std::size_t   budget    = 0;
+            std::uint64_t hits      = 0;
+            std::uint64_t misses    = 0;
+            std::uint64_t evictions = 0;
+
+            double hit_rate() const;
+        };
+
+    public:
+        explicit TextCache(std::size_t byte_budget);
+
+        TextCache(const TextCache&) = delete;
+        void operator=(const TextCache&) = delete;
+
+        /**
+         * Looks up a rendered string, marking it as the most recently used.
+         * @return The cached texture, or null on a miss.
+         */
+        TexturePtr find(SDL_Renderer* renderer, std::string_view text, const FontPtr& font, const SDL_Color& color);
+
+        /**
+         * Adds a rendered string, evicting older entries until it fits the budget.
+         * Textures larger than the whole budget are not cached.
+         */
+        void insert(SDL_Renderer* renderer, std::string_view text, const FontPtr& font, const SDL_Color& color,
+                    TexturePtr texture);
+
+        /// Drops one renderer's entry for a string, if it has one. A single lookup, so it suits a label changing.
+        void invalidate(SDL_Renderer* renderer, std::string_view text, const FontPtr& font, const SDL_Color& color);
+
+        /**
+         * Drops a string's entries on every renderer. Walks every entry, so it suits rare changes such as
+         * reloading a font.
+         */
+        void invalidate(std::string_view text, const FontPtr& font, const SDL_Color& color);
+        void release_renderer(SDL_Renderer* renderer);
+        void clear();
+
+        std::size_t budget() const;
+        void budget(std::size_t new_byte_budget);
+        Stats stats() const;
+
+    private:
+        struct KeyView {
+            std::string_view text;
+            TTF_Font*        font;
+            std::uint32_t    color;
+            SDL_Renderer*    renderer;
+
+            bool operator==(const KeyView& other) const = default;
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const KeyView& key) const;
+        };
+
+        struct Entry {
+            std::string             text; ///< Owns the characters the index key points at.
+            KeyView                 key;
+            std::weak_ptr<TTF_Font> font;
+            TexturePtr              texture;
+            std::size_t             bytes;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        void erase(EntryList::iterator entry);
+        void trim_to(std::size_t byte_budget);
+
+    private:
+        EntryList                                                 m_entries; ///< Most recently used first.
+        std::unordered_map<KeyView, EntryList::iterator, KeyHash> m_index;
+        std::size_t                                               m_budget;
+        Stats                                                     m_stats;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_TEXT_CACHE_H
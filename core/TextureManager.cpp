@@ -0,0 +1,275 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "TextureManager.h"
+#include "JobSystem.h"
+#include "Logger.h"
+#include "System.h"
+#include "PixelOps.h"
+#include "TexturePixels.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <SDL_image.h>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    static const Uint32      TEXTURE_FORMAT        = SDL_PIXELFORMAT_ARGB8888;
+    static const std::size_t DEFAULT_UPLOAD_BUDGET = 4 * 1024 * 1024;
+    static const int         PLACEHOLDER_SIZE      = 8;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    TextureManager::Entry::~Entry() {
+        if (surface) { SDL_FreeSurface(surface); }
+    }
+
+    TextureManager::Handle::Handle(std::shared_ptr<Entry> entry) : m_entry(std::move(entry)) {}
+
+    TextureManager::TextureManager()
+            : m_upload_budget(DEFAULT_UPLOAD_BUDGET),
+              m_pending_decodes(0),
+              m_uploads(0),
+              m_bytes_uploaded(0),
+              m_failures(0) {}
+
+    TextureManager::~TextureManager() { shut_down(); }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Handle Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    SDL_Texture* TextureManager::Handle::texture() const { return shared_texture().get(); }
+
+    TextureManager::TexturePtr TextureManager::Handle::shared_texture() const {
+        if (!m_entry || m_entry->released.load(std::memory_order_acquire)) { return nullptr; }
+        if (is_ready()) { return m_entry->texture; }
+        return TextureManager::access().placeholder(m_entry->renderer);
+    }
+
+    bool TextureManager::Handle::is_ready() const {
+        return m_entry && m_entry->state.load(std::memory_order_acquire) == State::Ready;
+    }
+
+    bool TextureManager::Handle::has_failed() const {
+        return m_entry && m_entry->state.load(std::memory_order_acquire) == State::Failed;
+    }
+
+    int TextureManager::Handle::width() const {
+        return (m_entry && m_entry->state.load(std::memory_order_acquire) != State::Decoding) ? m_entry->width : 0;
+    }
+
+    int TextureManager::Handle::height() const {
+        return (m_entry && m_entry->state.load(std::memory_order_acquire) != State::Decoding) ? m_entry->height : 0;
+    }
+
+    const std::string& TextureManager::Handle::path() const {
+        static const std::string no_path;
+        return m_entry ? m_entry->path : no_path;
+    }
+
+    TextureManager::Handle::operator bool() const { return m_entry != nullptr; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    TextureManager& TextureManager::access() {
+        static TextureManager instance;
+        return instance;
+    }
+
+    TextureManager::Handle TextureManager::load(SDL_Renderer* renderer, const std::string& path) {
+        System::require(System::Images | System::Jobs);
+
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::weak_ptr<Entry>&       known = m_entries[{renderer, path}];
+            if ((entry = known.lock())) { return Handle(entry); }
+
+            entry           = std::make_shared<Entry>();
+            entry->path     = path;
+            entry->renderer = renderer;
+            known           = entry;
+        }
+
+        // Without job system workers this decodes right away, so the lock has to be released first.
+        m_pending_decodes++;
+        JobSystem::access().run([this, entry]() { decode(entry); });
+        return Handle(entry);
+    }
+
+    int TextureManager::upload_pending(SDL_Renderer* renderer) {
+        std::size_t budget_used = 0;
+        int         uploaded    = 0;
+        while (true) {
+            std::shared_ptr<Entry> entry;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto next = std::find_if(m_decoded.begin(), m_decoded.end(),
+                                         [&](const auto& decoded) { return decoded->renderer == renderer; });
+                if (next == m_decoded.end()) { break; }
+
+                std::size_t bytes = static_cast<std::size_t>((*next)->surface->pitch) * (*next)->height;
+                if (uploaded > 0 && budget_used + bytes > m_upload_budget) { break; }
+
+                entry = std::move(*next);
+                m_decoded.erase(next);
+                budget_used += bytes;
+            }
+
+            // Every handle was dropped while the image was decoding. Nobody is left to draw it.
+            if (entry.use_count() == 1) { continue; }
+            if (upload(*entry)) { uploaded++; }
+        }
+        return uploaded;
+    }
+
+    std::size_t TextureManager::upload_budget() const { return m_upload_budget; }
+    void TextureManager::upload_budget(std::size_t bytes_per_frame) { m_upload_budget = bytes_per_frame; }
+
+    void TextureManager::release_renderer(SDL_Renderer* renderer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto entry = m_entries.begin(); entry != m_entries.end();) {
+            if (entry->first.first != renderer) {
+                ++entry;
+                continue;
+            }
+            // Handles that outlive the renderer keep their entry, but lose a texture that's about to be invalid.
+            // A decode still running for it sees the flag and throws its result away.
+            if (std::shared_ptr<Entry> live = entry->second.lock()) {
+                live->released.store(true, std::memory_order_release);
+                live->texture.reset();
+                live->state = State::Failed;
+            }
+            entry = m_entries.erase(entry);
+        }
+        m_decoded.erase(std::remove_if(m_decoded.begin(), m_decoded.end(),
+                                       [&](const auto& decoded) { return decoded->renderer == renderer; }),
+                        m_decoded.end());
+        m_placeholders.erase(renderer);
+    }
+
+    void TextureManager::shut_down() {
+        std::vector<SDL_Renderer*> renderers;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& [key, entry] : m_entries) { renderers.push_back(key.first); }
+            for (auto& [renderer, texture] : m_placeholders) { renderers.push_back(renderer); }
+        }
+        for (SDL_Renderer* renderer : renderers) { release_renderer(renderer); }
+    }
+
+    TextureManager::Stats TextureManager::stats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::erase_if(m_entries, [](const auto& entry) { return entry.second.expired(); });
+
+        Stats stats;
+        stats.textures        = m_entries.size();
+        stats.pending_decodes = m_pending_decodes.load();
+        stats.pending_uploads = m_decoded.size();
+        stats.uploads         = m_uploads.load();
+        stats.bytes_uploaded  = m_bytes_uploaded.load();
+        stats.failures        = m_failures.load();
+        return stats;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void TextureManager::decode(const std::shared_ptr<Entry>& entry) {
+        SDL_Surface* loaded = IMG_Load(entry->path.c_str());
+        SDL_Surface* converted = nullptr;
+        if (loaded) {
+            // Converting here, off the render thread, leaves the upload a plain copy. PNGs and most other 32 bit
+            // images only need their channels moved, which PixelOps does several pixels at a time.
+            converted = PixelOps::to_argb8888(loaded);
+            SDL_FreeSurface(loaded);
+        }
+
+        if (!converted) {
+            LOG_ERROR("Could not load image \"%s\": %s", entry->path.c_str(), SDL_GetError());
+            m_failures++;
+            entry->state.store(State::Failed, std::memory_order_release);
+        } else {
+            // Checked under the lock release_renderer() holds, so a released entry is never queued for upload.
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (entry->released.load(std::memory_order_relaxed)) {
+                SDL_FreeSurface(converted);
+            } else {
+                entry->surface = converted;
+                entry->width   = converted->w;
+                entry->height  = converted->h;
+                entry->state.store(State::Decoded, std::memory_order_release);
+
+                // Once queued, the render thread may upload it at any moment.
+                m_decoded.push_back(entry);
+            }
+        }
+        m_pending_decodes--;
+    }
+
+    bool TextureManager::upload(Entry& entry) {
+        SDL_Texture* texture = SDL_CreateTexture(entry.renderer, TEXTURE_FORMAT, SDL_TEXTUREACCESS_STATIC,
+                                                 entry.width, entry.height);
+        if (!texture || SDL_UpdateTexture(texture, nullptr, entry.surface->pixels, entry.surface->pitch) != 0) {
+            LOG_ERROR("Could not upload image \"%s\": %s", entry.path.c_str(), SDL_GetError());
+            if (texture) { SDL_DestroyTexture(texture); }
+            m_failures++;
+            entry.state.store(State::Failed, std::memory_order_release);
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        m_uploads++;
+        m_bytes_uploaded += static_cast<std::uint64_t>(entry.surface->pitch) * entry.height;
+
+        // The decoded pixels are only worth keeping where textures are drawn in software.
+        std::shared_ptr<SDL_Surface> pixels;
+        if (TexturePixels::access().is_kept_for(entry.renderer)) {
+            pixels.reset(entry.surface, SDL_FreeSurface);
+        } else {
+            SDL_FreeSurface(entry.surface);
+        }
+        entry.surface = nullptr;
+        entry.texture = TexturePixels::access().adopt(texture, std::move(pixels));
+        entry.state.store(State::Ready, std::memory_order_release);
+        return true;
+    }
+
+    TextureManager::TexturePtr TextureManager::placeholder(SDL_Renderer* renderer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TexturePtr&                 texture = m_placeholders[renderer];
+        if (texture) { return texture; }
+
+        // The classic "missing texture" magenta and black checkerboard, so unloaded images are easy to spot.
+        Uint32 pixels[PLACEHOLDER_SIZE * PLACEHOLDER_SIZE];
+        for (int y = 0; y < PLACEHOLDER_SIZE; y++) {
+            for (int x = 0; x < PLACEHOLDER_SIZE; x++) {
+                pixels[y * PLACEHOLDER_SIZE + x] = ((x / 4 + y / 4) % 2 == 0) ? 0xFFFF00FF : 0xFF000000;
+            }
+        }
+        SDL_Texture* created = SDL_CreateTexture(renderer, TEXTURE_FORMAT, SDL_TEXTUREACCESS_STATIC,
+                                                 PLACEHOLDER_SIZE, PLACEHOLDER_SIZE);
+        if (created) {
+            SDL_UpdateTexture(created, nullptr, pixels, PLACEHOLDER_SIZE * static_cast<int>(sizeof(Uint32)));
+            texture.reset(created, SDL_DestroyTexture);
+        }
+        return texture;
+    }
+
+} // Core
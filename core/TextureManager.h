@@ -0,0 +1,151 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_TEXTURE_MANAGER_H
+#define GOLD_CARTRIDGE_TEXTURE_MANAGER_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <SDL_render.h>
+#include <SDL_surface.h>
+
+namespace Core {
+
+    /**
+     * @brief Loads image files into textures without stalling the frame.
+     *
+     * Files are decoded on job system workers and converted to the pixel
+     * format textures are created in, so all the render thread has left to do
+     * is copy the pixels into a texture. Those copies happen in
+     * upload_pending(), a few per frame, within a byte budget. Until its
+     * texture is ready, a handle draws as a placeholder checkerboard. Asking
+     * for the same file on the same renderer again returns the same texture,
+     * and it's freed once the last handle to it is gone.
+     */
+    class TextureManager {
+    public:
+        using TexturePtr = std::shared_ptr<SDL_Texture>;
+
+    private:
+        enum class State : std::uint8_t { Decoding, Decoded, Ready, Failed };
+
+        struct Entry {
+            std::string        path;
+            SDL_Renderer*      renderer;
+            std::atomic<State> state{State::Decoding};
+            std::atomic<bool>  released{false}; ///< Its renderer was released. Set under the manager's mutex.
+            SDL_Surface*       surface = nullptr; ///< Decoded pixels, waiting for upload.
+            TexturePtr         texture;
+            int                width  = 0;
+            int                height = 0;
+
+            ~Entry();
+        };
+
+    public:
+        /// A shared reference to a texture that may still be loading.
+        class Handle {
+        public:
+            Handle() = default;
+
+            /**
+             * The loaded texture, or the placeholder if it isn't ready. Only use it on the render thread.
+             * Null once the renderer it was loaded for has been released.
+             */
+            SDL_Texture* texture() const;
+            TexturePtr shared_texture() const;
+
+            bool is_ready() const;
+            bool has_failed() const;
+
+            /// Size of the image, or zero until it has been decoded.
+            int width() const;
+            int height() const;
+            const std::string& path() const;
+
+            explicit operator bool() const;
+
+        private:
+            friend class TextureManager;
+            explicit Handle(std::shared_ptr<Entry> entry);
+
+            std::shared_ptr<Entry> m_entry;
+        };
+
+        struct Stats {
+            std::size_t   textures        = 0; ///< Files with at least one handle.
+            std::size_t   pending_decodes = 0;
+            std::size_t   pending_uploads = 0;
+            std::uint64_t uploads         = 0;
+            std::uint64_t bytes_uploaded  = 0;
+            std::uint64_t failures        = 0;
+        };
+
+    public:
+        static TextureManager& access();
+
+        /**
+         * Starts loading an image file, or finds it if it's already loaded or loading.
+         * @param renderer The renderer the texture will be drawn with.
+         * @param path The image file to load. Any format SDL_image was started with.
+         * @return A handle that shows a placeholder until the image is ready.
+         */
+        Handle load(SDL_Renderer* renderer, const std::string& path);
+
+        /**
+         * Turns decoded images into textures. Call once per frame on the render thread. Window does this
+         * before the user draw callback.
+         * @param renderer The renderer to upload textures for.
+         * @return The number of textures uploaded.
+         */
+        int upload_pending(SDL_Renderer* renderer);
+
+        /// At least one texture is uploaded per frame, even if it alone is over the budget.
+        std::size_t upload_budget() const;
+        void upload_budget(std::size_t bytes_per_frame);
+
+        /// Forgets every texture made for a renderer. Call before destroying the renderer.
+        void release_renderer(SDL_Renderer* renderer);
+        void shut_down();
+        Stats stats();
+
+        TextureManager(const TextureManager&) = delete;
+        void operator=(const TextureManager&) = delete;
+
+    private:
+        TextureManager();
+        ~TextureManager();
+
+        void decode(const std::shared_ptr<Entry>& entry);
+        bool upload(Entry& entry);
+        TexturePtr placeholder(SDL_Renderer* renderer);
+
+    private:
+        using EntryKey = std::pair<SDL_Renderer*, std::string>;
+
+        std::mutex                               m_mutex;
+        std::map<EntryKey, std::weak_ptr<Entry>> m_entries;
+        std::deque<std::shared_ptr<Entry>>       m_decoded; ///< Waiting for upload_pending().
+        std::map<SDL_Renderer*, TexturePtr>      m_placeholders;
+        std::size_t                              m_upload_budget;
+        std::atomic<std::size_t>                 m_pending_decodes;
+        std::atomic<std::uint64_t>               m_uploads;
+        std::atomic<std::uint64_t>               m_bytes_uploaded;
+        std::atomic<std::uint64_t>               m_failures;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_TEXTURE_MANAGER_H
@@ -0,0 +1,77 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "TexturePixels.h"
+
+#include <algorithm>
+
+namespace Core {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    TexturePixels& TexturePixels::access() {
+        // Never destroyed, since textures held by other statics may still be going away after it would be.
+        static TexturePixels* instance = new TexturePixels();
+        return *instance;
+    }
+
+    void TexturePixels::keep_for(SDL_Renderer* renderer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (renderer && std::find(m_kept_renderers.begin(), m_kept_renderers.end(), renderer) ==
+                        m_kept_renderers.end()) {
+            m_kept_renderers.push_back(renderer);
+        }
+    }
+
+    void TexturePixels::release_renderer(SDL_Renderer* renderer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_kept_renderers.erase(std::remove(m_kept_renderers.begin(), m_kept_renderers.end(), renderer),
+                               m_kept_renderers.end());
+    }
+
+    bool TexturePixels::is_kept_for(SDL_Renderer* renderer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return renderer && std::find(m_kept_renderers.begin(), m_kept_renderers.end(), renderer) !=
+                           m_kept_renderers.end();
+    }
+
+    TexturePixels::TexturePtr TexturePixels::adopt(SDL_Texture* texture, SurfacePtr pixels) {
+        if (!texture) { return nullptr; }
+        if (!pixels) { return {texture, SDL_DestroyTexture}; }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pixels[texture] = std::move(pixels);
+        }
+        // Detached before SDL frees the texture, so a new texture at the same address can't pick the pixels up.
+        return {texture, [](SDL_Texture* old) {
+            TexturePixels::access().detach(old);
+            SDL_DestroyTexture(old);
+        }};
+    }
+
+    TexturePixels::SurfacePtr TexturePixels::find(SDL_Texture* texture) {
+        if (!texture) { return nullptr; }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_pixels.find(texture);
+        return found != m_pixels.end() ? found->second : nullptr;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void TexturePixels::detach(SDL_Texture* texture) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pixels.erase(texture);
+    }
+
+} // Core
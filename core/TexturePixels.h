@@ -0,0 +1,77 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_TEXTURE_PIXELS_H
+#define GOLD_CARTRIDGE_TEXTURE_PIXELS_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_render.h>
+#include <SDL_surface.h>
+
+namespace Core {
+
+    /**
+     * @brief Remembers the pixels textures were made from, for drawing them without the GPU.
+     *
+     * SDL can't read a texture back. Something that draws textures in memory,
+     * like Rendering::SoftwareRasterizer, asks for the renderer it presents to
+     * to be kept with keep_for(). The texture loaders (text, glyph atlases,
+     * sprite atlases and TextureManager) then hold on to an ARGB8888 copy of
+     * what each texture made for that renderer holds, and attach it here with
+     * adopt(). Glyph and sprite atlases keep their pixels anyway, so theirs are
+     * attached for every renderer. Every call is safe from any thread.
+     */
+    class TexturePixels {
+    public:
+        using TexturePtr = std::shared_ptr<SDL_Texture>;
+        using SurfacePtr = std::shared_ptr<SDL_Surface>;
+
+    public:
+        static TexturePixels& access();
+
+        /// Starts keeping the pixels of textures made for a renderer from now on.
+        void keep_for(SDL_Renderer* renderer);
+
+        /// Stops keeping pixels for a renderer. Call before destroying it. Pixels already kept go with their textures.
+        void release_renderer(SDL_Renderer* renderer);
+
+        /// Whether textures made for a renderer should have their pixels attached.
+        bool is_kept_for(SDL_Renderer* renderer);
+
+        /**
+         * Takes ownership of a texture, and attaches pixels to it for as long as it lasts.
+         * @param texture The texture. Null gives null.
+         * @param pixels An ARGB8888 surface holding what the texture holds, or null to attach nothing.
+         * @return The texture, destroyed with SDL_DestroyTexture once the last reference to it is gone.
+         */
+        TexturePtr adopt(SDL_Texture* texture, SurfacePtr pixels);
+
+        /// The pixels attached to a texture, or null. Holding on to them keeps them valid after the texture goes.
+        SurfacePtr find(SDL_Texture* texture);
+
+        TexturePixels(const TexturePixels&) = delete;
+        void operator=(const TexturePixels&) = delete;
+
+    private:
+        TexturePixels() = default;
+
+        void detach(SDL_Texture* texture);
+
+    private:
+        std::mutex                                   m_mutex;
+        std::vector<SDL_Renderer*>                   m_kept_renderers;
+        std::unordered_map<SDL_Texture*, SurfacePtr> m_pixels;
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_TEXTURE_PIXELS_H
@@ -0,0 +1,97 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_TRIPLE_BUFFER_H
+#define GOLD_CARTRIDGE_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Core {
+
+    /**
+     * @brief Hands whole values from one writer thread to one reader thread without locks or waiting.
+     *
+     * The writer fills its own buffer and publishes it. The reader picks up
+     * the most recently published buffer whenever it likes. The third buffer
+     * sits between them, so neither side ever waits for the other. A value
+     * published while the reader was busy with an older one simply replaces
+     * it. Values that are published but never read are skipped, never queued.
+     *
+     * Exactly one thread may write and exactly one thread may read.
+     */
+    template <typename T>
+    class TripleBuffer {
+    public:
+        explicit TripleBuffer(const T& initial_value = T{})
+                : m_buffers{Slot{initial_value}, Slot{initial_value}, Slot{initial_value}},
+                  m_write_index(0),
+                  m_shared_state(1),
+                  m_read_index(2) {}
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        void operator=(const TripleBuffer&) = delete;
+
+        /**
+         * The writer's buffer. After a publish() it holds an older value, not the one just published, so
+         * rewrite it completely before publishing it again.
+         */
+        T& write_buffer() { return m_buffers[m_write_index].value; }
+
+        /// Makes the write buffer's value the latest for the reader, and takes a free buffer to write next.
+        void publish() {
+            std::uint8_t previous = m_shared_state.exchange(m_write_index | FRESH_BIT, std::memory_order_acq_rel);
+            m_write_index = previous & INDEX_MASK;
+        }
+
+        /// Copies a value into the write buffer and publishes it.
+        void publish(const T& value) {
+            write_buffer() = value;
+            publish();
+        }
+
+        /**
+         * Swaps in the latest published value, if there is one the reader hasn't seen.
+         * @return True if read_buffer() now holds a newer value.
+         */
+        bool fetch() {
+            if (!(m_shared_state.load(std::memory_order_relaxed) & FRESH_BIT)) { return false; }
+            std::uint8_t previous = m_shared_state.exchange(m_read_index, std::memory_order_acq_rel);
+            m_read_index = previous & INDEX_MASK;
+            return true;
+        }
+
+        /// The reader's buffer. It only changes when the reader calls fetch().
+        const T& read_buffer() const { return m_buffers[m_read_index].value; }
+
+        /// Fetches, then returns the newest value the reader has.
+        const T& latest() {
+            fetch();
+            return read_buffer();
+        }
+
+    private:
+        static constexpr std::uint8_t INDEX_MASK = 0x3;
+        static constexpr std::uint8_t FRESH_BIT  = 0x4; ///< Set while the shared buffer holds an unread value.
+
+        /// Buffers sit on their own cache lines so the two threads don't slow each other down.
+        struct alignas(64) Slot {
+            T value;
+        };
+
+    private:
+        std::array<Slot, 3>                   m_buffers;
+        std::uint8_t                          m_write_index;  ///< Only touched by the writer.
+        alignas(64) std::atomic<std::uint8_t> m_shared_state; ///< Index of the middle buffer, plus FRESH_BIT.
+        alignas(64) std::uint8_t              m_read_index;   ///< Only touched by the reader.
+    };
+
+} // Core
+
+#endif //GOLD_CARTRIDGE_TRIPLE_BUFFER_H
@@ -0,0 +1,281 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "BatchRenderer.h"
+#include "SoftwareRasterizer.h"
+#include "../core/TexturePixels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace Rendering {
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    static int ROUND(float value) { return static_cast<int>(std::lround(value)); }
+
+    static bool SAME_COLOR(const SDL_Color& a, const SDL_Color& b) {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+
+    /**
+     * Records one quad of the batch into a rasterizer, if it's one the rasterizer can draw: an axis-aligned
+     * rectangle in one color, sampling its texture, if it has one, at one texel per pixel.
+     * @param quad Six indices, for the corners top left, top right, bottom right, top left, bottom right and
+     *             bottom left, as append_quad(), add_quads() and glyph layout give them.
+     * @return False if the quad couldn't be recorded.
+     */
+    static bool RECORD_QUAD(SoftwareRasterizer& rasterizer, const SDL_Vertex* vertices, const int* quad,
+                            SDL_Texture* texture, const SoftwareRasterizer::Image& image) {
+        if (quad[3] != quad[0] || quad[4] != quad[2]) { return false; }
+
+        const SDL_Vertex& top_left     = vertices[quad[0]];
+        const SDL_Vertex& top_right    = vertices[quad[1]];
+        const SDL_Vertex& bottom_right = vertices[quad[2]];
+        const SDL_Vertex& bottom_left  = vertices[quad[5]];
+        if (top_left.position.y != top_right.position.y || bottom_left.position.y != bottom_right.position.y ||
+            top_left.position.x != bottom_left.position.x || top_right.position.x != bottom_right.position.x ||
+            !SAME_COLOR(top_left.color, bottom_right.color)) {
+            return false;
+        }
+
+        SDL_Rect dest{ROUND(top_left.position.x), ROUND(top_left.position.y), 0, 0};
+        dest.w = ROUND(bottom_right.position.x) - dest.x;
+        dest.h = ROUND(bottom_right.position.y) - dest.y;
+        if (dest.w < 0 || dest.h < 0) { return false; }
+
+        if (!texture) {
+            rasterizer.fill_rect(dest, top_left.color);
+            return true;
+        }
+        if (!image.pixels) { return false; }
+
+        const auto width  = static_cast<float>(image.width);
+        const auto height = static_cast<float>(image.height);
+        SDL_Rect   source{ROUND(top_left.tex_coord.x * width), ROUND(top_left.tex_coord.y * height), 0, 0};
+        source.w = ROUND(bottom_right.tex_coord.x * width) - source.x;
+        source.h = ROUND(bottom_right.tex_coord.y * height) - source.y;
+        if (source.w != dest.w || source.h != dest.h) { return false; }
+
+        rasterizer.blit(image, source, dest.x, dest.y, top_left.color);
+        return true;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    BatchRenderer::BatchRenderer(SDL_Renderer* renderer) : m_renderer(renderer) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    SDL_Renderer* BatchRenderer::renderer() const { return m_renderer; }
+
+    void BatchRenderer::fill_rect(const SDL_Rect& area, const SDL_Color& color, int layer) {
+        append_quad(nullptr, {0, 0, 0, 0}, area, layer, color);
+    }
+
+    void BatchRenderer::copy(const TexturePtr& texture, const SDL_Rect& source, const SDL_Rect& dest, int layer,
+                             const SDL_Color& tint) {
+        if (!texture) { return; }
+        m_retained_textures.push_back(texture);
+        copy(texture.get(), source, dest, layer, tint);
+    }
+
+    void BatchRenderer::copy(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest, int layer,
+                             const SDL_Color& tint) {
+        if (!texture) { return; }
+        append_quad(texture, source, dest, layer, tint);
+    }
+
+    void BatchRenderer::geometry(const TexturePtr& texture, const SDL_Vertex* vertices, int vertex_count,
+                                 const int* indices, int index_count, int layer) {
+        if (texture) { m_retained_textures.push_back(texture); }
+        geometry(texture.get(), vertices, vertex_count, indices, index_count, layer);
+    }
+
+    void BatchRenderer::geometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertex_count,
+                                 const int* indices, int index_count, int layer) {
+        if (index_count <= 0) { return; }
+
+        const int first_vertex = static_cast<int>(m_vertices.size());
+        const int first_index  = static_cast<int>(m_indices.size());
+        m_vertices.insert(m_vertices.end(), vertices, vertices + vertex_count);
+        for (int i = 0; i < index_count; i++) { m_indices.push_back(first_vertex + indices[i]); }
+        m_submissions.push_back({layer, texture, first_index, index_count});
+    }
+
+    SDL_Vertex* BatchRenderer::add_quads(SDL_Texture* texture, int quad_count, int layer) {
+        const auto first_vertex = static_cast<int>(m_vertices.size());
+        const auto first_index  = static_cast<int>(m_indices.size());
+        if (quad_count <= 0) { return m_vertices.data() + first_vertex; }
+
+        m_vertices.resize(m_vertices.size() + static_cast<std::size_t>(quad_count) * 4);
+        m_indices.resize(m_indices.size() + static_cast<std::size_t>(quad_count) * 6);
+        int* index = m_indices.data() + first_index;
+        for (int quad = 0, vertex = first_vertex; quad < quad_count; quad++, vertex += 4, index += 6) {
+            index[0] = vertex;
+            index[1] = vertex + 1;
+            index[2] = vertex + 2;
+            index[3] = vertex;
+            index[4] = vertex + 2;
+            index[5] = vertex + 3;
+        }
+        m_submissions.push_back({layer, texture, first_index, quad_count * 6});
+        return m_vertices.data() + first_vertex;
+    }
+
+    void BatchRenderer::trim_quads(int unused_quad_count) {
+        if (unused_quad_count <= 0 || m_submissions.empty()) { return; }
+
+        Submission& last = m_submissions.back();
+        unused_quad_count = std::min(unused_quad_count, last.index_count / 6);
+        m_vertices.resize(m_vertices.size() - static_cast<std::size_t>(unused_quad_count) * 4);
+        m_indices.resize(m_indices.size() - static_cast<std::size_t>(unused_quad_count) * 6);
+        last.index_count -= unused_quad_count * 6;
+        if (last.index_count == 0) { m_submissions.pop_back(); }
+    }
+
+    void BatchRenderer::flush() {
+        m_last_flush = Stats{m_submissions.size(), m_indices.size() / 3, 0, 0};
+        if (m_submissions.empty()) { return; }
+        sort_submissions();
+
+        // Gather each run's indices next to each other so the run is one call.
+        m_sorted_indices.clear();
+        m_sorted_indices.reserve(m_indices.size());
+        const auto vertex_count = static_cast<int>(m_vertices.size());
+        for (std::size_t run_start = 0; run_start < m_submissions.size();) {
+            const Submission& first   = m_submissions[run_start];
+            const auto        offset  = static_cast<int>(m_sorted_indices.size());
+            std::size_t       run_end = run_start;
+            while (run_end < m_submissions.size() &&
+                   m_submissions[run_end].layer == first.layer &&
+                   m_submissions[run_end].texture == first.texture) {
+                const Submission& submission = m_submissions[run_end];
+                m_sorted_indices.insert(m_sorted_indices.end(),
+                                        m_indices.begin() + submission.first_index,
+                                        m_indices.begin() + submission.first_index + submission.index_count);
+                run_end++;
+            }
+
+            SDL_RenderGeometry(m_renderer, first.texture, m_vertices.data(), vertex_count,
+                               m_sorted_indices.data() + offset, static_cast<int>(m_sorted_indices.size()) - offset);
+            m_last_flush.draw_calls++;
+            run_start = run_end;
+        }
+        reset();
+    }
+
+    void BatchRenderer::flush(SoftwareRasterizer& rasterizer) {
+        m_last_flush = Stats{m_submissions.size(), m_indices.size() / 3, 0, 0};
+        sort_submissions();
+
+        // What the rasterizer can't draw is gathered into runs of one layer and texture, as flush() does.
+        m_sorted_indices.clear();
+        const auto                vertex_count = static_cast<int>(m_vertices.size());
+        const Submission*         run_first    = nullptr;
+        int                       run_offset   = 0;
+        SoftwareRasterizer::Image run_image{nullptr, 0, 0, 0};
+        const auto draw_run = [&]() {
+            const auto run_end = static_cast<int>(m_sorted_indices.size());
+            if (run_first && run_end > run_offset) {
+                SDL_RenderGeometry(m_renderer, run_first->texture, m_vertices.data(), vertex_count,
+                                   m_sorted_indices.data() + run_offset, run_end - run_offset);
+                m_last_flush.draw_calls++;
+            }
+            run_offset = run_end;
+        };
+
+        for (const Submission& submission : m_submissions) {
+            if (!run_first || submission.layer != run_first->layer || submission.texture != run_first->texture) {
+                draw_run();
+                run_first = &submission;
+
+                // Submissions are sorted by texture, so a texture's pixels are looked up once per run.
+                SurfacePtr pixels = Core::TexturePixels::access().find(submission.texture);
+                run_image = SoftwareRasterizer::image(pixels.get());
+                if (pixels) { m_retained_pixels.push_back(std::move(pixels)); }
+            }
+
+            const int* quad = m_indices.data() + submission.first_index;
+            const int* end  = quad + submission.index_count;
+            for (; quad + 6 <= end; quad += 6) {
+                if (!RECORD_QUAD(rasterizer, m_vertices.data(), quad, submission.texture, run_image)) {
+                    m_sorted_indices.insert(m_sorted_indices.end(), quad, quad + 6);
+                }
+            }
+            m_sorted_indices.insert(m_sorted_indices.end(), quad, end);
+        }
+        draw_run();
+        m_last_flush.fallback_triangles = m_sorted_indices.size() / 3;
+
+        // Textures the batch holds, and the pixels found for them, have to last until the tiles are drawn.
+        rasterizer.finish();
+        reset();
+    }
+
+    const BatchRenderer::Stats& BatchRenderer::last_flush_stats() const { return m_last_flush; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void BatchRenderer::append_quad(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest, int layer,
+                                    const SDL_Color& color) {
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+        if (texture) {
+            int texture_w = 0, texture_h = 0;
+            SDL_QueryTexture(texture, nullptr, nullptr, &texture_w, &texture_h);
+            if (texture_w <= 0 || texture_h <= 0) { return; }
+
+            u0 = static_cast<float>(source.x) / static_cast<float>(texture_w);
+            v0 = static_cast<float>(source.y) / static_cast<float>(texture_h);
+            u1 = static_cast<float>(source.x + source.w) / static_cast<float>(texture_w);
+            v1 = static_cast<float>(source.y + source.h) / static_cast<float>(texture_h);
+        }
+
+        const float left   = static_cast<float>(dest.x);
+        const float top    = static_cast<float>(dest.y);
+        const float right  = static_cast<float>(dest.x + dest.w);
+        const float bottom = static_cast<float>(dest.y + dest.h);
+
+        const int first_vertex = static_cast<int>(m_vertices.size());
+        const int first_index  = static_cast<int>(m_indices.size());
+        m_vertices.push_back({{left, top}, color, {u0, v0}});
+        m_vertices.push_back({{right, top}, color, {u1, v0}});
+        m_vertices.push_back({{right, bottom}, color, {u1, v1}});
+        m_vertices.push_back({{left, bottom}, color, {u0, v1}});
+        m_indices.insert(m_indices.end(), {first_vertex, first_vertex + 1, first_vertex + 2,
+                                           first_vertex, first_vertex + 2, first_vertex + 3});
+        m_submissions.push_back({layer, texture, first_index, 6});
+    }
+
+    void BatchRenderer::sort_submissions() {
+        // Stable, so submissions sharing a layer and texture keep the order they were made in.
+        std::stable_sort(m_submissions.begin(), m_submissions.end(),
+                         [](const Submission& a, const Submission& b) {
+                             if (a.layer != b.layer) { return a.layer < b.layer; }
+                             return std::less<SDL_Texture*>{}(a.texture, b.texture);
+                         });
+    }
+
+    void BatchRenderer::reset() {
+        m_vertices.clear();
+        m_indices.clear();
+        m_submissions.clear();
+        m_retained_textures.clear();
+        m_retained_pixels.clear();
+    }
+
+} // Rendering namespace
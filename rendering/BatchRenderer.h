@@ -0,0 +1,151 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_BATCH_RENDERER_H
+#define GOLD_CARTRIDGE_BATCH_RENDERER_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <SDL_render.h>
+
+namespace Rendering {
+
+    class SoftwareRasterizer;
+
+    /**
+     * @brief Collects colored and textured quads over a frame and draws them with as few calls as possible.
+     *
+     * Everything submitted is appended to one vertex buffer. On flush() the
+     * submissions are sorted by layer and then by texture, and each run that
+     * shares a layer and texture becomes a single SDL_RenderGeometry call.
+     * Lower layers are always drawn first. Within one layer, items using
+     * different textures may be drawn in any order, so things that overlap
+     * and must be drawn in a set order belong on different layers.
+     */
+    class BatchRenderer {
+    public:
+        using TexturePtr = std::shared_ptr<SDL_Texture>;
+
+        struct Stats {
+            std::size_t submissions        = 0; ///< Items submitted since the previous flush.
+            std::size_t triangles          = 0;
+            std::size_t draw_calls         = 0; ///< SDL_RenderGeometry calls made by the flush.
+            std::size_t fallback_triangles = 0; ///< Triangles a flush into a SoftwareRasterizer left to SDL.
+        };
+
+    public:
+        explicit BatchRenderer(SDL_Renderer* renderer);
+
+        BatchRenderer(const BatchRenderer&) = delete;
+        void operator=(const BatchRenderer&) = delete;
+
+        SDL_Renderer* renderer() const;
+
+        /**
+         * Queues a solid rectangle.
+         * @param area The rectangle to fill, in pixels.
+         * @param color The fill color.
+         * @param layer The drawing layer. Lower layers are drawn first.
+         */
+        void fill_rect(const SDL_Rect& area, const SDL_Color& color, int layer = 0);
+
+        /**
+         * Queues part of a texture to be copied to the screen, as SDL_RenderCopy would.
+         * @param texture The texture to copy from. The batch holds a reference to it until the next flush.
+         * @param source The area of the texture to copy, in pixels.
+         * @param dest The area of the screen to copy to, in pixels.
+         * @param layer The drawing layer. Lower layers are drawn first.
+         * @param tint A color to multiply the texture's colors with.
+         */
+        void copy(const TexturePtr& texture, const SDL_Rect& source, const SDL_Rect& dest, int layer = 0,
+                  const SDL_Color& tint = {255, 255, 255, 255});
+
+        /// Queues a texture the caller keeps alive until the next flush.
+        void copy(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest, int layer = 0,
+                  const SDL_Color& tint = {255, 255, 255, 255});
+
+        /**
+         * Queues indexed triangles. Indices refer to the given vertices, starting from zero.
+         * @param texture The texture to sample, or null for plain colored triangles.
+         */
+        void geometry(const TexturePtr& texture, const SDL_Vertex* vertices, int vertex_count,
+                      const int* indices, int index_count, int layer = 0);
+        void geometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertex_count,
+                      const int* indices, int index_count, int layer = 0);
+
+        /**
+         * Queues quads whose vertices the caller writes straight into the batch, for bulk submitters that would
+         * otherwise build their own vertex array only to have it copied.
+         * @param texture The texture to sample, or null for plain colored quads. The caller keeps it alive.
+         * @param quad_count The number of quads.
+         * @param layer The drawing layer. Lower layers are drawn first.
+         * @return Room for quad_count * 4 vertices, each quad's in the order top left, top right, bottom right,
+         *         bottom left. Valid until the next call on the batch.
+         */
+        SDL_Vertex* add_quads(SDL_Texture* texture, int quad_count, int layer = 0);
+
+        /// Gives back quads from the end of the most recent add_quads() that the caller didn't fill in.
+        void trim_quads(int unused_quad_count);
+
+        /// Draws everything queued since the last flush, and empties the queue.
+        void flush();
+
+        /**
+         * Draws everything queued since the last flush into a software rasterizer instead of through SDL, then
+         * runs its finish(), and empties the queue.
+         *
+         * The rasterizer only draws unscaled, axis-aligned quads: fills, copies
+         * at their own size, and glyphs, from textures Core::TexturePixels has
+         * the pixels of. Everything else is drawn through SDL_RenderGeometry,
+         * in runs as flush() makes them, before the rasterizer finishes. With
+         * an overlay rasterizer, that puts it underneath whatever the
+         * rasterizer draws, whatever its layer. It's counted in
+         * Stats::fallback_triangles.
+         *
+         * @param rasterizer The rasterizer to draw into. Its earlier commands are drawn first.
+         */
+        void flush(SoftwareRasterizer& rasterizer);
+
+        /// Statistics about the most recent flush.
+        const Stats& last_flush_stats() const;
+
+    private:
+        using SurfacePtr = std::shared_ptr<SDL_Surface>;
+
+        struct Submission {
+            int          layer;
+            SDL_Texture* texture;
+            int          first_index;
+            int          index_count;
+        };
+
+        void append_quad(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& dest, int layer,
+                         const SDL_Color& color);
+
+        /// Orders the submissions by layer, then texture, keeping the order they were made in otherwise.
+        void sort_submissions();
+
+        /// Empties the queue, keeping the buffers' capacity so steady-state frames don't allocate.
+        void reset();
+
+    private:
+        SDL_Renderer*           m_renderer;
+        std::vector<SDL_Vertex> m_vertices;
+        std::vector<int>        m_indices;
+        std::vector<int>        m_sorted_indices;
+        std::vector<Submission> m_submissions;
+        std::vector<TexturePtr> m_retained_textures;
+        std::vector<SurfacePtr> m_retained_pixels; ///< Looked up by a flush into a SoftwareRasterizer.
+        Stats                   m_last_flush;
+    };
+
+} // Rendering namespace
+
+#endif //GOLD_CARTRIDGE_BATCH_RENDERER_H
@@ -0,0 +1,165 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <SDL_events.h>
+#include <SDL_timer.h>
+
+namespace Rendering {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    static const double DEFAULT_TARGET_FRAME_RATE = 60.0;
+    static const double DEFAULT_SPIN_MARGIN_MS    = 1.5;
+    static const int    DEFAULT_IDLE_TIMEOUT_MS   = 250;
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    static FramePacer::Clock::duration FRAME_TIME(double frames_per_second) {
+        return std::chrono::duration_cast<FramePacer::Clock::duration>(Milliseconds(1000.0 / frames_per_second));
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    FramePacer::FramePacer()
+            : m_mode(Mode::Unlimited),
+              m_target_frame_rate(DEFAULT_TARGET_FRAME_RATE),
+              m_display_refresh_rate(DEFAULT_TARGET_FRAME_RATE),
+              m_spin_margin_ms(DEFAULT_SPIN_MARGIN_MS),
+              m_idle_timeout_ms(DEFAULT_IDLE_TIMEOUT_MS),
+              m_is_dirty(true),
+              m_woke_from_idle(false),
+              m_next_deadline(Clock::now()),
+              m_has_presented(false),
+              m_intervals_ms{},
+              m_interval_count(0) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    FramePacer::Mode FramePacer::mode() const { return m_mode; }
+    void FramePacer::mode(Mode new_mode) {
+        m_mode          = new_mode;
+        m_is_dirty      = true;
+        m_next_deadline = Clock::now();
+        reset_jitter();
+    }
+
+    double FramePacer::target_frame_rate() const { return m_target_frame_rate; }
+    void FramePacer::target_frame_rate(double frames_per_second) {
+        if (frames_per_second > 0.0) { m_target_frame_rate = frames_per_second; }
+    }
+
+    double FramePacer::display_refresh_rate() const { return m_display_refresh_rate; }
+    void FramePacer::display_refresh_rate(double frames_per_second) {
+        if (frames_per_second > 0.0) { m_display_refresh_rate = frames_per_second; }
+    }
+
+    double FramePacer::spin_margin_ms() const { return m_spin_margin_ms; }
+    void FramePacer::spin_margin_ms(double margin) { m_spin_margin_ms = std::max(margin, 0.0); }
+
+    int FramePacer::idle_timeout_ms() const { return m_idle_timeout_ms; }
+    void FramePacer::idle_timeout_ms(int timeout) { m_idle_timeout_ms = std::max(timeout, 1); }
+
+    void FramePacer::mark_dirty() { m_is_dirty = true; }
+    bool FramePacer::is_dirty() const { return m_is_dirty; }
+
+    bool FramePacer::wait_for_next_frame() {
+        m_woke_from_idle = false;
+        if (m_mode == Mode::Unlimited || m_mode == Mode::VSync) { return false; }
+
+        if (m_mode == Mode::EventDriven && !m_is_dirty) {
+            // Passing no event leaves whatever woke us in the queue for the event dispatcher.
+            SDL_WaitEventTimeout(nullptr, m_idle_timeout_ms);
+            m_woke_from_idle = true;
+            m_next_deadline  = Clock::now();
+            return true;
+        }
+
+        // Deadlines advance by whole frame times so rounding doesn't drift the frame rate. A loop that fell more
+        // than a frame behind starts over from now instead of rushing frames out to catch up.
+        Clock::duration   frame_time = FRAME_TIME(m_target_frame_rate);
+        Clock::time_point now        = Clock::now();
+        if (now > m_next_deadline + frame_time) { m_next_deadline = now; }
+        wait_until(m_next_deadline);
+        m_next_deadline += frame_time;
+        return false;
+    }
+
+    void FramePacer::frame_presented() {
+        Clock::time_point now = Clock::now();
+
+        // A gap spent asleep waiting for events says nothing about how steady the frame rate is.
+        if (m_has_presented && !m_woke_from_idle) {
+            m_intervals_ms[m_interval_count % INTERVAL_HISTORY] = Milliseconds(now - m_last_present).count();
+            m_interval_count++;
+        }
+        m_last_present  = now;
+        m_has_presented = true;
+        m_is_dirty      = false;
+    }
+
+    FramePacer::JitterStats FramePacer::jitter() const {
+        JitterStats stats;
+        stats.frames = std::min(m_interval_count, INTERVAL_HISTORY);
+        if (stats.frames == 0) { return stats; }
+
+        switch (m_mode) {
+            case Mode::Unlimited:   stats.target_ms = 0.0; break;
+            case Mode::VSync:       stats.target_ms = 1000.0 / m_display_refresh_rate; break;
+            case Mode::Capped:
+            case Mode::EventDriven: stats.target_ms = 1000.0 / m_target_frame_rate; break;
+        }
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < stats.frames; i++) { sum += m_intervals_ms[i]; }
+        stats.mean_ms = sum / static_cast<double>(stats.frames);
+
+        double squared_error = 0.0;
+        double reference     = stats.target_ms > 0.0 ? stats.target_ms : stats.mean_ms;
+        for (std::size_t i = 0; i < stats.frames; i++) {
+            double error = m_intervals_ms[i] - stats.mean_ms;
+            squared_error += error * error;
+            stats.max_deviation_ms = std::max(stats.max_deviation_ms, std::abs(m_intervals_ms[i] - reference));
+        }
+        stats.stddev_ms = std::sqrt(squared_error / static_cast<double>(stats.frames));
+        return stats;
+    }
+
+    void FramePacer::reset_jitter() {
+        m_interval_count = 0;
+        m_has_presented  = false;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void FramePacer::wait_until(Clock::time_point deadline) const {
+        // Sleep through most of the wait, then spin for the last stretch, where a sleep could overshoot.
+        // SDL_Delay is used over std::this_thread because SDL raises the OS timer resolution where that matters.
+        double sleep_ms = Milliseconds(deadline - Clock::now()).count() - m_spin_margin_ms;
+        if (sleep_ms >= 1.0) { SDL_Delay(static_cast<Uint32>(sleep_ms)); }
+
+        while (Clock::now() < deadline) { std::this_thread::yield(); }
+    }
+
+} // Rendering namespace
@@ -0,0 +1,108 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_FRAME_PACER_H
+#define GOLD_CARTRIDGE_FRAME_PACER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Rendering {
+
+    /**
+     * @brief Decides when the main loop starts its next frame, so it doesn't spin a core drawing frames nobody sees.
+     *
+     * The pacer also keeps the intervals between recent presented frames and
+     * reports how far they strayed from the intended frame time.
+     */
+    class FramePacer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Mode {
+            Unlimited,  ///< Start the next frame right away.
+            VSync,      ///< Let SDL_RenderPresent wait for the display's refresh.
+            Capped,     ///< Wait until the target frame rate allows another frame.
+            EventDriven ///< Sleep until an event arrives or a redraw is requested, then pace like Capped.
+        };
+
+        struct JitterStats {
+            std::size_t frames           = 0;   ///< Frame intervals the statistics cover.
+            double      target_ms        = 0.0; ///< The intended frame time, or zero if there isn't one.
+            double      mean_ms          = 0.0;
+            double      stddev_ms        = 0.0;
+            double      max_deviation_ms = 0.0; ///< Largest distance from the target, or from the mean without one.
+        };
+
+    public:
+        FramePacer();
+
+        Mode mode() const;
+        void mode(Mode new_mode);
+
+        double target_frame_rate() const;
+        void target_frame_rate(double frames_per_second);
+
+        /// The display's refresh rate, used as the target time when reporting jitter under VSync.
+        double display_refresh_rate() const;
+        void display_refresh_rate(double frames_per_second);
+
+        /**
+         * How close to a Capped deadline the pacer stops sleeping and starts spinning. Sleeping is cheap but can
+         * overshoot by a millisecond or more, spinning is exact but keeps the core busy.
+         */
+        double spin_margin_ms() const;
+        void spin_margin_ms(double margin);
+
+        /// How long an EventDriven loop may sleep without events before running a frame anyway.
+        int idle_timeout_ms() const;
+        void idle_timeout_ms(int timeout);
+
+        /// Asks for another frame. Only matters in EventDriven mode. Safe to call from any thread.
+        void mark_dirty();
+        bool is_dirty() const;
+
+        /**
+         * Blocks until the next frame should start, as the current mode dictates.
+         * @return True if the loop slept waiting for events, meaning the time spent asleep wasn't simulation time.
+         */
+        bool wait_for_next_frame();
+
+        /// Notes that a frame was presented. Clears the dirty flag and records the frame interval.
+        void frame_presented();
+
+        JitterStats jitter() const;
+        void reset_jitter();
+
+    private:
+        void wait_until(Clock::time_point deadline) const;
+
+    private:
+        static constexpr std::size_t INTERVAL_HISTORY = 256;
+
+        Mode              m_mode;
+        double            m_target_frame_rate;
+        double            m_display_refresh_rate;
+        double            m_spin_margin_ms;
+        int               m_idle_timeout_ms;
+        std::atomic<bool> m_is_dirty;
+        bool              m_woke_from_idle;
+
+        Clock::time_point m_next_deadline;
+        Clock::time_point m_last_present;
+        bool              m_has_presented;
+
+        std::array<double, INTERVAL_HISTORY> m_intervals_ms;
+        std::size_t                          m_interval_count; ///< Intervals recorded, including overwritten ones.
+    };
+
+} // Rendering namespace
+
+#endif //GOLD_CARTRIDGE_FRAME_PACER_H
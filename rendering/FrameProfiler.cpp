@@ -0,0 +1,207 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+
+namespace Rendering {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        // Hitting the update limit this many frames in a row (about half a
+        // second at 60 FPS) means the simulation is not catching back up.
+        const int SPIRAL_FRAME_THRESHOLD = 30;
+
+        std::atomic<std::uint32_t> NEXT_THREAD_ID{0};
+        thread_local std::uint32_t THIS_THREAD_ID = NEXT_THREAD_ID++;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /// Picks the value below which the given fraction of the (sorted) values fall.
+    static double PERCENTILE(const std::vector<double>& sorted_values, double fraction) {
+        auto index = static_cast<std::size_t>(fraction * static_cast<double>(sorted_values.size() - 1) + 0.5);
+        return sorted_values[std::min(index, sorted_values.size() - 1)];
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    FrameProfiler::FrameProfiler(std::size_t capacity)
+            : m_slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))),
+              m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+              m_next_slot(0),
+              m_first_valid_slot(0),
+              m_epoch(Clock::now()),
+              m_enabled(true),
+              m_deferred_updates(0),
+              m_updates_behind(0),
+              m_capped_frames(0),
+              m_consecutive_capped_frames(0) {}
+
+    FrameProfiler::Scope::Scope(FrameProfiler& profiler, Phase phase)
+            : m_profiler(profiler.enabled() ? &profiler : nullptr),
+              m_phase(phase),
+              m_start(m_profiler ? Clock::now() : Clock::time_point{}) {}
+
+    FrameProfiler::Scope::~Scope() {
+        if (m_profiler) { m_profiler->record(m_phase, m_start, Clock::now()); }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool FrameProfiler::enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void FrameProfiler::enabled(bool is_enabled) { m_enabled.store(is_enabled, std::memory_order_relaxed); }
+
+    void FrameProfiler::record(Phase phase, Clock::time_point start, Clock::time_point end) {
+        if (!enabled()) { return; }
+
+        // Claim a slot, then write it under a per-slot sequence lock so readers
+        // can tell a finished sample from one being overwritten.
+        const std::uint64_t index = m_next_slot.fetch_add(1, std::memory_order_relaxed);
+        Slot&               slot  = m_slots[index & m_mask];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const std::uint64_t phase_and_thread = (std::uint64_t(THIS_THREAD_ID) << 8) | std::uint64_t(phase);
+        slot.phase_and_thread.store(phase_and_thread, std::memory_order_relaxed);
+        slot.start_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_epoch).count(),
+                            std::memory_order_relaxed);
+        slot.duration_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                               std::memory_order_relaxed);
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+    }
+
+    void FrameProfiler::record_updates(int updates_run, int updates_behind) {
+        (void)updates_run; // Only frames that hit the limit are interesting for now.
+        // The backlog is still there next frame, so counting all of it every frame would count it again and again.
+        int newly_behind = updates_behind - m_updates_behind.exchange(updates_behind, std::memory_order_relaxed);
+        if (newly_behind > 0) {
+            m_deferred_updates.fetch_add(static_cast<std::uint64_t>(newly_behind), std::memory_order_relaxed);
+        }
+        if (updates_behind > 0) {
+            m_capped_frames.fetch_add(1, std::memory_order_relaxed);
+            m_consecutive_capped_frames.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_consecutive_capped_frames.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    FrameProfiler::PhaseStats FrameProfiler::phase_stats(Phase phase) const {
+        std::vector<double> durations_ms;
+        for (const Sample& sample : samples()) {
+            if (sample.phase == phase) { durations_ms.push_back(static_cast<double>(sample.duration_ns) / 1.0e6); }
+        }
+
+        PhaseStats stats;
+        if (durations_ms.empty()) { return stats; }
+
+        std::sort(durations_ms.begin(), durations_ms.end());
+        double total_ms = 0.0;
+        for (double duration : durations_ms) { total_ms += duration; }
+
+        stats.samples = durations_ms.size();
+        stats.mean_ms = total_ms / static_cast<double>(durations_ms.size());
+        stats.p50_ms  = PERCENTILE(durations_ms, 0.50);
+        stats.p95_ms  = PERCENTILE(durations_ms, 0.95);
+        stats.p99_ms  = PERCENTILE(durations_ms, 0.99);
+        stats.max_ms  = durations_ms.back();
+        return stats;
+    }
+
+    std::vector<FrameProfiler::Sample> FrameProfiler::samples() const {
+        const std::uint64_t capacity = m_mask + 1;
+        const std::uint64_t end      = m_next_slot.load(std::memory_order_acquire);
+        const std::uint64_t begin    = std::max(m_first_valid_slot.load(std::memory_order_relaxed),
+                                                end > capacity ? end - capacity : 0);
+
+        std::vector<Sample> result;
+        result.reserve(static_cast<std::size_t>(end - begin));
+        for (std::uint64_t index = begin; index < end; index++) {
+            const Slot&         slot   = m_slots[index & m_mask];
+            const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before != 2 * index + 2) { continue; } // Still being written, or already overwritten.
+
+            const std::uint64_t phase_and_thread = slot.phase_and_thread.load(std::memory_order_relaxed);
+            Sample              sample{static_cast<Phase>(phase_and_thread & 0xFF),
+                                       static_cast<std::uint32_t>(phase_and_thread >> 8),
+                                       slot.start_ns.load(std::memory_order_relaxed),
+                                       slot.duration_ns.load(std::memory_order_relaxed)};
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != before) { continue; }
+            result.push_back(sample);
+        }
+        return result;
+    }
+
+    std::uint64_t FrameProfiler::deferred_update_count() const {
+        return m_deferred_updates.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t FrameProfiler::capped_frame_count() const {
+        return m_capped_frames.load(std::memory_order_relaxed);
+    }
+
+    int FrameProfiler::consecutive_capped_frames() const {
+        return m_consecutive_capped_frames.load(std::memory_order_relaxed);
+    }
+
+    bool FrameProfiler::is_spiraling() const {
+        return consecutive_capped_frames() >= SPIRAL_FRAME_THRESHOLD;
+    }
+
+    bool FrameProfiler::write_chrome_trace(const std::string& path) const {
+        std::ofstream trace(path);
+        if (!trace) { return false; }
+
+        trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first_event = true;
+        for (const Sample& sample : samples()) {
+            trace << (first_event ? "\n" : ",\n");
+            trace << "{\"name\":\"" << phase_name(sample.phase) << "\",\"cat\":\"frame\",\"ph\":\"X\""
+                  << ",\"ts\":" << static_cast<double>(sample.start_ns) / 1000.0
+                  << ",\"dur\":" << static_cast<double>(sample.duration_ns) / 1000.0
+                  << ",\"pid\":1,\"tid\":" << sample.thread << "}";
+            first_event = false;
+        }
+        trace << "\n]}\n";
+        return static_cast<bool>(trace);
+    }
+
+    void FrameProfiler::reset() {
+        m_first_valid_slot.store(m_next_slot.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        m_deferred_updates.store(0, std::memory_order_relaxed);
+        m_updates_behind.store(0, std::memory_order_relaxed);
+        m_capped_frames.store(0, std::memory_order_relaxed);
+        m_consecutive_capped_frames.store(0, std::memory_order_relaxed);
+    }
+
+    const char* FrameProfiler::phase_name(Phase phase) {
+        switch (phase) {
+            case Phase::Frame: return "Frame";
+            case Phase::Update: return "Update";
+            case Phase::Events: return "Events";
+            case Phase::Draw: return "Draw";
+            case Phase::Present: return "Present";
+            default: return "Unknown";
+        }
+    }
+
+} // Rendering namespace
@@ -0,0 +1,145 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_FRAME_PROFILER_H
+#define GOLD_CARTRIDGE_FRAME_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Rendering {
+
+    /**
+     * @brief Records how long each phase of the main loop takes.
+     *
+     * Timings go into a fixed-size ring buffer that any thread can write to
+     * without locking, and that can be read from any thread while it is being
+     * written. Once the buffer is full the oldest samples are overwritten, so
+     * the statistics always describe the most recent stretch of frames.
+     */
+    class FrameProfiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Phase : std::uint8_t {
+            Frame,   ///< One whole iteration of the main loop.
+            Update,  ///< The user update callback.
+            Events,  ///< Draining and dispatching SDL's event queue.
+            Draw,    ///< Clearing the screen and the user draw callback.
+            Present, ///< SDL_RenderPresent.
+            Count
+        };
+
+        struct Sample {
+            Phase         phase;
+            std::uint32_t thread;      ///< Small id of the recording thread, assigned in first-use order.
+            std::int64_t  start_ns;    ///< Start time, relative to when the profiler was made.
+            std::int64_t  duration_ns;
+        };
+
+        struct PhaseStats {
+            std::size_t samples = 0;
+            double      mean_ms = 0.0;
+            double      p50_ms  = 0.0;
+            double      p95_ms  = 0.0;
+            double      p99_ms  = 0.0;
+            double      max_ms  = 0.0;
+        };
+
+        /// Times a phase from construction to destruction.
+        class Scope {
+        public:
+            Scope(FrameProfiler& profiler, Phase phase);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            void operator=(const Scope&) = delete;
+
+        private:
+            FrameProfiler*    m_profiler;
+            Phase             m_phase;
+            Clock::time_point m_start;
+        };
+
+    public:
+        /**
+         * @param capacity The number of samples to keep. Rounded up to a power of two.
+         */
+        explicit FrameProfiler(std::size_t capacity = 16384);
+
+        FrameProfiler(const FrameProfiler&) = delete;
+        void operator=(const FrameProfiler&) = delete;
+
+        bool enabled() const;
+        void enabled(bool is_enabled);
+
+        void record(Phase phase, Clock::time_point start, Clock::time_point end);
+
+        /**
+         * Notes how many fixed-timestep updates a frame ran and how far behind the per-frame update limit left
+         * the simulation.
+         * @param updates_behind Whole update intervals still waiting in the lag after the frame's updates. The
+         *                       lag carries over, so only growth since the previous frame counts as newly deferred.
+         */
+        void record_updates(int updates_run, int updates_behind);
+
+        PhaseStats phase_stats(Phase phase) const;
+        std::vector<Sample> samples() const;
+
+        /// Updates the per-frame limit pushed into later frames, each counted once, when it first fell behind.
+        std::uint64_t deferred_update_count() const;
+        std::uint64_t capped_frame_count() const;
+        int consecutive_capped_frames() const;
+
+        /**
+         * Checks for a "spiral of death", where updates take longer than the time they simulate, so the
+         * loop falls further behind every frame.
+         * @return True if the update limit has been hit on every recent frame.
+         */
+        bool is_spiraling() const;
+
+        /**
+         * Writes the buffered samples as a Chrome trace-event file, viewable in chrome://tracing or Perfetto.
+         * @param path The file to write.
+         * @return False if the file could not be written.
+         */
+        bool write_chrome_trace(const std::string& path) const;
+        void reset();
+
+        static const char* phase_name(Phase phase);
+
+    private:
+        /// One ring buffer entry. The sequence number is odd while the entry is being written.
+        struct Slot {
+            std::atomic<std::uint64_t> sequence{0};
+            std::atomic<std::uint64_t> phase_and_thread{0};
+            std::atomic<std::int64_t>  start_ns{0};
+            std::atomic<std::int64_t>  duration_ns{0};
+        };
+
+    private:
+        std::unique_ptr<Slot[]>    m_slots;
+        std::size_t                m_mask;
+        std::atomic<std::uint64_t> m_next_slot;
+        std::atomic<std::uint64_t> m_first_valid_slot; ///< Samples before this were discarded by reset().
+        Clock::time_point          m_epoch;
+        std::atomic<bool>          m_enabled;
+
+        std::atomic<std::uint64_t> m_deferred_updates;
+        std::atomic<int>           m_updates_behind; ///< As of the latest record_updates().
+        std::atomic<std::uint64_t> m_capped_frames;
+        std::atomic<int>           m_consecutive_capped_frames;
+    };
+
+} // Rendering namespace
+
+#endif //GOLD_CARTRIDGE_FRAME_PROFILER_H
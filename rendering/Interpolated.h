@@ -0,0 +1,104 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_INTERPOLATED_H
+#define GOLD_CARTRIDGE_INTERPOLATED_H
+
+#include <cmath>
+#include <type_traits>
+
+#include <SDL_pixels.h>
+#include <SDL_rect.h>
+
+namespace Rendering {
+
+    /**
+     * @brief Blends between two values.
+     * @param from The value at alpha 0.
+     * @param to The value at alpha 1.
+     * @param alpha How far to go from one to the other, in [0, 1].
+     *
+     * Overload this for your own types, in their namespace or in Rendering, to use them with Interpolated.
+     */
+    ///@{
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    inline T lerp(T from, T to, double alpha) {
+        // In double, so unsigned values don't wrap when to is less than from, nor narrow ones overflow.
+        double blended = static_cast<double>(from) + (static_cast<double>(to) - static_cast<double>(from)) * alpha;
+        if constexpr (std::is_integral_v<T>) { return static_cast<T>(std::lround(blended)); }
+        else { return static_cast<T>(blended); }
+    }
+
+    inline SDL_FPoint lerp(const SDL_FPoint& from, const SDL_FPoint& to, double alpha) {
+        return {lerp(from.x, to.x, alpha), lerp(from.y, to.y, alpha)};
+    }
+
+    inline SDL_Point lerp(const SDL_Point& from, const SDL_Point& to, double alpha) {
+        return {lerp(from.x, to.x, alpha), lerp(from.y, to.y, alpha)};
+    }
+
+    inline SDL_FRect lerp(const SDL_FRect& from, const SDL_FRect& to, double alpha) {
+        return {lerp(from.x, to.x, alpha), lerp(from.y, to.y, alpha), lerp(from.w, to.w, alpha), lerp(from.h, to.h, alpha)};
+    }
+
+    inline SDL_Rect lerp(const SDL_Rect& from, const SDL_Rect& to, double alpha) {
+        return {lerp(from.x, to.x, alpha), lerp(from.y, to.y, alpha), lerp(from.w, to.w, alpha), lerp(from.h, to.h, alpha)};
+    }
+
+    inline SDL_Color lerp(const SDL_Color& from, const SDL_Color& to, double alpha) {
+        return {lerp(from.r, to.r, alpha), lerp(from.g, to.g, alpha), lerp(from.b, to.b, alpha), lerp(from.a, to.a, alpha)};
+    }
+    ///@}
+
+    /**
+     * @brief A piece of simulation state that remembers its value from the previous update, so it can be drawn
+     *        part way between the two.
+     *
+     * Change the value only from the update callback, through set() or
+     * advance(), and draw at(alpha) with the alpha given to the draw callback.
+     */
+    template <typename T>
+    class Interpolated {
+    public:
+        explicit Interpolated(const T& value = T{}) : m_previous(value), m_current(value) {}
+
+        /// Starts a new update with a new value. The old one becomes the previous value.
+        void set(const T& value) {
+            m_previous = m_current;
+            m_current  = value;
+        }
+
+        /**
+         * Starts a new update by copying the current value into the previous one.
+         * @return The current value, to modify in place.
+         */
+        T& advance() {
+            m_previous = m_current;
+            return m_current;
+        }
+
+        /// Jumps straight to a value, with no blending from the old one. Use it for teleports and respawns.
+        void reset(const T& value) {
+            m_previous = value;
+            m_current  = value;
+        }
+
+        const T& previous() const { return m_previous; }
+        const T& current() const { return m_current; }
+
+        /// The value to draw this frame.
+        T at(double alpha) const { return lerp(m_previous, m_current, alpha); }
+
+    private:
+        T m_previous;
+        T m_current;
+    };
+
+} // Rendering namespace
+
+#endif //GOLD_CARTRIDGE_INTERPOLATED_H
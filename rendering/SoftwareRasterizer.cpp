@@ -0,0 +1,256 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "SoftwareRasterizer.h"
+#include "../core/PixelOps.h"
+#include "../core/JobSystem.h"
+#include "../core/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <SDL_surface.h>
+
+namespace Rendering {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        /// Tiles drawn per job. A 64 pixel tile of a busy frame takes a few microseconds.
+        const std::size_t TILE_BATCH_SIZE = 2;
+
+        const std::uint32_t OPAQUE_WHITE = 0xFFFFFFFF;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    static bool INTERSECT(const SDL_Rect& a, const SDL_Rect& b, SDL_Rect& result) {
+        int left   = std::max(a.x, b.x);
+        int top    = std::max(a.y, b.y);
+        int right  = std::min(a.x + a.w, b.x + b.w);
+        int bottom = std::min(a.y + a.h, b.y + b.h);
+        if (right <= left || bottom <= top) { return false; }
+        result = {left, top, right - left, bottom - top};
+        return true;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    SoftwareRasterizer::SoftwareRasterizer(SDL_Renderer* renderer, int width, int height, int tile_size)
+            : m_renderer(renderer),
+              m_texture(nullptr, SDL_DestroyTexture),
+              m_width(std::max(width, 0)),
+              m_height(std::max(height, 0)),
+              m_tile_size(std::max(tile_size, 8)),
+              m_tile_columns((m_width + m_tile_size - 1) / m_tile_size),
+              m_tile_rows((m_height + m_tile_size - 1) / m_tile_size),
+              m_overlay(false),
+              m_pixels(static_cast<std::size_t>(m_width) * m_height, 0),
+              m_tile_commands(static_cast<std::size_t>(m_tile_columns) * m_tile_rows) {
+        m_last_finish.tiles = m_tile_commands.size();
+        if (!m_renderer || m_width == 0 || m_height == 0) { return; }
+
+        m_texture.reset(SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                          m_width, m_height));
+        if (!m_texture) {
+            LOG_ERROR("Could not create the software rasterizer's texture: %s", SDL_GetError());
+            return;
+        }
+        // The framebuffer is the whole frame, so it replaces what's under it rather than blending.
+        SDL_SetTextureBlendMode(m_texture.get(), SDL_BLENDMODE_NONE);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    SoftwareRasterizer::Image SoftwareRasterizer::image(const SDL_Surface* surface) {
+        if (!surface || !surface->format || surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+            return {nullptr, 0, 0, 0};
+        }
+        return {static_cast<const std::uint32_t*>(surface->pixels), surface->w, surface->h, surface->pitch};
+    }
+
+    void SoftwareRasterizer::clear(const SDL_Color& color) {
+        record(CommandType::Fill, {0, 0, m_width, m_height}, Core::PixelOps::to_argb(color), nullptr, 0);
+    }
+
+    void SoftwareRasterizer::fill_rect(const SDL_Rect& area, const SDL_Color& color) {
+        if (color.a == 0) { return; }
+        const CommandType type = color.a == 255 ? CommandType::Fill : CommandType::Blend;
+        record(type, area, Core::PixelOps::to_argb(color), nullptr, 0);
+    }
+
+    void SoftwareRasterizer::blit(const Image& image, const SDL_Rect& source, int x, int y, const SDL_Color& tint) {
+        SDL_Rect visible;
+        if (!image.pixels || tint.a == 0 || !INTERSECT(source, {0, 0, image.width, image.height}, visible)) { return; }
+
+        const std::uint32_t color = Core::PixelOps::to_argb(tint);
+        const auto*         first = reinterpret_cast<const std::uint8_t*>(image.pixels) +
+                                    static_cast<std::ptrdiff_t>(visible.y) * image.pitch +
+                                    static_cast<std::ptrdiff_t>(visible.x) * sizeof(std::uint32_t);
+        record(color == OPAQUE_WHITE ? CommandType::Blit : CommandType::TintedBlit,
+               {x + visible.x - source.x, y + visible.y - source.y, visible.w, visible.h}, color, first, image.pitch);
+    }
+
+    void SoftwareRasterizer::glyph(const Mask& mask, const SDL_Rect& source, int x, int y, const SDL_Color& color) {
+        SDL_Rect visible;
+        if (!mask.coverage || color.a == 0 || !INTERSECT(source, {0, 0, mask.width, mask.height}, visible)) { return; }
+
+        const std::uint8_t* first = mask.coverage + static_cast<std::ptrdiff_t>(visible.y) * mask.pitch + visible.x;
+        record(CommandType::Glyph, {x + visible.x - source.x, y + visible.y - source.y, visible.w, visible.h},
+               Core::PixelOps::to_argb(color), first, mask.pitch);
+    }
+
+    void SoftwareRasterizer::finish() {
+        bin_commands();
+        Core::JobSystem::access().parallel_for(m_tile_commands.size(), TILE_BATCH_SIZE,
+                                               [this](std::size_t begin, std::size_t end) {
+                                                   for (std::size_t tile = begin; tile < end; tile++) {
+                                                       draw_tile(tile);
+                                                   }
+                                               });
+
+        m_last_finish.commands      = m_commands.size();
+        m_last_finish.tile_commands = 0;
+        m_last_finish.tiles_drawn   = 0;
+        for (std::vector<std::uint32_t>& commands : m_tile_commands) {
+            m_last_finish.tile_commands += commands.size();
+            m_last_finish.tiles_drawn += commands.empty() ? 0 : 1;
+            commands.clear();
+        }
+        m_commands.clear();
+    }
+
+    void SoftwareRasterizer::present(const SDL_Rect* dest) {
+        if (!m_texture) { return; }
+        const int row_bytes = m_width * static_cast<int>(sizeof(std::uint32_t));
+        if (!m_overlay) {
+            SDL_UpdateTexture(m_texture.get(), nullptr, m_pixels.data(), row_bytes);
+        } else {
+            void* locked = nullptr;
+            int   pitch  = 0;
+            if (SDL_LockTexture(m_texture.get(), nullptr, &locked, &pitch) != 0) { return; }
+            auto* row = static_cast<std::uint8_t*>(locked);
+            for (int y = 0; y < m_height; y++, row += pitch) {
+                std::memcpy(row, m_pixels.data() + static_cast<std::size_t>(y) * m_width, row_bytes);
+                Core::PixelOps::unpremultiply(reinterpret_cast<std::uint32_t*>(row), static_cast<std::size_t>(m_width));
+            }
+            SDL_UnlockTexture(m_texture.get());
+        }
+        SDL_RenderCopy(m_renderer, m_texture.get(), nullptr, dest);
+    }
+
+    bool SoftwareRasterizer::overlay() const { return m_overlay; }
+
+    void SoftwareRasterizer::overlay(bool is_overlay) {
+        m_overlay = is_overlay;
+        if (!m_texture) { return; }
+        SDL_SetTextureBlendMode(m_texture.get(), m_overlay ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    }
+
+    int SoftwareRasterizer::width() const { return m_width; }
+
+    int SoftwareRasterizer::height() const { return m_height; }
+
+    const std::uint32_t* SoftwareRasterizer::pixels() const { return m_pixels.data(); }
+
+    SDL_Texture* SoftwareRasterizer::texture() const { return m_texture.get(); }
+
+    void SoftwareRasterizer::release_texture() { m_texture.reset(); }
+
+    const SoftwareRasterizer::Stats& SoftwareRasterizer::last_finish_stats() const { return m_last_finish; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void SoftwareRasterizer::record(CommandType type, SDL_Rect area, std::uint32_t color, const void* source,
+                                    int source_pitch) {
+        SDL_Rect clipped;
+        if (!INTERSECT(area, {0, 0, m_width, m_height}, clipped)) { return; }
+
+        // Move the source along by however much was clipped off the top and left.
+        if (source) {
+            const std::ptrdiff_t pixel_bytes = type == CommandType::Glyph ? 1 : sizeof(std::uint32_t);
+            source = static_cast<const std::uint8_t*>(source) +
+                     static_cast<std::ptrdiff_t>(clipped.y - area.y) * source_pitch +
+                     (clipped.x - area.x) * pixel_bytes;
+        }
+        m_commands.push_back({type, clipped, color, source, source_pitch});
+    }
+
+    void SoftwareRasterizer::bin_commands() {
+        for (std::size_t index = 0; index < m_commands.size(); index++) {
+            const Command& command = m_commands[index];
+            const int      first_column = command.area.x / m_tile_size;
+            const int      last_column  = (command.area.x + command.area.w - 1) / m_tile_size;
+            const int      first_row    = command.area.y / m_tile_size;
+            const int      last_row     = (command.area.y + command.area.h - 1) / m_tile_size;
+
+            for (int row = first_row; row <= last_row; row++) {
+                for (int column = first_column; column <= last_column; column++) {
+                    std::vector<std::uint32_t>& commands = m_tile_commands[row * m_tile_columns + column];
+
+                    // An opaque fill over the whole tile hides everything drawn before it, as a clear does.
+                    if (command.type == CommandType::Fill) {
+                        const int left = column * m_tile_size, top = row * m_tile_size;
+                        const int right  = std::min(left + m_tile_size, m_width);
+                        const int bottom = std::min(top + m_tile_size, m_height);
+                        if (command.area.x <= left && command.area.y <= top &&
+                            command.area.x + command.area.w >= right && command.area.y + command.area.h >= bottom) {
+                            commands.clear();
+                        }
+                    }
+                    commands.push_back(static_cast<std::uint32_t>(index));
+                }
+            }
+        }
+    }
+
+    void SoftwareRasterizer::draw_tile(std::size_t tile_index) {
+        const int      column = static_cast<int>(tile_index) % m_tile_columns;
+        const int      row    = static_cast<int>(tile_index) / m_tile_columns;
+        const SDL_Rect tile{column * m_tile_size, row * m_tile_size, m_tile_size, m_tile_size};
+
+        for (std::uint32_t index : m_tile_commands[tile_index]) {
+            const Command& command = m_commands[index];
+            SDL_Rect       area;
+            if (!INTERSECT(command.area, tile, area)) { continue; }
+
+            const auto* source = static_cast<const std::uint8_t*>(command.source);
+            const int   pixel_bytes = command.type == CommandType::Glyph ? 1 : sizeof(std::uint32_t);
+            if (source) {
+                source += static_cast<std::ptrdiff_t>(area.y - command.area.y) * command.source_pitch +
+                          (area.x - command.area.x) * pixel_bytes;
+            }
+
+            const auto width = static_cast<std::size_t>(area.w);
+            for (int y = 0; y < area.h; y++, source += command.source_pitch) {
+                std::uint32_t* dst = m_pixels.data() + static_cast<std::size_t>(area.y + y) * m_width + area.x;
+                const auto*    image = reinterpret_cast<const std::uint32_t*>(source);
+                switch (command.type) {
+                    case CommandType::Fill: Core::PixelOps::fill(dst, width, command.color); break;
+                    case CommandType::Blend: Core::PixelOps::alpha_over_color(dst, width, command.color); break;
+                    case CommandType::Blit: Core::PixelOps::alpha_over(dst, image, width); break;
+                    case CommandType::TintedBlit: Core::PixelOps::alpha_over(dst, image, width, command.color); break;
+                    case CommandType::Glyph:
+                        Core::PixelOps::alpha_over_coverage(dst, source, width, command.color);
+                        break;
+                }
+            }
+        }
+    }
+
+} // Rendering namespace
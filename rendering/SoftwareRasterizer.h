@@ -0,0 +1,197 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_SOFTWARE_RASTERIZER_H
+#define GOLD_CARTRIDGE_SOFTWARE_RASTERIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SDL_rect.h>
+#include <SDL_render.h>
+
+struct SDL_Surface;
+
+namespace Rendering {
+
+    /**
+     * @brief Draws rectangles, images and glyphs into a framebuffer in memory, spread across the job system.
+     *
+     * For machines without a GPU, where SDL falls back to its software renderer
+     * and draws everything on one thread. Drawing calls are only recorded.
+     * finish() sorts them into square tiles of the framebuffer and then draws
+     * the tiles in parallel on Core::JobSystem, each tile running its own
+     * commands in the order they were made, with the SIMD kernels in
+     * PixelOps. present() hands the finished frame to SDL with one
+     * SDL_UpdateTexture and one copy.
+     *
+     * Pixels are ARGB8888 with straight alpha, and blend as SDL_BLENDMODE_BLEND
+     * does. Images are copied without scaling. The framebuffer keeps its
+     * pixels from one frame to the next, so a frame only needs to redraw what
+     * changed.
+     *
+     * Window::Backend::Software draws its batch through one of these, via
+     * BatchRenderer::flush(SoftwareRasterizer&). Textures can't be read back,
+     * so the batch draws a texture here only if Core::TexturePixels has its
+     * pixels, and hands anything else to SDL underneath the overlay.
+     */
+    class SoftwareRasterizer {
+    public:
+        /// ARGB8888 pixels the caller owns, such as an ARGB8888 SDL_Surface's.
+        struct Image {
+            const std::uint32_t* pixels;
+            int                  width;
+            int                  height;
+            int                  pitch; ///< Bytes from the start of one row to the start of the next.
+        };
+
+        /// One coverage byte per pixel, 0 for none and 255 for full, as a rasterized glyph gives.
+        struct Mask {
+            const std::uint8_t* coverage;
+            int                 width;
+            int                 height;
+            int                 pitch; ///< Bytes from the start of one row to the start of the next.
+        };
+
+        struct Stats {
+            std::size_t commands      = 0; ///< Drawing calls recorded since the previous finish().
+            std::size_t tile_commands = 0; ///< Commands run by tiles, counting a command once per tile it touches.
+            std::size_t tiles_drawn   = 0; ///< Tiles with at least one command.
+            std::size_t tiles         = 0;
+        };
+
+        static constexpr int DEFAULT_TILE_SIZE = 64;
+
+    public:
+        /**
+         * Makes a framebuffer, initially transparent black.
+         * @param renderer The renderer present() draws with, or null to only draw into memory.
+         * @param width The framebuffer's width, in pixels.
+         * @param height The framebuffer's height, in pixels.
+         * @param tile_size The width and height of each tile, in pixels. Tiles small enough to stay in the cache
+         *                  while their commands run, and numerous enough to keep every worker busy, draw fastest.
+         */
+        SoftwareRasterizer(SDL_Renderer* renderer, int width, int height, int tile_size = DEFAULT_TILE_SIZE);
+
+        SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+        void operator=(const SoftwareRasterizer&) = delete;
+
+        /// Wraps an ARGB8888 surface's pixels. Other formats give an empty image, which draws nothing.
+        static Image image(const SDL_Surface* surface);
+
+        /// Sets every pixel to a color, replacing what was there, alpha included.
+        void clear(const SDL_Color& color);
+
+        /// Fills a rectangle, blending it with what's underneath unless the color is opaque.
+        void fill_rect(const SDL_Rect& area, const SDL_Color& color);
+
+        /**
+         * Blends part of an image onto the framebuffer at its own size.
+         * @param image The pixels to copy. They must stay unchanged until finish() returns.
+         * @param source The area of the image to copy, in pixels.
+         * @param x Where the left edge of source goes, in framebuffer pixels.
+         * @param y Where the top edge of source goes, in framebuffer pixels.
+         * @param tint A color to multiply the image's colors with.
+         */
+        void blit(const Image& image, const SDL_Rect& source, int x, int y,
+                  const SDL_Color& tint = {255, 255, 255, 255});
+
+        /**
+         * Blends a color onto the framebuffer through a coverage mask, as text is drawn.
+         * @param mask The coverage to draw. It must stay unchanged until finish() returns.
+         * @param source The area of the mask to draw, in pixels.
+         * @param x Where the left edge of source goes, in framebuffer pixels.
+         * @param y Where the top edge of source goes, in framebuffer pixels.
+         * @param color The color to draw. Its alpha is multiplied by the coverage.
+         */
+        void glyph(const Mask& mask, const SDL_Rect& source, int x, int y, const SDL_Color& color);
+
+        /// Draws every recorded command into the framebuffer, and forgets them.
+        void finish();
+
+        /**
+         * Uploads the framebuffer with one SDL_UpdateTexture and copies it to the render target.
+         * @param dest Where to draw it, or null to fill the render target.
+         */
+        void present(const SDL_Rect* dest = nullptr);
+
+        bool overlay() const;
+
+        /**
+         * Chooses whether present() blends the framebuffer over what the renderer already drew, rather than
+         * replacing it. Off by default.
+         *
+         * Pixels blended onto transparent black come out premultiplied, as SDL
+         * leaves them, so present() unpremultiplies them on their way to the
+         * texture. Clearing to transparent black each frame then lets drawing
+         * done straight through SDL show through wherever nothing was drawn.
+         *
+         * @param is_overlay True to blend the framebuffer over the render target.
+         */
+        void overlay(bool is_overlay);
+
+        int width() const;
+        int height() const;
+
+        /// The framebuffer, width() pixels to a row and no padding. Only up to date after finish().
+        const std::uint32_t* pixels() const;
+
+        /// The streaming texture present() uploads to. Null without a renderer.
+        SDL_Texture* texture() const;
+
+        /// Frees the texture. It has to go before the renderer it was made with is destroyed.
+        void release_texture();
+
+        const Stats& last_finish_stats() const;
+
+    private:
+        using SDL_TexturePtr = std::unique_ptr<SDL_Texture, void (*)(SDL_Texture*)>;
+
+        enum class CommandType : std::uint8_t {
+            Fill,        ///< Replace pixels with color.
+            Blend,       ///< Blend color over pixels.
+            Blit,        ///< Blend image pixels over pixels.
+            TintedBlit,  ///< Blend image pixels, multiplied by color, over pixels.
+            Glyph        ///< Blend color, with its alpha scaled by mask coverage, over pixels.
+        };
+
+        struct Command {
+            CommandType   type;
+            SDL_Rect      area;         ///< Where to draw, already clipped to the framebuffer.
+            std::uint32_t color;        ///< ARGB8888.
+            const void*   source;       ///< The image pixel or mask byte drawn at the area's top left corner.
+            int           source_pitch; ///< In bytes.
+        };
+
+        /// Clips a drawing command to the framebuffer and records it.
+        void record(CommandType type, SDL_Rect area, std::uint32_t color, const void* source, int source_pitch);
+
+        /// Lists every command that touches each tile, dropping commands a later full-tile fill hides.
+        void bin_commands();
+        void draw_tile(std::size_t tile_index);
+
+    private:
+        SDL_Renderer*                           m_renderer;
+        SDL_TexturePtr                          m_texture;
+        int                                     m_width;
+        int                                     m_height;
+        int                                     m_tile_size;
+        int                                     m_tile_columns;
+        int                                     m_tile_rows;
+        bool                                    m_overlay;
+        std::vector<std::uint32_t>              m_pixels;
+        std::vector<Command>                    m_commands;
+        std::vector<std::vector<std::uint32_t>> m_tile_commands; ///< Indices into m_commands for each tile, in order.
+        Stats                                   m_last_finish;
+    };
+
+} // Rendering namespace
+
+#endif //GOLD_CARTRIDGE_SOFTWARE_RASTERIZER_H
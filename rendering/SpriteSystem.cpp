@@ -0,0 +1,322 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "SpriteSystem.h"
+#include "../core/JobSystem.h"
+#include "../core/SimdLanes.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Rendering {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        using Lanes = Core::FloatLanes;
+
+        /// Sprites moved per job. Moving one is a few nanoseconds, so this keeps each job worth queuing.
+        const std::size_t INTEGRATE_BATCH_SIZE = 16384;
+
+        const std::uint32_t NO_GROUP = ~std::uint32_t{0};
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /// Moves sprites [begin, end) along their velocities.
+    static void INTEGRATE(float* x, float* y, const float* x_speed, const float* y_speed, float seconds,
+                          std::size_t begin, std::size_t end) {
+        const Lanes dt = Lanes::splat(seconds);
+        std::size_t i  = begin;
+        for (; i + Lanes::WIDTH <= end; i += Lanes::WIDTH) {
+            (Lanes::load(x + i) + Lanes::load(x_speed + i) * dt).store(x + i);
+            (Lanes::load(y + i) + Lanes::load(y_speed + i) * dt).store(y + i);
+        }
+        for (; i < end; i++) {
+            x[i] += x_speed[i] * seconds;
+            y[i] += y_speed[i] * seconds;
+        }
+    }
+
+    static void WRITE_QUAD(SDL_Vertex* quad, float left, float top, float right, float bottom,
+                           float u0, float v0, float u1, float v1, const SDL_Color& tint) {
+        quad[0] = {{left, top}, tint, {u0, v0}};
+        quad[1] = {{right, top}, tint, {u1, v0}};
+        quad[2] = {{right, bottom}, tint, {u1, v1}};
+        quad[3] = {{left, bottom}, tint, {u0, v1}};
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    SpriteSystem::SpriteSystem() : m_size(0) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    SpriteSystem::SpriteId SpriteSystem::add(const TexturePtr& texture, const SDL_Rect& source, float x, float y,
+                                             const SDL_Color& tint) {
+        if (!texture) { return INVALID_SPRITE; }
+        return add_to_group(group_for(texture.get(), texture), source, x, y, tint);
+    }
+
+    SpriteSystem::SpriteId SpriteSystem::add(SDL_Texture* texture, const SDL_Rect& source, float x, float y,
+                                             const SDL_Color& tint) {
+        if (!texture) { return INVALID_SPRITE; }
+        return add_to_group(group_for(texture, nullptr), source, x, y, tint);
+    }
+
+    void SpriteSystem::remove(SpriteId sprite) {
+        if (!contains(sprite)) { return; }
+
+        // The group's last sprite moves into the hole, so the arrays stay packed.
+        Location    location = m_locations[sprite];
+        Group&      group    = m_groups[location.group];
+        std::size_t hole     = location.index;
+        std::size_t last     = group.size() - 1;
+        auto move_last = [hole, last](auto& field) {
+            field[hole] = field[last];
+            field.pop_back();
+        };
+        move_last(group.x);
+        move_last(group.y);
+        move_last(group.x_speed);
+        move_last(group.y_speed);
+        move_last(group.half_width);
+        move_last(group.half_height);
+        move_last(group.scale);
+        move_last(group.u0);
+        move_last(group.v0);
+        move_last(group.u1);
+        move_last(group.v1);
+        move_last(group.tint);
+        move_last(group.ids);
+        if (hole != last) { m_locations[group.ids[hole]].index = static_cast<std::uint32_t>(hole); }
+
+        // An empty group forgets its texture, which may be freed and another made at the same address, but
+        // keeps its arrays' capacity for whichever texture group_for() gives it next.
+        if (group.ids.empty()) {
+            group.texture = nullptr;
+            group.owner.reset();
+            group.texture_width  = 0;
+            group.texture_height = 0;
+        }
+
+        m_locations[sprite] = {NO_GROUP, 0};
+        m_free_ids.push_back(sprite);
+        m_size--;
+    }
+
+    void SpriteSystem::clear() {
+        m_groups.clear();
+        m_locations.clear();
+        m_free_ids.clear();
+        m_size = 0;
+    }
+
+    bool SpriteSystem::contains(SpriteId sprite) const {
+        return sprite < m_locations.size() && m_locations[sprite].group != NO_GROUP;
+    }
+
+    std::size_t SpriteSystem::size() const { return m_size; }
+
+    SDL_FPoint SpriteSystem::position(SpriteId sprite) const {
+        const Location& location = locate(sprite);
+        const Group&    group    = m_groups[location.group];
+        return {group.x[location.index], group.y[location.index]};
+    }
+
+    void SpriteSystem::position(SpriteId sprite, float x, float y) {
+        const Location& location = locate(sprite);
+        m_groups[location.group].x[location.index] = x;
+        m_groups[location.group].y[location.index] = y;
+    }
+
+    SDL_FPoint SpriteSystem::velocity(SpriteId sprite) const {
+        const Location& location = locate(sprite);
+        const Group&    group    = m_groups[location.group];
+        return {group.x_speed[location.index], group.y_speed[location.index]};
+    }
+
+    void SpriteSystem::velocity(SpriteId sprite, float x_speed, float y_speed) {
+        const Location& location = locate(sprite);
+        m_groups[location.group].x_speed[location.index] = x_speed;
+        m_groups[location.group].y_speed[location.index] = y_speed;
+    }
+
+    float SpriteSystem::scale(SpriteId sprite) const {
+        const Location& location = locate(sprite);
+        return m_groups[location.group].scale[location.index];
+    }
+
+    void SpriteSystem::scale(SpriteId sprite, float new_scale) {
+        const Location& location = locate(sprite);
+        m_groups[location.group].scale[location.index] = new_scale;
+    }
+
+    void SpriteSystem::tint(SpriteId sprite, const SDL_Color& color) {
+        const Location& location = locate(sprite);
+        m_groups[location.group].tint[location.index] = color;
+    }
+
+    void SpriteSystem::integrate(float seconds) {
+        for (Group& group : m_groups) {
+            Core::JobSystem::access().parallel_for(group.size(), INTEGRATE_BATCH_SIZE,
+                                                   [&group, seconds](std::size_t begin, std::size_t end) {
+                INTEGRATE(group.x.data(), group.y.data(), group.x_speed.data(), group.y_speed.data(), seconds,
+                          begin, end);
+            });
+        }
+    }
+
+    void SpriteSystem::render(BatchRenderer& batch, const SDL_FRect& view, int layer) {
+        m_last_render = Stats{m_size, 0, 0};
+        for (const Group& group : m_groups) {
+            if (group.ids.empty()) { continue; }
+
+            // Room for every sprite in the group is claimed up front, and what culling leaves unused handed back.
+            const auto  capacity = static_cast<int>(group.size());
+            SDL_Vertex* vertices = batch.add_quads(group.texture, capacity, layer);
+            const int   visible  = emit_quads(group, view, vertices);
+            batch.trim_quads(capacity - visible);
+
+            m_last_render.visible += static_cast<std::size_t>(visible);
+            if (visible > 0) { m_last_render.textures++; }
+        }
+    }
+
+    const SpriteSystem::Stats& SpriteSystem::last_render_stats() const { return m_last_render; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    SpriteSystem::SpriteId SpriteSystem::add_to_group(std::uint32_t group_index, const SDL_Rect& source,
+                                                      float x, float y, const SDL_Color& tint) {
+        Group&      group = m_groups[group_index];
+        const float w     = static_cast<float>(group.texture_width);
+        const float h     = static_cast<float>(group.texture_height);
+
+        SpriteId sprite;
+        if (!m_free_ids.empty()) {
+            sprite = m_free_ids.back();
+            m_free_ids.pop_back();
+        } else {
+            sprite = static_cast<SpriteId>(m_locations.size());
+            m_locations.push_back({NO_GROUP, 0});
+        }
+        m_locations[sprite] = {group_index, static_cast<std::uint32_t>(group.size())};
+
+        group.x.push_back(x);
+        group.y.push_back(y);
+        group.x_speed.push_back(0.0f);
+        group.y_speed.push_back(0.0f);
+        group.half_width.push_back(static_cast<float>(source.w) * 0.5f);
+        group.half_height.push_back(static_cast<float>(source.h) * 0.5f);
+        group.scale.push_back(1.0f);
+        group.u0.push_back(static_cast<float>(source.x) / w);
+        group.v0.push_back(static_cast<float>(source.y) / h);
+        group.u1.push_back(static_cast<float>(source.x + source.w) / w);
+        group.v1.push_back(static_cast<float>(source.y + source.h) / h);
+        group.tint.push_back(tint);
+        group.ids.push_back(sprite);
+        m_size++;
+        return sprite;
+    }
+
+    std::uint32_t SpriteSystem::group_for(SDL_Texture* texture, const TexturePtr& owner) {
+        std::size_t unused = m_groups.size();
+        for (std::size_t i = 0; i < m_groups.size(); i++) {
+            if (m_groups[i].texture == texture) {
+                if (owner && !m_groups[i].owner) { m_groups[i].owner = owner; }
+                return static_cast<std::uint32_t>(i);
+            }
+            if (!m_groups[i].texture && unused == m_groups.size()) { unused = i; }
+        }
+
+        // Emptied groups are reused rather than erased, since erasing would move every later group's index.
+        if (unused == m_groups.size()) { m_groups.emplace_back(); }
+        Group& group  = m_groups[unused];
+        group.texture = texture;
+        group.owner   = owner;
+        SDL_QueryTexture(texture, nullptr, nullptr, &group.texture_width, &group.texture_height);
+        group.texture_width  = std::max(group.texture_width, 1);
+        group.texture_height = std::max(group.texture_height, 1);
+        return static_cast<std::uint32_t>(unused);
+    }
+
+    const SpriteSystem::Location& SpriteSystem::locate(SpriteId sprite) const {
+        assert(contains(sprite) && "Not a sprite in this system.");
+        return m_locations[sprite];
+    }
+
+    int SpriteSystem::emit_quads(const Group& group, const SDL_FRect& view, SDL_Vertex* vertices) {
+        const std::size_t count   = group.size();
+        int               written = 0;
+
+        // Cull and find the corners several sprites at a time, in view space. Only the survivors' vertices
+        // are written, which is the one part that has to go sprite by sprite.
+        const Lanes view_left   = Lanes::splat(view.x);
+        const Lanes view_top    = Lanes::splat(view.y);
+        const Lanes view_width  = Lanes::splat(view.w);
+        const Lanes view_height = Lanes::splat(view.h);
+        const Lanes zero        = Lanes::splat(0.0f);
+
+        alignas(32) float left[Lanes::WIDTH], top[Lanes::WIDTH], right[Lanes::WIDTH], bottom[Lanes::WIDTH];
+        std::size_t i = 0;
+        for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH) {
+            const Lanes scale    = Lanes::load(group.scale.data() + i);
+            const Lanes center_x = Lanes::load(group.x.data() + i) - view_left;
+            const Lanes center_y = Lanes::load(group.y.data() + i) - view_top;
+            const Lanes extent_x = Lanes::load(group.half_width.data() + i) * scale;
+            const Lanes extent_y = Lanes::load(group.half_height.data() + i) * scale;
+            const Lanes l        = center_x - extent_x;
+            const Lanes t        = center_y - extent_y;
+            const Lanes r        = center_x + extent_x;
+            const Lanes b        = center_y + extent_y;
+
+            int visible = Lanes::less_equal_mask(zero, r) & Lanes::less_equal_mask(l, view_width) &
+                          Lanes::less_equal_mask(zero, b) & Lanes::less_equal_mask(t, view_height);
+            if (visible == 0) { continue; }
+
+            l.store(left);
+            t.store(top);
+            r.store(right);
+            b.store(bottom);
+            for (int lane = 0; lane < Lanes::WIDTH; lane++) {
+                if (!(visible & (1 << lane))) { continue; }
+                const std::size_t sprite = i + static_cast<std::size_t>(lane);
+                WRITE_QUAD(vertices + written * 4, left[lane], top[lane], right[lane], bottom[lane],
+                           group.u0[sprite], group.v0[sprite], group.u1[sprite], group.v1[sprite], group.tint[sprite]);
+                written++;
+            }
+        }
+
+        for (; i < count; i++) {
+            const float center_x = group.x[i] - view.x;
+            const float center_y = group.y[i] - view.y;
+            const float extent_x = group.half_width[i] * group.scale[i];
+            const float extent_y = group.half_height[i] * group.scale[i];
+            const float l = center_x - extent_x, t = center_y - extent_y;
+            const float r = center_x + extent_x, b = center_y + extent_y;
+            if (r < 0.0f || l > view.w || b < 0.0f || t > view.h) { continue; }
+
+            WRITE_QUAD(vertices + written * 4, l, t, r, b,
+                       group.u0[i], group.v0[i], group.u1[i], group.v1[i], group.tint[i]);
+            written++;
+        }
+        return written;
+    }
+
+} // Rendering namespace
@@ -0,0 +1,153 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_SPRITE_SYSTEM_H
+#define GOLD_CARTRIDGE_SPRITE_SYSTEM_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SDL_rect.h>
+#include <SDL_render.h>
+
+#include "BatchRenderer.h"
+
+namespace Rendering {
+
+    /**
+     * @brief Stores large numbers of moving sprites as arrays of fields, and draws them with one batch per texture.
+     *
+     * Sprites are grouped by texture. Each group keeps every field in its own
+     * array (positions, velocities, sizes, texture coordinates and tints), so
+     * the per-frame loops read memory front to back and run several sprites
+     * per instruction through Core::FloatLanes. Moving, culling and building
+     * quads never touch a sprite's other fields, and no sprite is visited one
+     * virtual call at a time.
+     *
+     * integrate() moves every sprite by its velocity, split across the job
+     * system's workers for large counts. render() culls against the view and
+     * writes the visible sprites' quads straight into a BatchRenderer, one
+     * submission per texture, so each texture is a single draw call.
+     *
+     * Positions are the sprites' centers, in world pixels.
+     */
+    class SpriteSystem {
+    public:
+        using SpriteId = std::uint32_t;
+        using TexturePtr = BatchRenderer::TexturePtr;
+
+        static constexpr SpriteId INVALID_SPRITE = ~SpriteId{0};
+
+        struct Stats {
+            std::size_t sprites  = 0;
+            std::size_t visible  = 0; ///< Sprites that overlapped the view and were queued.
+            std::size_t textures = 0; ///< Submissions made, one per texture with visible sprites.
+        };
+
+    public:
+        SpriteSystem();
+
+        SpriteSystem(const SpriteSystem&) = delete;
+        void operator=(const SpriteSystem&) = delete;
+
+        /**
+         * Adds a sprite.
+         * @param texture The texture to draw from. The system holds a reference to it while any sprite uses it.
+         * @param source The area of the texture to draw, such as a SpriteAtlas sprite's source.
+         * @param x The x-coordinate of the sprite's center, in world pixels.
+         * @param y The y-coordinate of the sprite's center, in world pixels.
+         * @param tint A color to multiply the texture's colors with.
+         * @return The new sprite's id, or INVALID_SPRITE if the texture is null.
+         */
+        SpriteId add(const TexturePtr& texture, const SDL_Rect& source, float x, float y,
+                     const SDL_Color& tint = {255, 255, 255, 255});
+
+        /// Adds a sprite using a texture the caller keeps alive for as long as the sprite exists.
+        SpriteId add(SDL_Texture* texture, const SDL_Rect& source, float x, float y,
+                     const SDL_Color& tint = {255, 255, 255, 255});
+
+        /// Removes a sprite. Its id may be handed out again by a later add().
+        void remove(SpriteId sprite);
+        void clear();
+        bool contains(SpriteId sprite) const;
+        std::size_t size() const;
+
+        SDL_FPoint position(SpriteId sprite) const;
+        void position(SpriteId sprite, float x, float y);
+
+        /// Pixels per second.
+        SDL_FPoint velocity(SpriteId sprite) const;
+        void velocity(SpriteId sprite, float x_speed, float y_speed);
+
+        /// A multiple of the source rectangle's size. Scaling keeps the sprite centered on its position.
+        float scale(SpriteId sprite) const;
+        void scale(SpriteId sprite, float new_scale);
+
+        void tint(SpriteId sprite, const SDL_Color& color);
+
+        /**
+         * Moves every sprite by its velocity.
+         * @param seconds The time to move for, usually the update interval.
+         */
+        void integrate(float seconds);
+
+        /**
+         * Queues every sprite that overlaps the view.
+         * @param batch The batch to write quads into. Sprites are queued one submission per texture.
+         * @param view The part of the world to draw, in world pixels. Its top left corner is drawn at the top
+         *             left of the render target.
+         * @param layer The batch layer to queue the sprites on.
+         */
+        void render(BatchRenderer& batch, const SDL_FRect& view, int layer = 0);
+
+        const Stats& last_render_stats() const;
+
+    private:
+        /// Every sprite that shares a texture, one array per field, all indexed alike.
+        struct Group {
+            SDL_Texture* texture;
+            TexturePtr   owner; ///< Null when the caller keeps the texture alive.
+            int          texture_width;
+            int          texture_height;
+
+            std::vector<float>     x, y;
+            std::vector<float>     x_speed, y_speed;
+            std::vector<float>     half_width, half_height; ///< Half the source size, before scaling.
+            std::vector<float>     scale;
+            std::vector<float>     u0, v0, u1, v1;
+            std::vector<SDL_Color> tint;
+            std::vector<SpriteId>  ids;
+
+            std::size_t size() const { return ids.size(); }
+        };
+
+        struct Location {
+            std::uint32_t group;
+            std::uint32_t index;
+        };
+
+        SpriteId add_to_group(std::uint32_t group_index, const SDL_Rect& source, float x, float y,
+                              const SDL_Color& tint);
+        std::uint32_t group_for(SDL_Texture* texture, const TexturePtr& owner);
+        const Location& locate(SpriteId sprite) const;
+
+        /// Writes the visible sprites' quads. Returns how many were written.
+        static int emit_quads(const Group& group, const SDL_FRect& view, SDL_Vertex* vertices);
+
+    private:
+        std::vector<Group>    m_groups;
+        std::vector<Location> m_locations; ///< Indexed by sprite id.
+        std::vector<SpriteId> m_free_ids;
+        std::size_t           m_size;
+        Stats                 m_last_render;
+    };
+
+} // Rendering namespace
+
+#endif //GOLD_CARTRIDGE_SPRITE_SYSTEM_H
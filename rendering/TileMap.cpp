@@ -0,0 +1,303 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "TileMap.h"
+#include "../core/Logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace Rendering {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+    namespace {
+        const std::size_t DEFAULT_MAX_RESIDENT_CHUNKS = 4096;
+        const std::size_t DEFAULT_MAX_CACHED_TEXTURES = 64;
+        const std::size_t MAX_SPARE_TEXTURES          = 8;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    /// Divides, rounding towards negative infinity, so that chunks left of and above the origin line up.
+    static int FLOOR_DIVIDE(int value, int divisor) {
+        int quotient = value / divisor;
+        return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+    }
+
+    static std::uint64_t CHUNK_KEY(int chunk_x, int chunk_y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunk_x)) << 32) |
+               static_cast<std::uint32_t>(chunk_y);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+    TileMap::TileMap(Tileset tileset, int chunk_tiles)
+            : m_tileset(std::move(tileset)),
+              m_tileset_columns(1),
+              m_tileset_width(1),
+              m_tileset_height(1),
+              m_chunk_tiles(std::max(chunk_tiles, 1)),
+              m_max_resident_chunks(DEFAULT_MAX_RESIDENT_CHUNKS),
+              m_max_cached_textures(DEFAULT_MAX_CACHED_TEXTURES),
+              m_cached_textures(0),
+              m_frame(0) {
+        assert(m_tileset.tile_width > 0 && m_tileset.tile_height > 0);
+        if (m_tileset.texture) {
+            SDL_QueryTexture(m_tileset.texture.get(), nullptr, nullptr, &m_tileset_width, &m_tileset_height);
+            m_tileset_columns = std::max(m_tileset_width / m_tileset.tile_width, 1);
+        }
+    }
+
+    TileMap::TileMap(Tileset tileset, std::unique_ptr<Core::ChunkStore> store)
+            : TileMap(std::move(tileset), store ? store->chunk_tiles() : 32) {
+        m_store = std::move(store);
+    }
+
+    TileMap::~TileMap() { save_changes(); }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    TileMap::Tile TileMap::tile(int x, int y) {
+        const int chunk_x = FLOOR_DIVIDE(x, m_chunk_tiles);
+        const int chunk_y = FLOOR_DIVIDE(y, m_chunk_tiles);
+        Chunk*    chunk   = chunk_at(chunk_x, chunk_y, false);
+        if (!chunk) { return EMPTY_TILE; }
+        return chunk->tiles[(y - chunk_y * m_chunk_tiles) * m_chunk_tiles + (x - chunk_x * m_chunk_tiles)];
+    }
+
+    void TileMap::tile(int x, int y, Tile new_tile) {
+        const int chunk_x = FLOOR_DIVIDE(x, m_chunk_tiles);
+        const int chunk_y = FLOOR_DIVIDE(y, m_chunk_tiles);
+        Chunk*    chunk   = chunk_at(chunk_x, chunk_y, new_tile != EMPTY_TILE);
+        if (!chunk) { return; }
+
+        Tile& tile = chunk->tiles[(y - chunk_y * m_chunk_tiles) * m_chunk_tiles + (x - chunk_x * m_chunk_tiles)];
+        if (tile == new_tile) { return; }
+        chunk->tile_count += (new_tile != EMPTY_TILE) - (tile != EMPTY_TILE);
+        tile                    = new_tile;
+        chunk->texture_is_stale = true;
+        chunk->is_modified      = true;
+    }
+
+    void TileMap::render(BatchRenderer& batch, const SDL_FRect& camera, int layer) {
+        m_frame++;
+        m_last_render = Stats{};
+
+        // Whole pixels, so neighbouring chunks always meet without a seam.
+        const int origin_x     = static_cast<int>(std::floor(camera.x));
+        const int origin_y     = static_cast<int>(std::floor(camera.y));
+        const int chunk_width  = m_chunk_tiles * m_tileset.tile_width;
+        const int chunk_height = m_chunk_tiles * m_tileset.tile_height;
+        const int first_x      = FLOOR_DIVIDE(origin_x, chunk_width);
+        const int first_y      = FLOOR_DIVIDE(origin_y, chunk_height);
+        const int last_x       = FLOOR_DIVIDE(origin_x + static_cast<int>(std::ceil(camera.w)), chunk_width);
+        const int last_y       = FLOOR_DIVIDE(origin_y + static_cast<int>(std::ceil(camera.h)), chunk_height);
+
+        m_visible.clear();
+        bool needs_rebuild = false;
+        for (int chunk_y = first_y; chunk_y <= last_y; chunk_y++) {
+            for (int chunk_x = first_x; chunk_x <= last_x; chunk_x++) {
+                Chunk* chunk = chunk_at(chunk_x, chunk_y, false);
+                if (!chunk) { continue; }
+                chunk->last_seen_frame = m_frame;
+                if (chunk->tile_count == 0) { continue; }
+                m_visible.push_back(chunk);
+                needs_rebuild = needs_rebuild || !chunk->texture || chunk->texture_is_stale;
+            }
+        }
+
+        if (needs_rebuild) {
+            // Whatever is already queued belongs on the current target, underneath the map.
+            batch.flush();
+            SDL_Renderer* renderer        = batch.renderer();
+            SDL_Texture*  previous_target = SDL_GetRenderTarget(renderer);
+            Uint8         previous_r, previous_g, previous_b, previous_a;
+            SDL_GetRenderDrawColor(renderer, &previous_r, &previous_g, &previous_b, &previous_a);
+            for (Chunk* chunk : m_visible) {
+                if (!chunk->texture || chunk->texture_is_stale) { rebuild(*chunk, batch); }
+            }
+            SDL_SetRenderTarget(renderer, previous_target);
+            SDL_SetRenderDrawColor(renderer, previous_r, previous_g, previous_b, previous_a);
+        }
+
+        for (Chunk* chunk : m_visible) {
+            if (!chunk->texture) { continue; }
+            const SDL_Rect source = {0, 0, chunk_width, chunk_height};
+            const SDL_Rect dest   = {chunk->x * chunk_width - origin_x, chunk->y * chunk_height - origin_y,
+                                     chunk_width, chunk_height};
+            batch.copy(chunk->texture.get(), source, dest, layer);
+            m_last_render.chunks_drawn++;
+        }
+
+        evict_stale_textures();
+        evict_stale_chunks();
+        m_last_render.chunks_resident = m_chunks.size();
+        m_last_render.textures_cached = m_cached_textures;
+    }
+
+    void TileMap::max_resident_chunks(std::size_t chunk_count) {
+        m_max_resident_chunks = std::max<std::size_t>(chunk_count, 1);
+    }
+    void TileMap::max_cached_textures(std::size_t texture_count) { m_max_cached_textures = texture_count; }
+
+    void TileMap::save_changes() {
+        if (!m_store) { return; }
+        for (auto& [key, chunk] : m_chunks) {
+            if (chunk.is_modified && m_store->save(chunk.x, chunk.y, chunk.tiles.data())) { chunk.is_modified = false; }
+        }
+    }
+
+    void TileMap::release_textures() {
+        for (auto& [key, chunk] : m_chunks) { chunk.texture.reset(); }
+        m_spare_textures.clear();
+        m_cached_textures = 0;
+    }
+
+    int TileMap::chunk_tiles() const { return m_chunk_tiles; }
+
+    const TileMap::Stats& TileMap::last_render_stats() const { return m_last_render; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    TileMap::Chunk* TileMap::chunk_at(int chunk_x, int chunk_y, bool create) {
+        const std::uint64_t key   = CHUNK_KEY(chunk_x, chunk_y);
+        auto                found = m_chunks.find(key);
+        if (found != m_chunks.end()) { return &found->second; }
+
+        const auto        tiles_per_chunk = static_cast<std::size_t>(m_chunk_tiles) * m_chunk_tiles;
+        std::vector<Tile> tiles(tiles_per_chunk, EMPTY_TILE);
+        bool              loaded = m_store && m_store->load(chunk_x, chunk_y, tiles.data());
+        if (loaded) { m_last_render.chunks_loaded++; }
+
+        const int tile_count = static_cast<int>(
+                std::count_if(tiles.begin(), tiles.end(), [](Tile tile) { return tile != EMPTY_TILE; }));
+        // With a store, every chunk it holds is kept once loaded, so empty ones aren't read again every frame,
+        // and nothing outside it is kept since it could never be saved. Without one, only chunks that are about
+        // to get tiles are made.
+        if (m_store ? !loaded : !create) { return nullptr; }
+
+        Chunk chunk{chunk_x, chunk_y, std::move(tiles), tile_count, SDL_TexturePtr(nullptr, SDL_DestroyTexture),
+                    true, false, m_frame};
+        return &m_chunks.emplace(key, std::move(chunk)).first->second;
+    }
+
+    void TileMap::rebuild(Chunk& chunk, BatchRenderer& batch) {
+        SDL_Renderer* renderer     = batch.renderer();
+        const int     chunk_width  = m_chunk_tiles * m_tileset.tile_width;
+        const int     chunk_height = m_chunk_tiles * m_tileset.tile_height;
+
+        if (!chunk.texture) {
+            if (!m_spare_textures.empty()) {
+                chunk.texture = std::move(m_spare_textures.back());
+                m_spare_textures.pop_back();
+            } else {
+                chunk.texture.reset(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                                      chunk_width, chunk_height));
+                if (!chunk.texture) {
+                    LOG_ERROR("Could not create a tile map chunk texture: %s", SDL_GetError());
+                    return;
+                }
+                SDL_SetTextureBlendMode(chunk.texture.get(), SDL_BLENDMODE_BLEND);
+            }
+            m_cached_textures++;
+        }
+
+        SDL_SetRenderTarget(renderer, chunk.texture.get());
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+
+        SDL_Vertex*     quad        = batch.add_quads(m_tileset.texture.get(), chunk.tile_count);
+        int             quads_used  = 0;
+        const float     u_per_pixel = 1.0f / static_cast<float>(m_tileset_width);
+        const float     v_per_pixel = 1.0f / static_cast<float>(m_tileset_height);
+        const float     tile_width  = static_cast<float>(m_tileset.tile_width);
+        const float     tile_height = static_cast<float>(m_tileset.tile_height);
+        const SDL_Color white       = {255, 255, 255, 255};
+        for (int row = 0; row < m_chunk_tiles; row++) {
+            for (int column = 0; column < m_chunk_tiles; column++) {
+                Tile tile = chunk.tiles[row * m_chunk_tiles + column];
+                if (tile == EMPTY_TILE) { continue; }
+
+                const int   index = tile - 1;
+                const float u0    = static_cast<float>((index % m_tileset_columns) * m_tileset.tile_width) * u_per_pixel;
+                const float v0    = static_cast<float>((index / m_tileset_columns) * m_tileset.tile_height) * v_per_pixel;
+                const float u1    = u0 + tile_width * u_per_pixel;
+                const float v1    = v0 + tile_height * v_per_pixel;
+                const float left  = static_cast<float>(column) * tile_width;
+                const float top   = static_cast<float>(row) * tile_height;
+                quad[0] = {{left, top}, white, {u0, v0}};
+                quad[1] = {{left + tile_width, top}, white, {u1, v0}};
+                quad[2] = {{left + tile_width, top + tile_height}, white, {u1, v1}};
+                quad[3] = {{left, top + tile_height}, white, {u0, v1}};
+                quad += 4;
+                quads_used++;
+            }
+        }
+        batch.trim_quads(chunk.tile_count - quads_used);
+        batch.flush();
+
+        chunk.texture_is_stale = false;
+        m_last_render.chunks_rebuilt++;
+    }
+
+    void TileMap::evict_stale_textures() {
+        if (m_cached_textures <= m_max_cached_textures) { return; }
+
+        // The textures of the chunks seen longest ago go first. Chunks in view were seen this frame and stay.
+        std::vector<Chunk*> candidates;
+        for (auto& [key, chunk] : m_chunks) {
+            if (chunk.texture && chunk.last_seen_frame != m_frame) { candidates.push_back(&chunk); }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Chunk* a, const Chunk* b) { return a->last_seen_frame < b->last_seen_frame; });
+
+        for (Chunk* chunk : candidates) {
+            if (m_cached_textures <= m_max_cached_textures) { break; }
+            if (m_spare_textures.size() < MAX_SPARE_TEXTURES) { m_spare_textures.push_back(std::move(chunk->texture)); }
+            chunk->texture.reset();
+            chunk->texture_is_stale = true;
+            m_cached_textures--;
+        }
+    }
+
+    void TileMap::evict_stale_chunks() {
+        if (m_chunks.size() <= m_max_resident_chunks) { return; }
+
+        std::vector<std::uint64_t> candidates;
+        for (auto& [key, chunk] : m_chunks) {
+            if (chunk.last_seen_frame != m_frame) { candidates.push_back(key); }
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](std::uint64_t a, std::uint64_t b) {
+            return m_chunks.at(a).last_seen_frame < m_chunks.at(b).last_seen_frame;
+        });
+
+        for (std::uint64_t key : candidates) {
+            if (m_chunks.size() <= m_max_resident_chunks) { break; }
+            Chunk& chunk = m_chunks.at(key);
+
+            // Without a store, dropping a chunk would lose its tiles, so only stores let chunks go.
+            if (!m_store) { break; }
+            if (chunk.is_modified && !m_store->save(chunk.x, chunk.y, chunk.tiles.data())) { continue; }
+            if (chunk.texture) { m_cached_textures--; }
+            m_chunks.erase(key);
+        }
+    }
+
+} // Rendering namespace
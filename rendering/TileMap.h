@@ -0,0 +1,151 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_TILE_MAP_H
+#define GOLD_CARTRIDGE_TILE_MAP_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_rect.h>
+#include <SDL_render.h>
+
+#include "../core/ChunkStore.h"
+#include "BatchRenderer.h"
+
+namespace Rendering {
+
+    /**
+     * @brief A grid of tiles drawn a chunk at a time from textures that are only redrawn when their tiles change.
+     *
+     * The map is split into square chunks of tiles. The first time a chunk is
+     * seen, its tiles are drawn once into a render target texture of its own.
+     * From then on, drawing the chunk is a single texture copy until one of
+     * its tiles changes. A frame then costs one copy per chunk in view, however
+     * many tiles those chunks hold.
+     *
+     * Chunk tiles and chunk textures are both kept only for the most recently
+     * seen chunks. With a Core::ChunkStore, chunks are loaded from it when
+     * they come into view and changed chunks are saved back before they are
+     * let go, so maps far bigger than memory can be scrolled through. Without
+     * one, the map is unbounded and only chunks holding tiles take memory.
+     *
+     * Tile 0 is empty. Tile n draws the nth tile of the tileset, counting
+     * from 1, left to right and then top to bottom.
+     */
+    class TileMap {
+    public:
+        using Tile = Core::ChunkStore::Tile;
+        using TexturePtr = BatchRenderer::TexturePtr;
+
+        static constexpr Tile EMPTY_TILE = 0;
+
+        struct Tileset {
+            TexturePtr texture;
+            int        tile_width;  ///< In pixels.
+            int        tile_height; ///< In pixels.
+        };
+
+        struct Stats {
+            std::size_t chunks_drawn    = 0; ///< Chunks in view with at least one tile, each one texture copy.
+            std::size_t chunks_rebuilt  = 0; ///< Chunks whose textures were redrawn because their tiles changed.
+            std::size_t chunks_loaded   = 0; ///< Chunks read from the store.
+            std::size_t chunks_resident = 0; ///< Chunks whose tiles are in memory.
+            std::size_t textures_cached = 0;
+        };
+
+    public:
+        /**
+         * Makes an unbounded map that lives entirely in memory.
+         * @param chunk_tiles The width and height of each chunk, in tiles.
+         */
+        explicit TileMap(Tileset tileset, int chunk_tiles = 32);
+
+        /// Makes a map that loads chunks from a store as they're needed, and saves changed ones back.
+        TileMap(Tileset tileset, std::unique_ptr<Core::ChunkStore> store);
+
+        /// Saves every changed chunk to the store.
+        ~TileMap();
+
+        TileMap(const TileMap&) = delete;
+        void operator=(const TileMap&) = delete;
+
+        /// The tile at a tile coordinate. Loads the chunk holding it if it isn't in memory.
+        Tile tile(int x, int y);
+
+        /// Changes a tile. Its chunk's texture is redrawn the next time the chunk is in view.
+        void tile(int x, int y, Tile new_tile);
+
+        /**
+         * Queues the chunks in view, each as one texture copy. Chunks whose tiles changed are redrawn first.
+         * @param batch The batch to queue on. Anything already in it is flushed if a chunk needs redrawing.
+         * @param camera The part of the map to draw, in map pixels. Its top left corner is drawn at the top
+         *               left of the render target.
+         * @param layer The batch layer to queue the chunks on.
+         */
+        void render(BatchRenderer& batch, const SDL_FRect& camera, int layer = 0);
+
+        /// The most chunks whose tiles are kept in memory. Chunks in view are always kept.
+        void max_resident_chunks(std::size_t chunk_count);
+
+        /// The most chunk textures kept. Each holds a whole chunk's pixels, so they cost far more than the tiles.
+        void max_cached_textures(std::size_t texture_count);
+
+        /// Writes every changed chunk to the store, if there is one.
+        void save_changes();
+
+        /// Frees every chunk texture. They have to go before the renderer they were made with is destroyed.
+        void release_textures();
+
+        int chunk_tiles() const;
+        const Stats& last_render_stats() const;
+
+    private:
+        using SDL_TexturePtr = std::unique_ptr<SDL_Texture, void (*)(SDL_Texture*)>;
+
+        struct Chunk {
+            int               x, y;
+            std::vector<Tile> tiles;
+            int               tile_count;       ///< Tiles that aren't empty.
+            SDL_TexturePtr    texture;
+            bool              texture_is_stale; ///< The tiles changed since the texture was drawn.
+            bool              is_modified;      ///< The tiles changed since they were loaded or saved.
+            std::uint64_t     last_seen_frame;
+        };
+
+        /**
+         * The chunk at a chunk coordinate, loading it from the store if needed. Null if the store doesn't hold
+         * it, or, without a store, if it was never given tiles and create is false.
+         */
+        Chunk* chunk_at(int chunk_x, int chunk_y, bool create);
+        void rebuild(Chunk& chunk, BatchRenderer& batch);
+        void evict_stale_chunks();
+        void evict_stale_textures();
+
+    private:
+        Tileset                                  m_tileset;
+        int                                      m_tileset_columns;
+        int                                      m_tileset_width;
+        int                                      m_tileset_height;
+        int                                      m_chunk_tiles;
+        std::unique_ptr<Core::ChunkStore>        m_store;
+        std::unordered_map<std::uint64_t, Chunk> m_chunks;
+        std::vector<SDL_TexturePtr>              m_spare_textures; ///< Evicted textures kept for reuse.
+        std::vector<Chunk*>                      m_visible;
+        std::size_t                              m_max_resident_chunks;
+        std::size_t                              m_max_cached_textures;
+        std::size_t                              m_cached_textures;
+        std::uint64_t                            m_frame;
+        Stats                                    m_last_render;
+    };
+
+} // Rendering namespace
+
+#endif //GOLD_CARTRIDGE_TILE_MAP_H
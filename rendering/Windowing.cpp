@@ -7,13 +7,22 @@
  */
 
 #include "Windowing.h"
+#include "../core/AllocationCounter.h"
+#include "../core/FontManager.h"
 #include "../core/System.h"
+#include "../core/TextureManager.h"
+#include "../core/TexturePixels.h"
+#include "../ui/Container.h"
 #include "Colors.h"
+#include "SoftwareRasterizer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <thread>
 #include <SDL_events.h>
 #include <SDL_render.h>
+#include <SDL_surface.h>
 #include <SDL_video.h>
 
 namespace Rendering {
@@ -28,43 +37,89 @@ namespace Rendering {
     static const SDL_Color   DEFAULT_CLEAR_COLOR           = Color::black();
     static const double      DEFAULT_UPDATE_INTERVAL       = 1000.00 / 60.0;
     static const int         DEFAULT_MAX_UPDATES_PER_FRAME = 4;
+    static const SDL_Color   SOFTWARE_CLEAR_COLOR          = {0, 0, 0, 0}; // Lets SDL drawing show through.
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Window constructors and destructors.
 ////////////////////////////////////////////////////////////////////////////////
 
-    Window::Window(int window_width, int window_height, std::string window_title)
+    Window::Window(int window_width, int window_height, std::string window_title, Backend backend)
             : m_window_width(window_width),
               m_window_height(window_height),
               m_window_title(std::move(window_title)),
+              m_backend(backend),
               m_update_interval_ms(DEFAULT_UPDATE_INTERVAL),
               m_max_updates_per_frame(DEFAULT_MAX_UPDATES_PER_FRAME),
+              m_interpolation_alpha(0.0),
+              m_threaded_simulation(false),
+              m_last_update_ns(0),
+              m_frame_start_allocations(0),
+              m_last_frame_allocations(0),
+              m_last_frame_pixels_redrawn(0),
+              m_framebuffer(nullptr, SDL_FreeSurface),
               m_window(nullptr, SDL_DestroyWindow),
               m_renderer(nullptr, SDL_DestroyRenderer) {
 
-        assert(Core::System::is_initialized());
-        m_window.reset(SDL_CreateWindow(m_window_title.c_str(),
-                                        SDL_WINDOWPOS_CENTERED,
-                                        SDL_WINDOWPOS_CENTERED,
-                                        m_window_width,
-                                        m_window_height,
-                                        SDL_WINDOW_SHOWN));
-        assert(m_window);
-
-        constexpr int first_valid_driver = -1;
-        m_renderer.reset(SDL_CreateRenderer(m_window.get(),
-                                            first_valid_driver,
-                                            SDL_RENDERER_ACCELERATED /*| SDL_RENDERER_PRESENTVSYNC*/));
-        assert(m_renderer);
+        // Starts SDL's video and event handling now if the application didn't ask for them up front.
+        Core::System::require(Core::System::Video | Core::System::Events |
+                              (m_backend == Backend::Software ? Core::System::Jobs : Core::System::Subsystems{0}));
+        if (m_backend == Backend::Headless) {
+            // No window and no GPU: SDL's software renderer draws straight into a surface we own.
+            m_framebuffer.reset(SDL_CreateRGBSurfaceWithFormat(0, m_window_width, m_window_height, 32,
+                                                               SDL_PIXELFORMAT_ARGB8888));
+            assert(m_framebuffer);
+
+            m_renderer.reset(SDL_CreateSoftwareRenderer(m_framebuffer.get()));
+            assert(m_renderer);
+        } else {
+            m_window.reset(SDL_CreateWindow(m_window_title.c_str(),
+                                            SDL_WINDOWPOS_CENTERED,
+                                            SDL_WINDOWPOS_CENTERED,
+                                            m_window_width,
+                                            m_window_height,
+                                            SDL_WINDOW_SHOWN));
+            assert(m_window);
+
+            // A software window's renderer only presents finished frames, so any renderer will do.
+            constexpr int first_valid_driver = -1;
+            m_renderer.reset(SDL_CreateRenderer(m_window.get(),
+                                                first_valid_driver,
+                                                m_backend == Backend::Software ? 0 : SDL_RENDERER_ACCELERATED));
+            assert(m_renderer);
+
+            SDL_DisplayMode display_mode;
+            if (SDL_GetWindowDisplayMode(m_window.get(), &display_mode) == 0 && display_mode.refresh_rate > 0) {
+                m_pacer.display_refresh_rate(display_mode.refresh_rate);
+            }
+        }
 
+        m_batch          = std::make_unique<BatchRenderer>(m_renderer.get());
+        if (m_backend == Backend::Software) {
+            // The rasterizer draws textures from the pixels they were made from, so those have to be kept.
+            Core::TexturePixels::access().keep_for(m_renderer.get());
+            m_rasterizer = std::make_unique<SoftwareRasterizer>(m_renderer.get(), m_window_width, m_window_height);
+            m_rasterizer->overlay(true);
+        }
         m_window_is_open = true;
+        pacing_mode(m_backend == Backend::Headless ? FramePacer::Mode::Unlimited : FramePacer::Mode::VSync);
     }
 
+    Window::Window(int window_width, int window_height, std::string window_title)
+            : Window(window_width, window_height, std::move(window_title), Backend::Onscreen) {}
+
     Window::Window() : Window(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, DEFAULT_WINDOW_TITLE) {}
 
     Window::~Window() {
+        // Cached text and image textures belong to the renderer, so they have to go first.
+        Core::FontManager::access().release_renderer(m_renderer.get());
+        Core::TextureManager::access().release_renderer(m_renderer.get());
+        for (auto& [widgets, handler] : m_attached_widgets) { widgets->release_layer(); }
+        m_batch.reset();
+        m_rasterizer.reset();
+        Core::TexturePixels::access().release_renderer(m_renderer.get());
         m_renderer.reset();
         m_window.reset();
+        m_framebuffer.reset();
     }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -72,7 +127,15 @@ namespace Rendering {
 ////////////////////////////////////////////////////////////////////////////////
 
     void Window::set_user_update_callback(UpdateCallback update_fn) { m_process_user_updates = std::move(update_fn); }
-    void Window::set_user_draw_callback(DrawCallback draw_fn) { m_process_user_rendering = std::move(draw_fn); }
+    void Window::set_user_draw_callback(DrawCallback draw_fn) {
+        // Kept separate rather than wrapped in an interpolated callback, so drawing is one call, not two.
+        m_process_user_drawing   = std::move(draw_fn);
+        m_process_user_rendering = nullptr;
+    }
+    void Window::set_user_draw_callback(InterpolatedDrawCallback draw_fn) {
+        m_process_user_rendering = std::move(draw_fn);
+        m_process_user_drawing   = nullptr;
+    }
 
     [[maybe_unused]] int Window::update_limit_per_frame() const { return m_max_updates_per_frame; }
     [[maybe_unused]] void Window::update_limit_per_frame(int new_update_limit) {
@@ -88,6 +151,56 @@ namespace Rendering {
     [[maybe_unused]] int Window::width() const { return m_window_width; }
     [[maybe_unused]] int Window::height() const { return m_window_height; }
 
+    [[maybe_unused]] SDL_Renderer* Window::renderer() const { return m_renderer.get(); }
+    [[maybe_unused]] BatchRenderer& Window::batch() { return *m_batch; }
+    [[maybe_unused]] SoftwareRasterizer* Window::rasterizer() { return m_rasterizer.get(); }
+    [[maybe_unused]] FrameProfiler& Window::profiler() { return m_profiler; }
+    [[maybe_unused]] FramePacer& Window::pacer() { return m_pacer; }
+    [[maybe_unused]] Core::EventDispatcher& Window::events() { return m_events; }
+    [[maybe_unused]] Core::FrameArena& Window::frame_arena() { return m_frame_arena; }
+    [[maybe_unused]] std::uint64_t Window::last_frame_allocations() const { return m_last_frame_allocations; }
+    [[maybe_unused]] std::uint64_t Window::last_frame_pixels_redrawn() const { return m_last_frame_pixels_redrawn; }
+
+    [[maybe_unused]] FramePacer::Mode Window::pacing_mode() const { return m_pacer.mode(); }
+    [[maybe_unused]] void Window::pacing_mode(FramePacer::Mode mode) {
+        // A headless renderer has no display to sync to, so only windows try.
+        bool wants_vsync = mode == FramePacer::Mode::VSync;
+        bool has_vsync   = m_backend != Backend::Headless && SDL_RenderSetVSync(m_renderer.get(), wants_vsync) == 0;
+        if (wants_vsync && !has_vsync) {
+            m_pacer.target_frame_rate(m_pacer.display_refresh_rate());
+            mode = FramePacer::Mode::Capped;
+        }
+        m_pacer.mode(mode);
+    }
+
+    [[maybe_unused]] void Window::request_redraw() { m_pacer.mark_dirty(); }
+
+    [[maybe_unused]] void Window::attach(UI::Container& widgets) {
+        detach(widgets);
+        auto handler = m_events.add_handler([&widgets](SDL_Event& event) { widgets.handle_event(event); });
+        m_attached_widgets.emplace_back(&widgets, handler);
+    }
+
+    [[maybe_unused]] void Window::detach(UI::Container& widgets) {
+        auto attached = std::find_if(m_attached_widgets.begin(), m_attached_widgets.end(),
+                                     [&](const auto& entry) { return entry.first == &widgets; });
+        if (attached == m_attached_widgets.end()) { return; }
+        m_events.remove_handler(attached->second);
+        m_attached_widgets.erase(attached);
+    }
+
+    [[maybe_unused]] bool Window::is_headless() const { return m_backend == Backend::Headless; }
+
+    [[maybe_unused]] double Window::interpolation_alpha() const { return m_interpolation_alpha; }
+
+    [[maybe_unused]] bool Window::threaded_simulation() const { return m_threaded_simulation; }
+    [[maybe_unused]] void Window::threaded_simulation(bool is_threaded) { m_threaded_simulation = is_threaded; }
+
+    [[maybe_unused]] void Window::post_to_simulation(SimulationTask task) {
+        std::lock_guard<std::mutex> lock(m_posted_tasks_mutex);
+        m_posted_tasks.push_back(std::move(task));
+    }
+
     /// Helper function for Window::run()
     static void START_WATCHING_FOR_WINDOW_CLOSE(Rendering::Window* window) {
         // NOTE: Multiple open windows are not supported by this code. SDL2
@@ -114,57 +227,211 @@ namespace Rendering {
 
         this->update(); // Create an initial state to render.
 
+        if (m_threaded_simulation) {
+            run_threaded();
+            return;
+        }
+
         Milliseconds lag_time(0.0);
         TimeStamp    previous_time = Clock::now();
 
         while (m_window_is_open) {
+            if (m_pacer.wait_for_next_frame()) {
+                // Time spent asleep waiting for events isn't simulation time, so pick up with a single update.
+                previous_time = Clock::now() - std::chrono::duration_cast<Clock::duration>(m_update_interval_ms);
+            }
+
             TimeStamp    current_time = Clock::now();
             Milliseconds elapsed_time = current_time - previous_time;
             previous_time = current_time;
-            lag_time += elapsed_time;
-
-            int update_count = 0;
-            while (lag_time >= m_update_interval_ms && update_count < m_max_updates_per_frame) {
-                this->update();
-                lag_time -= m_update_interval_ms;
-                update_count++;
-            }
+            run_frame(elapsed_time, lag_time);
+            m_pacer.frame_presented();
+        }
+    }
 
-            this->render();
+    [[maybe_unused]] void Window::run_frames(int frame_count) {
+        // Feeding exactly one update interval per frame runs exactly one update
+        // per frame, so every frame has fresh state to draw and the results are
+        // the same on any machine.
+        Milliseconds lag_time(0.0);
+        for (int frame = 0; frame < frame_count && m_window_is_open; frame++) {
+            run_frame(m_update_interval_ms, lag_time);
         }
     }
 
     void Window::close() { m_window_is_open = false; }
 
+    [[maybe_unused]] std::vector<std::uint32_t> Window::read_framebuffer() const {
+        std::vector<std::uint32_t> pixels(static_cast<std::size_t>(m_window_width) * m_window_height);
+        const int                  pitch = m_window_width * static_cast<int>(sizeof(std::uint32_t));
+        if (SDL_RenderReadPixels(m_renderer.get(), nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(), pitch) != 0) {
+            pixels.clear();
+        }
+        return pixels;
+    }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Private API functions and helpers.
 ////////////////////////////////////////////////////////////////////////////////
 
+    void Window::run_frame(Milliseconds elapsed_time, Milliseconds& lag_time) {
+        FrameProfiler::Scope frame_timer(m_profiler, FrameProfiler::Phase::Frame);
+        begin_frame();
+        lag_time += elapsed_time;
+
+        int update_count = 0;
+        while (lag_time >= m_update_interval_ms && update_count < m_max_updates_per_frame) {
+            this->update();
+            lag_time -= m_update_interval_ms;
+            update_count++;
+        }
+
+        // Whatever lag is left past the limit is simulation time this frame couldn't catch up on. It isn't thrown
+        // away, so the profiler only counts how much the backlog grew.
+        int updates_behind = update_count < m_max_updates_per_frame
+                             ? 0 : static_cast<int>(lag_time / m_update_interval_ms);
+        m_profiler.record_updates(update_count, updates_behind);
+
+        // Lag left over after a frame that hit the update limit can exceed a whole interval. The drawn state
+        // never runs ahead of the latest update, so alpha stops at one.
+        double alpha = std::clamp(lag_time / m_update_interval_ms, 0.0, 1.0);
+        this->render(alpha);
+        end_frame();
+    }
+
+    void Window::run_threaded() {
+        // The thread starts after the initial update, so the first frame drawn already has state to show.
+        std::thread simulation(&Window::run_simulation_thread, this);
+
+        while (m_window_is_open) {
+            m_pacer.wait_for_next_frame();
+            {
+                FrameProfiler::Scope frame_timer(m_profiler, FrameProfiler::Phase::Frame);
+                begin_frame();
+                pump_events();
+
+                auto   since_update = FramePacer::Clock::now().time_since_epoch() -
+                                      std::chrono::nanoseconds(m_last_update_ns.load(std::memory_order_acquire));
+                double alpha        = std::clamp(Milliseconds(since_update) / m_update_interval_ms, 0.0, 1.0);
+                this->render(alpha);
+                end_frame();
+            }
+            m_pacer.frame_presented();
+        }
+
+        simulation.join();
+    }
+
+    void Window::run_simulation_thread() {
+        using Clock = FramePacer::Clock;
+
+        Milliseconds      lag_time(0.0);
+        Clock::time_point previous_time = Clock::now();
+
+        while (m_window_is_open) {
+            Clock::time_point current_time = Clock::now();
+            lag_time += current_time - previous_time;
+            previous_time = current_time;
+
+            int update_count = 0;
+            while (lag_time >= m_update_interval_ms && update_count < m_max_updates_per_frame) {
+                simulate();
+                lag_time -= m_update_interval_ms;
+                update_count++;
+            }
+            // A capped pass loops straight back with the same lag still owed, so report the backlog, not a
+            // count of deferred updates, and let the profiler count only what's new.
+            int updates_behind = update_count < m_max_updates_per_frame
+                                 ? 0 : static_cast<int>(lag_time / m_update_interval_ms);
+            m_profiler.record_updates(update_count, updates_behind);
+
+            // Sleep until the next update is due. Updates don't need the precision frames do, so no spinning.
+            if (lag_time < m_update_interval_ms) {
+                std::this_thread::sleep_for(std::chrono::duration_cast<Clock::duration>(m_update_interval_ms - lag_time));
+            }
+        }
+    }
+
     void Window::update() {
         // Give users the first shot at consuming events.
-        if (m_process_user_updates) { m_process_user_updates(); }
+        simulate();
+        pump_events();
+    }
+
+    void Window::simulate() {
+        run_posted_tasks();
+        m_last_update_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                FramePacer::Clock::now().time_since_epoch()).count(), std::memory_order_release);
+
+        if (m_process_user_updates) {
+            FrameProfiler::Scope update_timer(m_profiler, FrameProfiler::Phase::Update);
+            m_process_user_updates();
+        }
+    }
 
+    void Window::pump_events() {
         // Processing SDL2's event queue *MUST* be done somewhere or the
-        // window freezes, even if the events are just thrown away. SDL event
-        // filters don't count, and users might not create their own event
-        // processing loop.
-        SDL_Event current_event;
-        while (SDL_PollEvent(&current_event)) {}
+        // window freezes, even if nobody is listening for the events. SDL
+        // event filters don't count, and users might not create their own
+        // event processing loop. It also has to happen on the main thread.
+        FrameProfiler::Scope events_timer(m_profiler, FrameProfiler::Phase::Events);
+        if (m_events.dispatch_pending() > 0) { m_pacer.mark_dirty(); }
     }
 
-    void Window::render() {
-        SDL_SetRenderDrawColor(m_renderer.get(),
-                               DEFAULT_CLEAR_COLOR.r,
-                               DEFAULT_CLEAR_COLOR.g,
-                               DEFAULT_CLEAR_COLOR.b,
-                               DEFAULT_CLEAR_COLOR.a);
-        SDL_RenderClear(m_renderer.get());
+    void Window::run_posted_tasks() {
+        {
+            std::lock_guard<std::mutex> lock(m_posted_tasks_mutex);
+            if (m_posted_tasks.empty()) { return; }
+            m_running_tasks.swap(m_posted_tasks);
+        }
+        for (SimulationTask& task : m_running_tasks) { task(); }
+        m_running_tasks.clear();
+    }
 
-        if (m_process_user_rendering) { m_process_user_rendering(m_renderer.get()); }
+    void Window::render(double alpha) {
+        {
+            FrameProfiler::Scope draw_timer(m_profiler, FrameProfiler::Phase::Draw);
+            SDL_SetRenderDrawColor(m_renderer.get(),
+                                   DEFAULT_CLEAR_COLOR.r,
+                                   DEFAULT_CLEAR_COLOR.g,
+                                   DEFAULT_CLEAR_COLOR.b,
+                                   DEFAULT_CLEAR_COLOR.a);
+            SDL_RenderClear(m_renderer.get());
+            if (m_rasterizer) { m_rasterizer->clear(SOFTWARE_CLEAR_COLOR); }
+            Core::TextureManager::access().upload_pending(m_renderer.get());
+
+            m_interpolation_alpha = alpha;
+            if (m_process_user_rendering) { m_process_user_rendering(m_renderer.get(), alpha); }
+            else if (m_process_user_drawing) { m_process_user_drawing(m_renderer.get()); }
+            // The backbuffer's contents are undefined after a present, so the screen is still cleared and
+            // composed every frame. Containers in retained mode make that a single copy of their cached pixels.
+            m_last_frame_pixels_redrawn = 0;
+            for (auto& [widgets, handler] : m_attached_widgets) {
+                widgets->render(*m_batch);
+                m_last_frame_pixels_redrawn += widgets->pixels_redrawn();
+            }
+            if (m_rasterizer) {
+                // Drawn in tiles on the job system, then handed to SDL as one texture.
+                m_batch->flush(*m_rasterizer);
+                m_rasterizer->present();
+            } else {
+                m_batch->flush();
+            }
+        }
 
+        FrameProfiler::Scope present_timer(m_profiler, FrameProfiler::Phase::Present);
         SDL_RenderPresent(m_renderer.get());
     }
 
+    void Window::begin_frame() {
+        m_frame_arena.reset();
+        m_frame_start_allocations = Core::AllocationCounter::thread_allocations();
+    }
+
+    void Window::end_frame() {
+        m_last_frame_allocations = Core::AllocationCounter::thread_allocations() - m_frame_start_allocations;
+    }
+
 // TODO: Change the unique_ptr<Renderer> to a shared_ptr, and create an accessor function that
 //  returns a weak_ptr reference. This will make it very easy to create buttons that have access
 //  to the renderer for the main_window since user code generally only has access to the renderer
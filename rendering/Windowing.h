@@ -9,32 +9,79 @@
 #ifndef GOLD_CARTRIDGE_WINDOWING_H
 #define GOLD_CARTRIDGE_WINDOWING_H
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "../core/EventDispatcher.h"
+#include "../core/FrameArena.h"
+#include "../core/InplaceFunction.h"
+#include "BatchRenderer.h"
+#include "FramePacer.h"
+#include "FrameProfiler.h"
 
 struct SDL_Window;
 struct SDL_Renderer;
+struct SDL_Surface;
+
+namespace UI { class Container; }
 
 namespace Rendering {
 
+    class SoftwareRasterizer;
+
     class Window {
     public:
-        using UpdateCallback = std::function<void()>;
-        using DrawCallback = std::function<void(SDL_Renderer* renderer)>;
+        /// Callbacks run every frame, so they are stored in place and never allocate. See Core::InplaceFunction.
+        using UpdateCallback = Core::InplaceFunction<void()>;
+        using SimulationTask = std::function<void()>;
+        using DrawCallback = Core::InplaceFunction<void(SDL_Renderer* renderer)>;
+        using InterpolatedDrawCallback = Core::InplaceFunction<void(SDL_Renderer* renderer, double alpha)>;
         using Milliseconds = std::chrono::duration<double, std::milli>;
         using SDL_WindowPtr = std::unique_ptr<SDL_Window, void (*)(SDL_Window*)>;
         using SDL_RendererPtr = std::unique_ptr<SDL_Renderer, void (*)(SDL_Renderer*)>;
+        using SDL_SurfacePtr = std::unique_ptr<SDL_Surface, void (*)(SDL_Surface*)>;
+
+        enum class Backend {
+            Onscreen, ///< A visible window with a hardware accelerated renderer.
+            Headless, ///< No window. SDL's software renderer draws into an offscreen surface.
+
+            /**
+             * A visible window, for machines without a GPU, whose batch is drawn
+             * by a SoftwareRasterizer across the job system instead of by SDL's
+             * single-threaded software renderer. Widgets and anything else
+             * submitted to batch() are drawn that way, and SDL only presents the
+             * finished frame, over whatever the draw callback drew through SDL.
+             * Batched items the rasterizer can't draw, such as scaled sprites,
+             * are drawn by SDL underneath it. See
+             * BatchRenderer::flush(SoftwareRasterizer&) for what it can draw.
+             */
+            Software
+        };
 
     public:
         Window();
         Window(int window_width, int window_height, std::string window_title);
+        Window(int window_width, int window_height, std::string window_title, Backend backend);
         ~Window();
 
         void set_user_update_callback(UpdateCallback update_fn);
         void set_user_draw_callback(DrawCallback draw_fn);
 
+        /**
+         * Sets a draw callback that is also told how far the simulation has got towards its next update.
+         * @param draw_fn Called once per frame with alpha in [0, 1]: the time since the last update as a fraction
+         *                of the update interval. Blending the previous and current update's state by alpha lets
+         *                the simulation update less often than the screen refreshes and still look smooth.
+         */
+        void set_user_draw_callback(InterpolatedDrawCallback draw_fn);
+
         int update_limit_per_frame() const;
         void update_limit_per_frame(int new_update_limit);
         double target_update_time_ms() const;
@@ -43,25 +90,153 @@ namespace Rendering {
         int width() const;
         int height() const;
 
+        SDL_Renderer* renderer() const;
+
+        /// The batch that widgets submit to. It is drawn after the user draw callback returns.
+        BatchRenderer& batch();
+
+        /// The rasterizer a Software window draws its batch with, or null for other backends.
+        SoftwareRasterizer* rasterizer();
+
+        FrameProfiler& profiler();
+        FramePacer& pacer();
+
+        /**
+         * Scratch memory for the current frame, emptied at the start of every frame. Only use it on the main
+         * thread: in the update callback without a threaded simulation, and in the draw callback and event
+         * handlers either way.
+         */
+        Core::FrameArena& frame_arena();
+
+        /**
+         * Heap allocations the main thread made during the last complete frame. Always zero unless built with
+         * GOLD_CARTRIDGE_COUNT_ALLOCATIONS.
+         */
+        std::uint64_t last_frame_allocations() const;
+
+        /**
+         * Widget pixels the attached containers drew during the last frame. Containers in retained mode only
+         * count what they redrew, so a static UI reports zero.
+         */
+        std::uint64_t last_frame_pixels_redrawn() const;
+
+        FramePacer::Mode pacing_mode() const;
+
+        /**
+         * Chooses how run() paces frames. Windows start in VSync, headless windows in Unlimited.
+         * @param mode The pacing mode. VSync falls back to Capped at the display's refresh rate if the renderer
+         *             can't sync to it.
+         */
+        void pacing_mode(FramePacer::Mode mode);
+
+        /// Asks for a frame to be drawn even though no events arrived. Only needed in EventDriven pacing.
+        void request_redraw();
+
+        /// Receives every event the window takes off SDL's queue, once per update, after the user update callback.
+        Core::EventDispatcher& events();
+
+        /**
+         * Sends the window's events to a set of widgets and draws them every frame, after the user draw callback.
+         * @param widgets The widgets to show. They must stay alive until detached or the window closes.
+         */
+        void attach(UI::Container& widgets);
+        void detach(UI::Container& widgets);
+
+        bool is_headless() const;
+
+        /// The alpha passed to the draw callback for the frame being drawn, or last drawn.
+        double interpolation_alpha() const;
+
+        bool threaded_simulation() const;
+
+        /**
+         * Chooses whether run() calls the update callback on its own thread. Set it before calling run().
+         *
+         * In threaded mode the update callback runs at the fixed update rate on
+         * a simulation thread, while the main thread keeps handling events and
+         * drawing, as SDL requires. Slow updates then no longer hold up drawing,
+         * and slow drawing no longer holds up updates. The update callback must
+         * not touch the renderer, and state it shares with the draw callback
+         * should go through a Core::TripleBuffer. Event handlers still run on
+         * the main thread. Use post_to_simulation() to hand input to the
+         * simulation. The draw callback's alpha is measured from the start of
+         * the latest update.
+         *
+         * @param is_threaded True to run updates on their own thread.
+         */
+        void threaded_simulation(bool is_threaded);
+
+        /**
+         * Queues work to run on the simulation just before its next update. Safe to call from any thread.
+         * Without a threaded simulation the work runs just before the next update on the main thread.
+         */
+        void post_to_simulation(SimulationTask task);
+
         void run();
+
+        /**
+         * Runs a fixed number of frames as fast as possible, advancing the simulation by exactly one update
+         * interval per frame so that results don't depend on how fast the machine is.
+         * @param frame_count The number of frames to run.
+         */
+        void run_frames(int frame_count);
         void close();
 
+        /**
+         * Copies the last drawn frame out of the renderer.
+         * @return width() * height() pixels in ARGB8888 order, row by row, or nothing if reading failed.
+         */
+        std::vector<std::uint32_t> read_framebuffer() const;
+
     private:
+        void run_frame(Milliseconds elapsed_time, Milliseconds& lag_time);
+        void run_threaded();
+        void run_simulation_thread();
         void update();
-        void render();
+        void simulate();
+        void pump_events();
+        void run_posted_tasks();
+        void render(double alpha);
+
+        /// Empties the frame arena and starts counting the new frame's allocations.
+        void begin_frame();
+        void end_frame();
 
     private:
-        SDL_RendererPtr m_renderer;
-        SDL_WindowPtr   m_window;
-        int             m_window_width;
-        int             m_window_height;
-        std::string     m_window_title;
-        bool            m_window_is_open;
+        SDL_SurfacePtr                      m_framebuffer; ///< Only for headless windows. Must outlive the renderer.
+        SDL_RendererPtr                     m_renderer;
+        SDL_WindowPtr                       m_window;
+        std::unique_ptr<BatchRenderer>      m_batch;
+        std::unique_ptr<SoftwareRasterizer> m_rasterizer; ///< Only used by software windows.
+        Core::EventDispatcher               m_events;
+        int                                 m_window_width;
+        int                                 m_window_height;
+        std::string                         m_window_title;
+        Backend                             m_backend;
+        std::atomic<bool>                   m_window_is_open;
 
         int            m_max_updates_per_frame;
         Milliseconds   m_update_interval_ms;
         UpdateCallback m_process_user_updates;
-        DrawCallback   m_process_user_rendering;
+        FrameProfiler  m_profiler;
+        FramePacer     m_pacer;
+
+        DrawCallback             m_process_user_drawing;
+        InterpolatedDrawCallback m_process_user_rendering; ///< Only one of the two draw callbacks is ever set.
+        double                   m_interpolation_alpha;
+
+        bool                        m_threaded_simulation;
+        std::atomic<std::int64_t>   m_last_update_ns; ///< When the latest update started, on FramePacer's clock.
+        std::mutex                  m_posted_tasks_mutex;
+        std::vector<SimulationTask> m_posted_tasks;
+        std::vector<SimulationTask> m_running_tasks;
+
+        std::vector<std::pair<UI::Container*, Core::EventDispatcher::HandlerId>> m_attached_widgets;
+
+        Core::FrameArena m_frame_arena;
+        std::uint64_t    m_frame_start_allocations;
+        std::uint64_t    m_last_frame_allocations;
+        std::uint64_t    m_last_frame_pixels_redrawn;
     };
 
 } // Rendering namespace
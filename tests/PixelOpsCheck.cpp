@@ -0,0 +1,273 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Checks that every PixelOps row kernel gives exactly what Core::ScalarPixels
+ * gives one pixel at a time. Rows of every length up to a few lane widths, and
+ * some longer odd ones, start at every offset within a lane, so both the lane
+ * loop and the scalar tail after it are covered with each lane type the build
+ * uses. Run by CTest. Prints each mismatch and exits with 1 if there were any.
+ */
+
+#include "../core/PixelOps.h"
+#include "../core/SimdLanes.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <SDL_pixels.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translation Unit Variables
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    using Lanes = Core::PixelLanes;
+    using Scalar = Core::ScalarPixels;
+
+    const std::uint32_t TINT  = 0xC0FFA080;
+    const std::uint32_t COLOR = 0x80336699;
+
+    /// Reported mismatches per kernel, so one broken kernel doesn't bury the rest.
+    const int MAX_REPORTS = 8;
+
+    int MISMATCHES = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+/// Row lengths that end at, just before and just after every lane boundary, plus a few long odd ones.
+static std::vector<std::size_t> ROW_LENGTHS() {
+    std::vector<std::size_t> lengths;
+    for (std::size_t length = 0; length <= 4 * Lanes::WIDTH + 1; length++) { lengths.push_back(length); }
+    for (std::size_t length : {63, 65, 127, 255, 257, 1021}) { lengths.push_back(length); }
+    return lengths;
+}
+
+/// A mix of opaque, transparent and partly transparent runs, some shorter than a lane, as sprites and glyphs have.
+static std::vector<std::uint32_t> MAKE_PIXELS(std::size_t count, std::uint32_t seed) {
+    std::vector<std::uint32_t> pixels(count);
+    std::uint32_t              state = seed;
+    for (std::size_t i = 0; i < count; i++) {
+        state = state * 1664525 + 1013904223;
+        std::uint32_t run   = static_cast<std::uint32_t>(i / 3 + seed) % 4;
+        std::uint32_t alpha = run == 0 ? 255 : run == 1 ? 0 : state >> 24;
+        pixels[i] = alpha << 24 | (state & 0x00FFFFFF);
+    }
+    return pixels;
+}
+
+static std::vector<std::uint8_t> MAKE_COVERAGE(std::size_t count, std::uint32_t seed) {
+    std::vector<std::uint8_t> coverage(count);
+    std::uint32_t             state = seed;
+    for (std::size_t i = 0; i < count; i++) {
+        state = state * 1664525 + 1013904223;
+        std::uint32_t run = static_cast<std::uint32_t>(i / 3 + seed) % 4;
+        coverage[i] = static_cast<std::uint8_t>(run == 0 ? 255 : run == 1 ? 0 : state >> 24);
+    }
+    return coverage;
+}
+
+/// Compares a kernel's row with the expected one, printing where they differ.
+static void EXPECT_ROW(const char* kernel, std::size_t offset, const std::uint32_t* expected,
+                       const std::uint32_t* actual, std::size_t count) {
+    static const char* last_kernel = nullptr;
+    static int         reports     = 0;
+    if (kernel != last_kernel) {
+        last_kernel = kernel;
+        reports     = 0;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        if (expected[i] == actual[i]) { continue; }
+        MISMATCHES++;
+        if (reports++ < MAX_REPORTS) {
+            std::printf("%s: length %zu, offset %zu, pixel %zu: expected %08X, got %08X\n", kernel, count, offset, i,
+                        static_cast<unsigned>(expected[i]), static_cast<unsigned>(actual[i]));
+        }
+    }
+}
+
+/// One pixel of an alpha-over, as the scalar tail does it: transparent pixels are skipped, opaque ones copied.
+static std::uint32_t SCALAR_OVER(std::uint32_t dst, Scalar src) {
+    if (Scalar::transparent_mask(src) == Scalar::ALL_LANES) { return dst; }
+    if (Scalar::opaque_mask(src) == Scalar::ALL_LANES) { return src.value; }
+    return Scalar::blend({dst}, src).value;
+}
+
+/// Moves a 32 bit pixel's channels to ARGB8888 one byte at a time, independently of the kernels' shifts.
+static std::uint32_t BYTEWISE_TO_ARGB(std::uint32_t pixel, std::uint32_t format) {
+    auto byte = [pixel](int index) { return (pixel >> (index * 8)) & 0xFF; };
+    std::uint32_t a = 0, r = 0, g = 0, b = 0;
+    switch (format) {
+        case SDL_PIXELFORMAT_ARGB8888: a = byte(3), r = byte(2), g = byte(1), b = byte(0); break;
+        case SDL_PIXELFORMAT_ABGR8888: a = byte(3), b = byte(2), g = byte(1), r = byte(0); break;
+        case SDL_PIXELFORMAT_RGBA8888: r = byte(3), g = byte(2), b = byte(1), a = byte(0); break;
+        case SDL_PIXELFORMAT_BGRA8888: b = byte(3), g = byte(2), r = byte(1), a = byte(0); break;
+        case SDL_PIXELFORMAT_RGB888: a = 255, r = byte(2), g = byte(1), b = byte(0); break;
+        case SDL_PIXELFORMAT_BGR888: a = 255, b = byte(2), g = byte(1), r = byte(0); break;
+        default: break;
+    }
+    return a << 24 | r << 16 | g << 8 | b;
+}
+
+static double SRGB_TO_LINEAR(double value) {
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+static double LINEAR_TO_SRGB(double value) {
+    return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Checks
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Runs a kernel on a copy of the pixels at each offset within a lane, and the scalar reference on another copy.
+ * @param kernel Called as kernel(row, count). It changes the row in place.
+ * @param reference Called as reference(pixel_index, pixel) and returns what the pixel should become.
+ */
+template <typename Kernel, typename Reference>
+static void CHECK_IN_PLACE(const char* name, const Kernel& kernel, const Reference& reference) {
+    for (std::size_t length : ROW_LENGTHS()) {
+        for (std::size_t offset = 0; offset < static_cast<std::size_t>(Lanes::WIDTH); offset++) {
+            std::vector<std::uint32_t> actual   = MAKE_PIXELS(offset + length, static_cast<std::uint32_t>(length));
+            std::vector<std::uint32_t> expected = actual;
+            kernel(actual.data() + offset, length);
+            for (std::size_t i = 0; i < length; i++) { expected[offset + i] = reference(i, expected[offset + i]); }
+            EXPECT_ROW(name, offset, expected.data() + offset, actual.data() + offset, length);
+        }
+    }
+}
+
+static void CHECK_INTEGER_KERNELS() {
+    const std::vector<std::uint32_t> sources = MAKE_PIXELS(4096, 777);
+
+    CHECK_IN_PLACE("fill", [](std::uint32_t* row, std::size_t count) { Core::PixelOps::fill(row, count, COLOR); },
+                   [](std::size_t, std::uint32_t) { return COLOR; });
+
+    CHECK_IN_PLACE("premultiply", [](std::uint32_t* row, std::size_t count) {
+        Core::PixelOps::premultiply(row, count);
+    }, [](std::size_t, std::uint32_t pixel) { return Scalar::premultiply({pixel}).value; });
+
+    CHECK_IN_PLACE("unpremultiply", [](std::uint32_t* row, std::size_t count) {
+        Core::PixelOps::unpremultiply(row, count);
+    }, [](std::size_t, std::uint32_t pixel) { return Scalar::unpremultiply({pixel}).value; });
+
+    CHECK_IN_PLACE("modulate", [](std::uint32_t* row, std::size_t count) {
+        Core::PixelOps::modulate(row, count, TINT);
+    }, [](std::size_t, std::uint32_t pixel) { return Scalar::multiply({pixel}, Scalar::splat(TINT)).value; });
+
+    CHECK_IN_PLACE("alpha_over", [&](std::uint32_t* row, std::size_t count) {
+        Core::PixelOps::alpha_over(row, sources.data(), count);
+    }, [&](std::size_t i, std::uint32_t dst) { return SCALAR_OVER(dst, Scalar::load(&sources[i])); });
+
+    CHECK_IN_PLACE("alpha_over tinted", [&](std::uint32_t* row, std::size_t count) {
+        Core::PixelOps::alpha_over(row, sources.data(), count, TINT);
+    }, [&](std::size_t i, std::uint32_t dst) {
+        // The tinted blit never copies opaque pixels straight through, since the tint may make them translucent.
+        Scalar src = Scalar::multiply(Scalar::load(&sources[i]), Scalar::splat(TINT));
+        return Scalar::transparent_mask(src) == Scalar::ALL_LANES ? dst : Scalar::blend({dst}, src).value;
+    });
+
+    CHECK_IN_PLACE("alpha_over_color", [](std::uint32_t* row, std::size_t count) {
+        Core::PixelOps::alpha_over_color(row, count, COLOR);
+    }, [](std::size_t, std::uint32_t dst) { return Scalar::blend({dst}, Scalar::splat(COLOR)).value; });
+
+    const std::vector<std::uint8_t> coverage = MAKE_COVERAGE(4096, 31);
+    CHECK_IN_PLACE("alpha_over_coverage", [&](std::uint32_t* row, std::size_t count) {
+        Core::PixelOps::alpha_over_coverage(row, coverage.data(), count, COLOR);
+    }, [&](std::size_t i, std::uint32_t dst) { return SCALAR_OVER(dst, Scalar::from_coverage(&coverage[i], COLOR)); });
+}
+
+static void CHECK_SWIZZLES() {
+    const std::uint32_t formats[] = {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888,
+                                     SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888};
+    for (std::uint32_t format : formats) {
+        const char* name = SDL_GetPixelFormatName(format);
+        for (std::size_t length : ROW_LENGTHS()) {
+            for (std::size_t offset = 0; offset < static_cast<std::size_t>(Lanes::WIDTH); offset++) {
+                std::vector<std::uint32_t> src = MAKE_PIXELS(offset + length, static_cast<std::uint32_t>(length));
+                std::vector<std::uint32_t> expected(length), copied(length);
+                for (std::size_t i = 0; i < length; i++) { expected[i] = BYTEWISE_TO_ARGB(src[offset + i], format); }
+
+                // Once into a separate row, then in place, which the loaders rely on.
+                if (!Core::PixelOps::to_argb8888(src.data() + offset, copied.data(), length, format)) {
+                    std::printf("to_argb8888: %s was refused\n", name);
+                    MISMATCHES++;
+                    break;
+                }
+                EXPECT_ROW(name, offset, expected.data(), copied.data(), length);
+                Core::PixelOps::to_argb8888(src.data() + offset, src.data() + offset, length, format);
+                EXPECT_ROW(name, offset, expected.data(), src.data() + offset, length);
+            }
+        }
+    }
+}
+
+static void CHECK_SRGB() {
+    // Every byte to linear light, against the curve evaluated in double.
+    std::vector<std::uint32_t> bytes(256);
+    for (std::uint32_t i = 0; i < 256; i++) { bytes[i] = i << 24 | i << 16 | i << 8 | i; }
+    std::vector<float> linear(bytes.size() * 4);
+    Core::PixelOps::srgb_to_linear(bytes.data(), linear.data(), bytes.size());
+    for (std::uint32_t i = 0; i < 256; i++) {
+        const float expected = static_cast<float>(SRGB_TO_LINEAR(i / 255.0));
+        if (linear[i * 4] != expected || linear[i * 4 + 1] != expected || linear[i * 4 + 2] != expected) {
+            std::printf("srgb_to_linear: byte %u: expected %.9g, got %.9g\n", static_cast<unsigned>(i), expected,
+                        linear[i * 4]);
+            MISMATCHES++;
+        }
+    }
+
+    // And back again, which must give every byte exactly.
+    std::vector<std::uint32_t> round_trip(bytes.size());
+    Core::PixelOps::linear_to_srgb(linear.data(), round_trip.data(), bytes.size());
+    EXPECT_ROW("sRGB round trip", 0, bytes.data(), round_trip.data(), bytes.size());
+
+    // Linear values between the bytes, out of range ones included, go to the nearest sRGB byte. Values too close
+    // to halfway for float to settle are skipped.
+    const std::size_t          samples = 100003;
+    std::vector<float>         between(samples * 4);
+    std::vector<std::uint32_t> expected(samples), actual(samples);
+    for (std::size_t i = 0; i < samples; i++) {
+        const double value  = -0.05 + 1.1 * static_cast<double>(i) / (samples - 1);
+        const double encoded = LINEAR_TO_SRGB(std::fmin(std::fmax(value, 0.0), 1.0)) * 255.0;
+        const double fraction = encoded - std::floor(encoded);
+        const auto   channel = static_cast<std::uint32_t>(encoded + 0.5);
+        between[i * 4] = between[i * 4 + 1] = between[i * 4 + 2] = static_cast<float>(value);
+        between[i * 4 + 3] = 1.0f;
+        expected[i] = std::fabs(fraction - 0.5) < 1e-4 ? 0 : 0xFF000000 | channel << 16 | channel << 8 | channel;
+    }
+    Core::PixelOps::linear_to_srgb(between.data(), actual.data(), samples);
+    for (std::size_t i = 0; i < samples; i++) {
+        if (expected[i] == 0) { actual[i] = 0; }
+    }
+    EXPECT_ROW("linear_to_srgb", 0, expected.data(), actual.data(), samples);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Entry Point
+////////////////////////////////////////////////////////////////////////////////
+
+int main() {
+    CHECK_INTEGER_KERNELS();
+    CHECK_SWIZZLES();
+    CHECK_SRGB();
+
+    if (MISMATCHES > 0) {
+        std::printf("%d pixel(s) differ from ScalarPixels.\n", MISMATCHES);
+        return 1;
+    }
+    std::printf("PixelOps matches ScalarPixels with %d-pixel lanes.\n", Lanes::WIDTH);
+    return 0;
+}
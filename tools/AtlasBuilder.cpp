@@ -0,0 +1,149 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Packs image files into sprite atlas pages ahead of time, so games can load
+ * them with Core::SpriteAtlas::load() instead of packing at startup.
+ *
+ *     gold_cartridge_atlas [--page-size=N] [--padding=N] <output dir> <atlas name> <images or directories>...
+ *
+ * Directories are searched recursively for PNG files. Each sprite is named
+ * after its path as given on the command line, which matches the name
+ * SpriteAtlas::add_file() would give it.
+ */
+
+#include "../core/SpriteAtlas.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+#include <SDL_image.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    struct Image {
+        std::string  name;
+        SDL_Surface* pixels;
+    };
+}
+
+static void PRINT_USAGE(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--page-size=N] [--padding=N] <output dir> <atlas name> <images or directories>..." << std::endl;
+}
+
+/// Adds the image files named on the command line, looking inside directories for PNG files.
+static void COLLECT_PATHS(const std::string& argument, std::vector<std::string>& paths) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(argument, error)) {
+        paths.push_back(argument);
+        return;
+    }
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(argument, error)) {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (entry.is_regular_file(error) && extension == ".png") { paths.push_back(entry.path().generic_string()); }
+    }
+}
+
+/**
+ * Reads the whole number after an option's '='.
+ * @return False if the value is missing, has trailing characters, is out of range, or is below the minimum.
+ */
+static bool PARSE_OPTION_VALUE(const std::string& option, int minimum, int& value) {
+    const char* first  = option.data() + option.find('=') + 1;
+    const char* last   = option.data() + option.size();
+    int         parsed = 0;
+    auto [end, error] = std::from_chars(first, last, parsed);
+    if (first == last || error != std::errc() || end != last || parsed < minimum) { return false; }
+    value = parsed;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Entry Point
+////////////////////////////////////////////////////////////////////////////////
+
+int main(int num_args, char** args) {
+    int                      page_size = 2048;
+    int                      padding   = 1;
+    std::vector<std::string> positional;
+    for (int i = 1; i < num_args; i++) {
+        std::string option = args[i];
+        bool        valid  = true;
+        if (option.rfind("--page-size=", 0) == 0) { valid = PARSE_OPTION_VALUE(option, 1, page_size); }
+        else if (option.rfind("--padding=", 0) == 0) { valid = PARSE_OPTION_VALUE(option, 0, padding); }
+        else if (option.rfind("--", 0) == 0) {
+            std::cerr << "Unknown option: " << option << std::endl;
+            PRINT_USAGE(args[0]);
+            return 1;
+        }
+        else { positional.push_back(option); }
+
+        if (!valid) {
+            std::cerr << "Invalid value: " << option
+                      << " (the page size must be a positive whole number, the padding zero or more)" << std::endl;
+            PRINT_USAGE(args[0]);
+            return 1;
+        }
+    }
+    if (positional.size() < 3) {
+        PRINT_USAGE(args[0]);
+        return 1;
+    }
+
+    std::vector<std::string> paths;
+    for (std::size_t i = 2; i < positional.size(); i++) { COLLECT_PATHS(positional[i], paths); }
+
+    IMG_Init(IMG_INIT_PNG);
+    std::vector<Image> images;
+    for (const std::string& path : paths) {
+        SDL_Surface* pixels = IMG_Load(path.c_str());
+        if (!pixels) {
+            std::cerr << "Skipping \"" << path << "\": " << SDL_GetError() << std::endl;
+            continue;
+        }
+        images.push_back({path, pixels});
+    }
+
+    // Knowing every image up front, packing tallest first leaves far fewer gaps than packing as they come.
+    std::sort(images.begin(), images.end(), [](const Image& a, const Image& b) {
+        return a.pixels->h != b.pixels->h ? a.pixels->h > b.pixels->h : a.pixels->w > b.pixels->w;
+    });
+
+    Core::SpriteAtlas atlas(nullptr, page_size, padding);
+    int               failures = 0;
+    for (Image& image : images) {
+        if (!atlas.add(image.name, image.pixels)) { failures++; }
+        SDL_FreeSurface(image.pixels);
+    }
+
+    bool saved = atlas.save(positional[0], positional[1]);
+    if (saved) {
+        Core::SpriteAtlas::Stats stats = atlas.stats();
+        std::cout << "Packed " << stats.sprites << " sprites into " << stats.pages << " page(s) of "
+                  << page_size << "x" << page_size << ", " << static_cast<int>(stats.occupancy * 100.0)
+                  << "% full." << std::endl;
+    } else {
+        std::cerr << "Could not write the atlas to \"" << positional[0] << "\"." << std::endl;
+    }
+
+    IMG_Quit();
+    SDL_Quit();
+    return (saved && failures == 0) ? 0 : 1;
+}
@@ -8,12 +8,14 @@
 
 #include "Button.h"
 #include "../core/FontManager.h"
+#include "../rendering/BatchRenderer.h"
 
 #include <SDL_ttf.h>
 #include <SDL_render.h>
 
 #include <utility>
 #include <iostream>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Values
@@ -22,14 +24,12 @@
 namespace {
     const SDL_Color DEFAULT_BUTTON_BASE_COLOR{224, 224, 224, 255};
     const SDL_Color DEFAULT_BUTTON_HIGHLIGHT_COLOR{255, 255, 255, 255};
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// General Helper Functions
-////////////////////////////////////////////////////////////////////////////////
+    const int       BACKGROUND_LAYER = 0;
+    const int       LABEL_LAYER      = 1;
 
-static int SET_RENDER_DRAW_COLOR(SDL_Renderer* renderer, const SDL_Color& draw_color) {
-    return SDL_SetRenderDrawColor(renderer, draw_color.r, draw_color.g, draw_color.b, draw_color.a);
+    // Reused between labels so laying them out doesn't allocate once they've grown large enough.
+    std::vector<SDL_Vertex> LABEL_VERTICES;
+    std::vector<int>        LABEL_INDICES;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -47,7 +47,7 @@ UI::Button::Button(int x_pixel_pos,
                    SDL_Color label_font_color,
                    SDL_Color highlight_color,
                    SDL_Color button_color
-) : m_button_area{x_pixel_pos, y_pixel_pos, pixel_width, pixel_height},
+) : Widget({x_pixel_pos, y_pixel_pos, pixel_width, pixel_height}),
     m_button_label(std::move(text_label)),
     m_button_action(std::move(click_action)),
     m_label_font(std::move(label_font)),
@@ -56,7 +56,9 @@ UI::Button::Button(int x_pixel_pos,
     m_button_highlight_color(highlight_color),
     m_button_color(button_color),
     m_button_is_depressed(false),
-    m_button_is_highlighted(false) {}
+    m_button_is_highlighted(false),
+    m_label_rendering(LabelRendering::GlyphAtlas),
+    m_label_renderer(nullptr) {}
 
 UI::Button::Button(int x_pixel_pos,
                    int y_pixel_pos,
@@ -83,17 +85,21 @@ UI::Button::Button(int x_pixel_pos,
 void UI::Button::handle_event(SDL_Event& event) {
     switch (event.type) {
         case SDL_MOUSEMOTION: {
-            m_button_is_highlighted = button_contains_point(event.motion.x, event.motion.y);
+            bool is_highlighted = contains_point(event.motion.x, event.motion.y);
+            if (is_highlighted != m_button_is_highlighted) {
+                m_button_is_highlighted = is_highlighted;
+                mark_dirty();
+            }
             break;
         }
         case SDL_MOUSEBUTTONDOWN: {
-            if (button_contains_point(event.button.x, event.button.y)) {
+            if (contains_point(event.button.x, event.button.y)) {
                 m_button_is_depressed = true;
             }
             break;
         }
         case SDL_MOUSEBUTTONUP: {
-            if (m_button_is_depressed && button_contains_point(event.button.x, event.button.y)) {
+            if (m_button_is_depressed && contains_point(event.button.x, event.button.y)) {
                 m_button_action(*this);
             }
             m_button_is_depressed = false;
@@ -102,50 +108,73 @@ void UI::Button::handle_event(SDL_Event& event) {
     }
 }
 
-void UI::Button::render(SDL_Renderer* renderer) {
+void UI::Button::render(Rendering::BatchRenderer& batch) {
     // Fill the button area with color.
-    const SDL_Color& fill_color = m_button_is_highlighted ? m_button_highlight_color : m_button_color;
-    SET_RENDER_DRAW_COLOR(renderer, fill_color);
-    SDL_RenderFillRect(renderer, &m_button_area);
+    const SDL_Rect&  button_area = area();
+    const SDL_Color& fill_color  = m_button_is_highlighted ? m_button_highlight_color : m_button_color;
+    batch.fill_rect(button_area, fill_color, BACKGROUND_LAYER);
+
+    if (m_button_label.empty()) { return; }
 
-    // Render the text as an image.
     using Fonts = Core::FontManager;
-    Fonts::TexturePtr text_render = Fonts::access().render_text(renderer, m_button_label, m_label_font, m_label_font_color);
+    if (m_label_rendering == LabelRendering::GlyphAtlas) {
+        // Center the label within the button, cutting off whatever doesn't fit.
+        SDL_Point label_size = Fonts::access().text_size(batch.renderer(), m_button_label, m_label_font);
+        int       label_x    = button_area.x + (button_area.w / 2) - (label_size.x / 2);
+        int       label_y    = button_area.y + (button_area.h / 2) - (label_size.y / 2);
+
+        // Queue the label's glyphs from the font's atlas. Every label in the font shares its texture.
+        LABEL_VERTICES.clear();
+        LABEL_INDICES.clear();
+        Fonts::SharedTexturePtr atlas_texture = Fonts::access().layout_text(
+                batch.renderer(), m_button_label, m_label_font, m_label_font_color, label_x, label_y,
+                &button_area, LABEL_VERTICES, LABEL_INDICES);
+        if (!atlas_texture) { return; }
+        batch.geometry(atlas_texture, LABEL_VERTICES.data(), static_cast<int>(LABEL_VERTICES.size()),
+                       LABEL_INDICES.data(), static_cast<int>(LABEL_INDICES.size()), LABEL_LAYER);
+        return;
+    }
+
+    // Render the text as an image, or reuse the one cached from an earlier frame.
+    m_label_renderer = batch.renderer();
+    Fonts::SharedTexturePtr text_render = Fonts::access().render_text(batch.renderer(), m_button_label, m_label_font, m_label_font_color);
+    if (!text_render) { return; }
 
     // Calculate the label's drawing area within the button.
     int texture_w{}, texture_h{};
     SDL_QueryTexture(text_render.get(), nullptr, nullptr, &texture_w, &texture_h);
     SDL_Rect label_dest_px = {
-            std::max(m_button_area.x, m_button_area.x + (m_button_area.w / 2) - (texture_w / 2)),
-            std::max(m_button_area.y, m_button_area.y + (m_button_area.h / 2) - (texture_h / 2)),
-            std::min(texture_w, m_button_area.w),
-            std::min(texture_h, m_button_area.h)
+            std::max(button_area.x, button_area.x + (button_area.w / 2) - (texture_w / 2)),
+            std::max(button_area.y, button_area.y + (button_area.h / 2) - (texture_h / 2)),
+            std::min(texture_w, button_area.w),
+            std::min(texture_h, button_area.h)
     };
 
     // Calculate which pixels of the texture to copy into the label drawing area on screen.
-    int      h_clip       = std::max(texture_w - m_button_area.w, 0);
-    int      v_clip       = std::max(texture_h - m_button_area.h, 0);
+    int      h_clip       = std::max(texture_w - button_area.w, 0);
+    int      v_clip       = std::max(texture_h - button_area.h, 0);
     SDL_Rect label_src_px = {h_clip / 2, v_clip / 2, texture_w - h_clip, texture_h - v_clip};
 
     // Render the button label to the screen.
-    SDL_RenderCopy(renderer, text_render.get(), &label_src_px, &label_dest_px);
-    SDL_DestroyTexture(text_render.get());
+    batch.copy(text_render, label_src_px, label_dest_px, LABEL_LAYER);
 }
 
-
 void UI::Button::set_label(std::string new_label) {
+    if (new_label == m_button_label) { return; }
+
+    // Drop the old label's cached texture, looked up by its exact key rather than by walking the cache.
+    if (m_label_renderer) {
+        Core::FontManager::access().invalidate_text(m_label_renderer, m_button_label, m_label_font,
+                                                    m_label_font_color);
+    }
     m_button_label = std::move(new_label);
+    mark_dirty();
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// Private API Functions
-////////////////////////////////////////////////////////////////////////////////
+UI::Button::LabelRendering UI::Button::label_rendering() const { return m_label_rendering; }
 
-bool UI::Button::button_contains_point(int x, int y) const {
-    return x >= m_button_area.x &&
-           x <= m_button_area.x + m_button_area.w &&
-           y >= m_button_area.y &&
-           y <= m_button_area.y + m_button_area.h;
+void UI::Button::label_rendering(LabelRendering rendering) {
+    if (rendering == m_label_rendering) { return; }
+    m_label_rendering = rendering;
+    mark_dirty();
 }
-
-
@@ -14,19 +14,26 @@
 #include <SDL_rect.h>
 #include <SDL_render.h>
 #include <SDL_ttf.h>
-#include <functional>
 #include <memory>
 #include <string>
 
+#include "Widget.h"
+#include "../core/InplaceFunction.h"
 
 namespace UI {
 
 /**
  * @brief Represents a button that can be displayed on the screen.
  */
-    class Button {
+    class Button : public Widget {
     public:
-        typedef std::function<void(Button& this_button)> Action;
+        typedef Core::InplaceFunction<void(Button& this_button)> Action;
+
+        /// Where the label's pixels come from.
+        enum class LabelRendering {
+            GlyphAtlas,   ///< Quads from the font's glyph atlas, batched with every other label in the font.
+            CachedTexture ///< One whole-string texture from FontManager's text cache, a single quad per frame.
+        };
 
     public:
         /**
@@ -63,23 +70,30 @@ namespace UI {
                Action click_action
         );
 
-        void handle_event(SDL_Event& event);
+        void handle_event(SDL_Event& event) override;
 
-        void render(SDL_Renderer* renderer);
+        /**
+         * Queues the button's background and label for drawing.
+         * @param batch The batch to submit to. The label is drawn one layer above the background.
+         */
+        void render(Rendering::BatchRenderer& batch) override;
 
+        /**
+         * Changes the label. If the old label was drawn as a cached texture, that one entry is dropped from the
+         * text cache. A button still showing the same text renders it again on its next frame.
+         */
         void set_label(std::string new_label);
 
-    private: // Functions
+        LabelRendering label_rendering() const;
+
         /**
-         * Checks whether a pixel coordinate is within the button's area.
-         * @param x The x-coordinate of the point, in pixels.
-         * @param y The y-coordinate of the point, in pixels.
-         * @return True if the point is within the button's area, false otherwise.
+         * Chooses how the label is drawn. Buttons start with the glyph atlas.
+         * @param rendering CachedTexture suits long labels that never change. The glyph atlas suits everything
+         *                  else, and keeps the labels of many buttons to one draw call.
          */
-        bool button_contains_point(int x, int y) const;
+        void label_rendering(LabelRendering rendering);
 
     private: // Data fields
-        SDL_Rect  m_button_area;
         SDL_Color m_button_color;
         SDL_Color m_button_highlight_color;
 
@@ -91,6 +105,8 @@ namespace UI {
         std::shared_ptr<TTF_Font> m_label_font;
         SDL_Color                 m_label_font_color;
         int                       m_label_font_size_pt;
+        LabelRendering            m_label_rendering;
+        SDL_Renderer*             m_label_renderer; ///< Where the label's cached texture was last drawn.
     };
 
 } // UI namespace
@@ -0,0 +1,359 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Container.h"
+#include "../core/TexturePixels.h"
+#include "../rendering/BatchRenderer.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <SDL_render.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// General Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+/// Divides, rounding towards negative infinity, so that cells left of and above the origin line up.
+static int FLOOR_DIVIDE(int value, int divisor) {
+    int quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+static std::uint64_t CELL_KEY(int column, int row) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(column)) << 32) |
+           static_cast<std::uint32_t>(row);
+}
+
+static bool CONTAINS(const std::vector<UI::Widget*>& widgets, const UI::Widget* widget) {
+    return std::find(widgets.begin(), widgets.end(), widget) != widgets.end();
+}
+
+static void ERASE(std::vector<UI::Widget*>& widgets, const UI::Widget* widget) {
+    widgets.erase(std::remove(widgets.begin(), widgets.end(), widget), widgets.end());
+}
+
+static std::uint64_t AREA_OF(const SDL_Rect& area) {
+    return static_cast<std::uint64_t>(std::max(area.w, 0)) * static_cast<std::uint64_t>(std::max(area.h, 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+UI::Container::Container(int cell_size)
+        : m_cell_size(cell_size),
+          m_is_dispatching(false),
+          m_is_retained(false),
+          m_layer(nullptr, SDL_DestroyTexture),
+          m_layer_renderer(nullptr),
+          m_layer_width(0),
+          m_layer_height(0),
+          m_everything_damaged(false),
+          m_pixels_redrawn(0) {
+    assert(m_cell_size > 0);
+}
+
+UI::Container::~Container() {
+    for (std::unique_ptr<Widget>& widget : m_widgets) { widget->m_container = nullptr; }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void UI::Container::remove(Widget& widget) {
+    auto found = std::find_if(m_widgets.begin(), m_widgets.end(),
+                              [&](const std::unique_ptr<Widget>& owned) { return owned.get() == &widget; });
+    if (found == m_widgets.end()) { return; }
+
+    unindex(&widget, cells_covering(widget.area()));
+    damage(widget.area());
+    ERASE(m_hovered, &widget);
+    ERASE(m_pressed, &widget);
+    std::replace(m_targets.begin(), m_targets.end(), &widget, static_cast<Widget*>(nullptr));
+
+    // A widget removing itself from its own event handler is still running, so it is kept alive
+    // until the dispatch that called it has finished.
+    std::unique_ptr<Widget> removed = std::move(*found);
+    removed->m_container = nullptr;
+    m_widgets.erase(found);
+    if (m_is_dispatching) { m_removed_while_dispatching.push_back(std::move(removed)); }
+}
+
+void UI::Container::clear() {
+    for (std::unique_ptr<Widget>& widget : m_widgets) {
+        widget->m_container = nullptr;
+        if (m_is_dispatching) { m_removed_while_dispatching.push_back(std::move(widget)); }
+    }
+    m_widgets.clear();
+    m_cells.clear();
+    m_hovered.clear();
+    m_pressed.clear();
+    std::fill(m_targets.begin(), m_targets.end(), nullptr);
+    damage_all();
+}
+
+void UI::Container::handle_event(SDL_Event& event) {
+    switch (event.type) {
+        case SDL_MOUSEMOTION: {
+            // The widgets the cursor just left are sent the motion too, so they can un-highlight.
+            widgets_at(event.motion.x, event.motion.y, m_targets);
+            auto under_cursor = static_cast<std::ptrdiff_t>(m_targets.size());
+            for (Widget* widget : m_hovered) {
+                if (!CONTAINS(m_targets, widget)) { m_targets.push_back(widget); }
+            }
+            m_hovered.assign(m_targets.begin(), m_targets.begin() + under_cursor);
+            break;
+        }
+        case SDL_MOUSEBUTTONDOWN: {
+            widgets_at(event.button.x, event.button.y, m_targets);
+            for (Widget* widget : m_targets) {
+                if (!CONTAINS(m_pressed, widget)) { m_pressed.push_back(widget); }
+            }
+            break;
+        }
+        case SDL_MOUSEBUTTONUP: {
+            // Widgets a press started on are told it ended, even if the cursor has wandered off them.
+            widgets_at(event.button.x, event.button.y, m_targets);
+            for (Widget* widget : m_pressed) {
+                if (!CONTAINS(m_targets, widget)) { m_targets.push_back(widget); }
+            }
+            m_pressed.clear();
+            break;
+        }
+        case SDL_MOUSEWHEEL: {
+            m_targets = m_hovered;
+            break;
+        }
+        default: {
+            m_targets.clear();
+            for (std::unique_ptr<Widget>& widget : m_widgets) { m_targets.push_back(widget.get()); }
+            break;
+        }
+    }
+    dispatch(event);
+}
+
+void UI::Container::render(Rendering::BatchRenderer& batch) {
+    m_pixels_redrawn = 0;
+    // Where textures are drawn in software, the cached layer would be left to SDL, under everything else, while
+    // redrawing the widgets spreads them across the job system.
+    if (m_is_retained && !Core::TexturePixels::access().is_kept_for(batch.renderer()) &&
+        prepare_layer(batch.renderer())) {
+        render_retained(batch);
+        return;
+    }
+    for (std::unique_ptr<Widget>& widget : m_widgets) {
+        widget->render(batch);
+        m_pixels_redrawn += AREA_OF(widget->area());
+    }
+}
+
+bool UI::Container::retained_mode() const { return m_is_retained; }
+
+void UI::Container::retained_mode(bool is_retained) {
+    if (is_retained == m_is_retained) { return; }
+    m_is_retained = is_retained;
+    if (m_is_retained) { damage_all(); }
+    else { release_layer(); }
+}
+
+void UI::Container::damage(const SDL_Rect& area) {
+    if (!m_is_retained || m_everything_damaged || area.w <= 0 || area.h <= 0) { return; }
+
+    // Overlapping rectangles are merged, so no pixel is redrawn twice in one frame.
+    SDL_Rect merged = area;
+    for (std::size_t i = 0; i < m_damage.size();) {
+        if (SDL_HasIntersection(&merged, &m_damage[i])) {
+            SDL_UnionRect(&merged, &m_damage[i], &merged);
+            m_damage[i] = m_damage.back();
+            m_damage.pop_back();
+            i = 0; // The grown rectangle may now overlap ones already checked.
+        } else {
+            i++;
+        }
+    }
+    m_damage.push_back(merged);
+
+    if (m_damage.size() > MAX_DAMAGE_RECTS) {
+        for (const SDL_Rect& damaged : m_damage) { SDL_UnionRect(&merged, &damaged, &merged); }
+        m_damage.assign(1, merged);
+    }
+}
+
+void UI::Container::damage_all() {
+    if (!m_is_retained) { return; }
+    m_everything_damaged = true;
+    m_damage.clear();
+}
+
+std::uint64_t UI::Container::pixels_redrawn() const { return m_pixels_redrawn; }
+
+void UI::Container::release_layer() {
+    m_layer.reset();
+    m_layer_renderer = nullptr;
+    m_layer_width    = 0;
+    m_layer_height   = 0;
+    damage_all();
+}
+
+void UI::Container::widgets_at(int x, int y, std::vector<Widget*>& found) const {
+    found.clear();
+    auto cell = m_cells.find(CELL_KEY(FLOOR_DIVIDE(x, m_cell_size), FLOOR_DIVIDE(y, m_cell_size)));
+    if (cell == m_cells.end()) { return; }
+
+    for (Widget* widget : cell->second) {
+        if (widget->contains_point(x, y)) { found.push_back(widget); }
+    }
+}
+
+std::size_t UI::Container::size() const { return m_widgets.size(); }
+
+int UI::Container::cell_size() const { return m_cell_size; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Private API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void UI::Container::render_retained(Rendering::BatchRenderer& batch) {
+    SDL_Renderer*  renderer = batch.renderer();
+    const SDL_Rect bounds   = {0, 0, m_layer_width, m_layer_height};
+    if (m_everything_damaged) {
+        m_damage.assign(1, bounds);
+        m_everything_damaged = false;
+    }
+
+    if (!m_damage.empty()) {
+        // Whatever is already queued belongs on the current target, underneath the widgets.
+        batch.flush();
+
+        SDL_Texture*  previous_target = SDL_GetRenderTarget(renderer);
+        SDL_BlendMode previous_blend_mode;
+        Uint8         previous_r, previous_g, previous_b, previous_a;
+        SDL_GetRenderDrawBlendMode(renderer, &previous_blend_mode);
+        SDL_GetRenderDrawColor(renderer, &previous_r, &previous_g, &previous_b, &previous_a);
+
+        SDL_SetRenderTarget(renderer, m_layer.get());
+        for (const SDL_Rect& damaged : m_damage) {
+            SDL_Rect redraw;
+            if (!SDL_IntersectRect(&damaged, &bounds, &redraw)) { continue; }
+
+            // Wipe the area back to transparent, then draw every widget that touches it, clipped to it.
+            SDL_RenderSetClipRect(renderer, &redraw);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            SDL_RenderFillRect(renderer, &redraw);
+            SDL_SetRenderDrawBlendMode(renderer, previous_blend_mode);
+            for (std::unique_ptr<Widget>& widget : m_widgets) {
+                if (SDL_HasIntersection(&widget->area(), &redraw)) { widget->render(batch); }
+            }
+            batch.flush();
+            m_pixels_redrawn += AREA_OF(redraw);
+        }
+        SDL_RenderSetClipRect(renderer, nullptr);
+        SDL_SetRenderTarget(renderer, previous_target);
+        SDL_SetRenderDrawColor(renderer, previous_r, previous_g, previous_b, previous_a);
+        m_damage.clear();
+    }
+
+    batch.copy(m_layer.get(), bounds, bounds);
+}
+
+bool UI::Container::prepare_layer(SDL_Renderer* renderer) {
+    int width  = 0;
+    int height = 0;
+    if (SDL_GetRendererOutputSize(renderer, &width, &height) != 0 || width <= 0 || height <= 0) { return false; }
+    if (m_layer && m_layer_renderer == renderer && m_layer_width == width && m_layer_height == height) { return true; }
+
+    m_layer.reset(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height));
+    if (!m_layer) {
+        // The renderer can't draw to textures. Fall back to drawing every widget every frame.
+        m_layer_renderer = nullptr;
+        return false;
+    }
+    SDL_SetTextureBlendMode(m_layer.get(), SDL_BLENDMODE_BLEND);
+    m_layer_renderer = renderer;
+    m_layer_width    = width;
+    m_layer_height   = height;
+    damage_all();
+    return true;
+}
+
+void UI::Container::adopt(std::unique_ptr<Widget> widget) {
+    assert(!widget->m_container);
+    widget->m_container = this;
+    index(widget.get(), cells_covering(widget->area()));
+    damage(widget->area());
+    m_widgets.push_back(std::move(widget));
+}
+
+void UI::Container::widget_moved(Widget& widget, const SDL_Rect& old_area) {
+    CellRange old_cells = cells_covering(old_area);
+    CellRange new_cells = cells_covering(widget.area());
+    if (old_cells == new_cells) { return; }
+
+    // Only touch the cells the widget left or entered. Cells in the overlap keep their entry.
+    auto in_range = [](const CellRange& cells, int column, int row) {
+        return column >= cells.first_column && column <= cells.last_column &&
+               row >= cells.first_row && row <= cells.last_row;
+    };
+    for (int row = old_cells.first_row; row <= old_cells.last_row; row++) {
+        for (int column = old_cells.first_column; column <= old_cells.last_column; column++) {
+            if (!in_range(new_cells, column, row)) { unindex(&widget, {column, row, column, row}); }
+        }
+    }
+    for (int row = new_cells.first_row; row <= new_cells.last_row; row++) {
+        for (int column = new_cells.first_column; column <= new_cells.last_column; column++) {
+            if (!in_range(old_cells, column, row)) { index(&widget, {column, row, column, row}); }
+        }
+    }
+}
+
+UI::Container::CellRange UI::Container::cells_covering(const SDL_Rect& area) const {
+    // Widgets include their right and bottom edges, so a widget ending exactly on a cell boundary
+    // is listed in the next cell as well.
+    return {FLOOR_DIVIDE(area.x, m_cell_size),
+            FLOOR_DIVIDE(area.y, m_cell_size),
+            FLOOR_DIVIDE(area.x + std::max(area.w, 0), m_cell_size),
+            FLOOR_DIVIDE(area.y + std::max(area.h, 0), m_cell_size)};
+}
+
+void UI::Container::index(Widget* widget, const CellRange& cells) {
+    for (int row = cells.first_row; row <= cells.last_row; row++) {
+        for (int column = cells.first_column; column <= cells.last_column; column++) {
+            m_cells[CELL_KEY(column, row)].push_back(widget);
+        }
+    }
+}
+
+void UI::Container::unindex(Widget* widget, const CellRange& cells) {
+    for (int row = cells.first_row; row <= cells.last_row; row++) {
+        for (int column = cells.first_column; column <= cells.last_column; column++) {
+            auto cell = m_cells.find(CELL_KEY(column, row));
+            if (cell == m_cells.end()) { continue; }
+
+            std::vector<Widget*>& listed = cell->second;
+            auto entry = std::find(listed.begin(), listed.end(), widget);
+            if (entry != listed.end()) {
+                *entry = listed.back();
+                listed.pop_back();
+            }
+            if (listed.empty()) { m_cells.erase(cell); }
+        }
+    }
+}
+
+void UI::Container::dispatch(SDL_Event& event) {
+    m_is_dispatching = true;
+    for (std::size_t i = 0; i < m_targets.size(); i++) {
+        if (m_targets[i]) { m_targets[i]->handle_event(event); }
+    }
+    m_is_dispatching = false;
+    m_removed_while_dispatching.clear();
+}
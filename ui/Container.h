@@ -0,0 +1,170 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_CONTAINER_H
+#define GOLD_CARTRIDGE_CONTAINER_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SDL_events.h>
+#include <SDL_rect.h>
+
+#include "Widget.h"
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace UI {
+
+/**
+ * @brief Owns a set of widgets and hands each mouse event only to the widgets under the cursor.
+ *
+ * Widget areas are indexed by a uniform grid of square cells. Each widget is
+ * listed in every cell its area touches, so finding the widgets under a
+ * point means checking the handful listed in one cell rather than all of
+ * them. When a widget moves or resizes, only the cells it entered or left
+ * are updated. Events without a position, such as key presses, still go to
+ * every widget.
+ *
+ * In retained mode the widgets are drawn into a texture that is kept between
+ * frames, and only the areas widgets have marked dirty are redrawn.
+ */
+    class Container {
+    public:
+        /**
+         * @param cell_size The width and height of each grid cell, in pixels. Works best at around the
+         *                  size of a typical widget.
+         */
+        explicit Container(int cell_size = 64);
+        ~Container();
+
+        Container(const Container&) = delete;
+        void operator=(const Container&) = delete;
+
+        /**
+         * Constructs a widget inside the container.
+         * @return The new widget. It stays valid until it is removed or the container is destroyed.
+         */
+        template <typename WidgetType, typename... Args>
+        WidgetType& add(Args&&... args) {
+            auto widget = std::make_unique<WidgetType>(std::forward<Args>(args)...);
+            WidgetType& added = *widget;
+            adopt(std::move(widget));
+            return added;
+        }
+
+        /// Destroys a widget. Safe to call from inside the widget's own event handler.
+        void remove(Widget& widget);
+        void clear();
+
+        void handle_event(SDL_Event& event);
+
+        /**
+         * Draws every widget, in the order they were added. In retained mode only the damaged areas are redrawn,
+         * and the cached texture is then queued as a single copy on layer 0.
+         */
+        void render(Rendering::BatchRenderer& batch);
+
+        bool retained_mode() const;
+
+        /**
+         * Chooses whether the widgets' pixels are kept between frames. Off by default.
+         *
+         * In retained mode the container keeps a render target texture the size
+         * of the renderer's output. Each frame it redraws only the rectangles
+         * that were damaged since the last frame, clipped to those rectangles,
+         * and every other pixel comes from the texture. A mostly static UI then
+         * costs one texture copy per frame. Widgets must call mark_dirty() when
+         * their appearance changes, or the change won't show. Retained mode is
+         * ignored when a Rendering::SoftwareRasterizer presents to the renderer.
+         *
+         * @param is_retained True to cache the widgets' pixels.
+         */
+        void retained_mode(bool is_retained);
+
+        /// Marks an area for redrawing in retained mode. Widgets do this through mark_dirty().
+        void damage(const SDL_Rect& area);
+
+        /// Marks everything for redrawing in retained mode.
+        void damage_all();
+
+        /// The widget pixels drawn by the last render(): the damaged area in retained mode, every widget otherwise.
+        std::uint64_t pixels_redrawn() const;
+
+        /// Frees the cached texture. It has to go before the renderer it was made with is destroyed.
+        void release_layer();
+
+        /**
+         * Finds the widgets whose areas contain a point.
+         * @param x The x-coordinate of the point, in pixels.
+         * @param y The y-coordinate of the point, in pixels.
+         * @param found Receives the widgets. It is cleared first.
+         */
+        void widgets_at(int x, int y, std::vector<Widget*>& found) const;
+
+        std::size_t size() const;
+        int cell_size() const;
+
+    private:
+        friend class Widget;
+
+        struct CellRange {
+            int first_column, first_row, last_column, last_row;
+
+            bool operator==(const CellRange& other) const = default;
+        };
+
+        using SDL_TexturePtr = std::unique_ptr<SDL_Texture, void (*)(SDL_Texture*)>;
+
+        /// More damaged rectangles than this are merged into one that covers them all.
+        static constexpr std::size_t MAX_DAMAGE_RECTS = 16;
+
+        void render_retained(Rendering::BatchRenderer& batch);
+
+        /// Makes sure the cached texture exists and matches the renderer's output size.
+        bool prepare_layer(SDL_Renderer* renderer);
+
+        void adopt(std::unique_ptr<Widget> widget);
+        void widget_moved(Widget& widget, const SDL_Rect& old_area);
+
+        CellRange cells_covering(const SDL_Rect& area) const;
+        void index(Widget* widget, const CellRange& cells);
+        void unindex(Widget* widget, const CellRange& cells);
+
+        /// Sends an event to each widget in m_targets that is still alive.
+        void dispatch(SDL_Event& event);
+
+    private:
+        int                                                     m_cell_size;
+        std::vector<std::unique_ptr<Widget>>                    m_widgets;
+        std::unordered_map<std::uint64_t, std::vector<Widget*>> m_cells;
+
+        std::vector<Widget*> m_hovered; ///< Widgets that were under the cursor at the last mouse motion.
+        std::vector<Widget*> m_pressed; ///< Widgets a mouse button went down on, until it comes back up.
+        std::vector<Widget*> m_targets; ///< Widgets the event being dispatched goes to.
+
+        bool                                 m_is_dispatching;
+        std::vector<std::unique_ptr<Widget>> m_removed_while_dispatching;
+
+        bool                  m_is_retained;
+        SDL_TexturePtr        m_layer;
+        SDL_Renderer*         m_layer_renderer;
+        int                   m_layer_width;
+        int                   m_layer_height;
+        std::vector<SDL_Rect> m_damage; ///< Damaged areas that don't overlap each other.
+        bool                  m_everything_damaged;
+        std::uint64_t         m_pixels_redrawn;
+    };
+
+} // UI namespace
+
+#endif //GOLD_CARTRIDGE_CONTAINER_H
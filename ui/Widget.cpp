@@ -0,0 +1,54 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Widget.h"
+#include "Container.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructors and Destructors
+////////////////////////////////////////////////////////////////////////////////
+
+UI::Widget::Widget(const SDL_Rect& area) : m_area(area), m_container(nullptr) {}
+
+UI::Widget::Widget(const Widget& other) : m_area(other.m_area), m_container(nullptr) {}
+
+UI::Widget& UI::Widget::operator=(const Widget& other) {
+    set_area(other.m_area);
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Public API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+const SDL_Rect& UI::Widget::area() const { return m_area; }
+
+void UI::Widget::set_area(const SDL_Rect& new_area) {
+    SDL_Rect old_area = m_area;
+    m_area = new_area;
+    if (m_container) {
+        m_container->widget_moved(*this, old_area);
+        m_container->damage(old_area);
+        m_container->damage(m_area);
+    }
+}
+
+bool UI::Widget::contains_point(int x, int y) const {
+    return x >= m_area.x &&
+           x <= m_area.x + m_area.w &&
+           y >= m_area.y &&
+           y <= m_area.y + m_area.h;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Protected API Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void UI::Widget::mark_dirty() {
+    if (m_container) { m_container->damage(m_area); }
+}
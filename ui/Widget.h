@@ -0,0 +1,72 @@
+/**
+ * @author David Vitez (AKA: Robotic Forest)
+ * @copyright All rights reserved © 2024 David Vitez
+ * @license This Source Code Form is subject to the terms of the Mozilla Public
+ *          License, v. 2.0. If a copy of the MPL was not distributed with this
+ *          file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GOLD_CARTRIDGE_WIDGET_H
+#define GOLD_CARTRIDGE_WIDGET_H
+
+#include <SDL_events.h>
+#include <SDL_rect.h>
+
+namespace Rendering { class BatchRenderer; }
+
+namespace UI {
+
+    class Container;
+
+/**
+ * @brief Something that occupies a rectangle of the screen, draws itself, and reacts to events.
+ *
+ * A widget placed in a Container is only sent the mouse events that happen
+ * over it, plus the one that moves the cursor off of it and the button
+ * release that ends a press that started on it.
+ *
+ * Widgets must call mark_dirty() whenever their appearance changes, so that a
+ * container in retained mode knows to redraw them.
+ */
+    class Widget {
+    public:
+        explicit Widget(const SDL_Rect& area);
+        virtual ~Widget() = default;
+
+        /// Copies only the area. The copy does not belong to any container.
+        Widget(const Widget& other);
+        Widget& operator=(const Widget& other);
+
+        virtual void handle_event(SDL_Event& event) = 0;
+        virtual void render(Rendering::BatchRenderer& batch) = 0;
+
+        const SDL_Rect& area() const;
+
+        /**
+         * Moves or resizes the widget, keeping its container's index up to date.
+         * @param new_area The widget's new position and size, in pixels.
+         */
+        void set_area(const SDL_Rect& new_area);
+
+        /**
+         * Checks whether a pixel coordinate is within the widget's area, including its right and bottom edges.
+         * @param x The x-coordinate of the point, in pixels.
+         * @param y The y-coordinate of the point, in pixels.
+         * @return True if the point is within the widget's area, false otherwise.
+         */
+        bool contains_point(int x, int y) const;
+
+    protected:
+        /// Tells the widget's container that its area needs redrawing.
+        void mark_dirty();
+
+    private:
+        friend class Container;
+
+        SDL_Rect   m_area;
+        Container* m_container;
+    };
+
+} // UI namespace
+
+#endif //GOLD_CARTRIDGE_WIDGET_H